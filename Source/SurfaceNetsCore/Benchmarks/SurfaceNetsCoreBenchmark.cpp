@@ -0,0 +1,430 @@
+#include "SurfaceNetsCore/ChunkLayout.h"
+#include "SurfaceNetsCore/ClusterBuilder.h"
+#include "SurfaceNetsCore/CompletionQueue.h"
+#include "SurfaceNetsCore/DensityCodec.h"
+#include "SurfaceNetsCore/DensityField.h"
+#include "SurfaceNetsCore/FractalNoise.h"
+#include "SurfaceNetsCore/MarchingCubesMesher.h"
+#include "SurfaceNetsCore/Occupancy.h"
+#include "SurfaceNetsCore/SdfQueries.h"
+#include "SurfaceNetsCore/SlabAllocator.h"
+#include "SurfaceNetsCore/SurfaceNetsMesher.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace SurfaceNetsCore;
+
+namespace
+{
+    /** Default planet settings, matching the UNoiseGenerator constructor */
+    FNoiseSettings MakePlanetSettings()
+    {
+        return FNoiseSettings();
+    }
+
+    /** A chunk straddling the planet surface on the +X axis */
+    FChunkLayout MakeSurfaceChunk()
+    {
+        return FChunkLayout::ForChunk(FVec3(1000.0, 64.0, 64.0), 128.0f);
+    }
+
+    std::vector<float> MakeSurfaceDensity()
+    {
+        const FNoiseSettings Settings = MakePlanetSettings();
+        const FChunkLayout Layout = MakeSurfaceChunk();
+
+        std::vector<float> Density(Layout.NumSamples());
+        FillDensityGrid(Layout, [&Settings](const FVec3& P) { return FFractalNoise::SampleDensity(Settings, P); }, Density.data());
+        return Density;
+    }
+
+    FDensityGridView MakeGridView(const FChunkLayout& Layout, const std::vector<float>& Density)
+    {
+        FDensityGridView Grid;
+        Grid.Data = Density.data();
+        Grid.GridSize = Layout.GridSize;
+        Grid.VoxelSize = Layout.VoxelSize;
+        Grid.Origin = Layout.PaddedOrigin;
+        return Grid;
+    }
+}
+
+static void BM_SampleDensity(benchmark::State& State)
+{
+    FNoiseSettings Settings = MakePlanetSettings();
+    Settings.bFastNoise = State.range(0) != 0;
+    const FNoiseSampler Sampler(Settings);
+    FVec3 Position(1000.0, 10.0, 20.0);
+
+    for (auto _ : State)
+    {
+        benchmark::DoNotOptimize(Sampler(Position));
+        Position.Y += 0.5;
+    }
+    State.SetItemsProcessed(State.iterations());
+}
+BENCHMARK(BM_SampleDensity)
+    ->ArgName("Fast")->Arg(0)->Arg(1);
+
+static void BM_FillDensityGrid(benchmark::State& State)
+{
+    FNoiseSettings Settings = MakePlanetSettings();
+    Settings.bFastNoise = State.range(0) != 0;
+    const FNoiseSampler Sampler(Settings);
+    const FChunkLayout Layout = MakeSurfaceChunk();
+    std::vector<float> Density(Layout.NumSamples());
+
+    for (auto _ : State)
+    {
+        benchmark::DoNotOptimize(FillNoiseDensityGrid(Layout, Sampler, Density.data()));
+    }
+    State.SetItemsProcessed(State.iterations() * static_cast<int64_t>(Layout.NumSamples()));
+    State.counters["MaxError"] = Settings.bFastNoise ? FFastFractalNoise::MeasureError(Settings) : 0.0;
+}
+BENCHMARK(BM_FillDensityGrid)
+    ->ArgName("Fast")->Arg(0)->Arg(1);
+
+static void BM_FillTerrainDensityGrid(benchmark::State& State)
+{
+    FNoiseSettings Settings = MakePlanetSettings();
+    Settings.FractalType = static_cast<ENoiseFractalType>(State.range(0));
+    Settings.WarpStrength = State.range(1) != 0 ? 40.0f : 0.0f;
+    Settings.WarpScale = 0.002f;
+    Settings.bFastNoise = true;
+    const bool bBatched = State.range(2) != 0;
+    const FNoiseSampler Sampler(Settings);
+    const FChunkLayout Layout = MakeSurfaceChunk();
+    std::vector<float> Density(Layout.NumSamples());
+
+    for (auto _ : State)
+    {
+        benchmark::DoNotOptimize(bBatched ? FillNoiseDensityGrid(Layout, Sampler, Density.data()) : FillDensityGrid(Layout, Sampler, Density.data()));
+    }
+    State.SetItemsProcessed(State.iterations() * static_cast<int64_t>(Layout.NumSamples()));
+}
+BENCHMARK(BM_FillTerrainDensityGrid)
+    ->ArgNames({ "Type", "Warp", "Batched" })
+    ->ArgsProduct({ { static_cast<int64_t>(ENoiseFractalType::Fbm), static_cast<int64_t>(ENoiseFractalType::Billow), static_cast<int64_t>(ENoiseFractalType::Ridged) }, { 0, 1 }, { 0, 1 } });
+
+static void BM_FillCoarseOctaveGrid(benchmark::State& State)
+{
+    FNoiseSettings Settings = MakePlanetSettings();
+    Settings.Octaves = static_cast<int32_t>(State.range(0));
+    Settings.CoarseOctaveError = State.range(2) != 0 ? 0.05f : 0.0f;
+    Settings.bFastNoise = true;
+    const FNoiseSampler Sampler(Settings);
+    const float ChunkSize = static_cast<float>(State.range(1));
+    const FChunkLayout Layout = FChunkLayout::ForChunk(FVec3(1000.0, ChunkSize * 0.5, ChunkSize * 0.5), ChunkSize);
+    std::vector<float> Density(Layout.NumSamples());
+
+    int64_t CoarseOctaves = 0;
+    for (int32_t Octave = 0; Octave < Settings.Octaves; Octave++)
+    {
+        CoarseOctaves += Sampler.Fast.GetOctaveStride(Octave, Layout.VoxelSize) > 1 ? 1 : 0;
+    }
+
+    for (auto _ : State)
+    {
+        benchmark::DoNotOptimize(FillNoiseDensityGrid(Layout, Sampler, Density.data()));
+    }
+    State.SetItemsProcessed(State.iterations() * static_cast<int64_t>(Layout.NumSamples()));
+    State.counters["CoarseOctaves"] = static_cast<double>(CoarseOctaves);
+}
+BENCHMARK(BM_FillCoarseOctaveGrid)
+    ->ArgNames({ "Octaves", "ChunkSize", "Coarse" })
+    ->ArgsProduct({ { 3, 8 }, { 32, 128 }, { 0, 1 } });
+
+static void BM_FillHeightfieldGrid(benchmark::State& State)
+{
+    FNoiseSettings Settings = MakePlanetSettings();
+    Settings.Octaves = static_cast<int32_t>(State.range(0));
+    Settings.WarpStrength = State.range(1) != 0 ? 40.0f : 0.0f;
+    Settings.bHeightfield = State.range(2) != 0;
+    Settings.bFastNoise = true;
+    const FNoiseSampler Sampler(Settings);
+    // Off the face axes, so the chunk's columns run diagonally through its grid
+    const FChunkLayout Layout = FChunkLayout::ForChunk(FVec3(600.0, 700.0, 300.0), 128.0f);
+    std::vector<float> Density(Layout.NumSamples());
+
+    for (auto _ : State)
+    {
+        benchmark::DoNotOptimize(FillNoiseDensityGrid(Layout, Sampler, Density.data()));
+    }
+    State.SetItemsProcessed(State.iterations() * static_cast<int64_t>(Layout.NumSamples()));
+}
+BENCHMARK(BM_FillHeightfieldGrid)
+    ->ArgNames({ "Octaves", "Warp", "Heightfield" })
+    ->ArgsProduct({ { 3, 8 }, { 0, 1 }, { 0, 1 } });
+
+static void BM_QuantizeDensityGrid(benchmark::State& State)
+{
+    const FChunkLayout Layout = MakeSurfaceChunk();
+    const std::vector<float> Density = MakeSurfaceDensity();
+    std::vector<float> Decoded(Layout.NumSamples());
+    FQuantizedDensityGrid Quantized;
+
+    for (auto _ : State)
+    {
+        Quantized.Encode(Density.data(), Density.size(), Layout.VoxelSize * 8.0f);
+        Quantized.Decode(Decoded.data(), Decoded.size());
+        benchmark::DoNotOptimize(Decoded.data());
+    }
+    State.SetItemsProcessed(State.iterations() * static_cast<int64_t>(Layout.NumSamples()));
+    State.counters["Bytes"] = static_cast<double>(Quantized.GetAllocatedSize());
+}
+BENCHMARK(BM_QuantizeDensityGrid);
+
+static void BM_SurfaceNetsChunk(benchmark::State& State)
+{
+    const FChunkLayout Layout = MakeSurfaceChunk();
+    const std::vector<float> Density = MakeSurfaceDensity();
+    const FDensityGridView Grid = MakeGridView(Layout, Density);
+
+    FSurfaceNetsSettings Settings;
+    Settings.VertexPlacement = static_cast<EVertexPlacement>(State.range(0));
+    Settings.bManifold = State.range(1) != 0;
+
+    FSurfaceNetsScratch Scratch;
+    FMeshBuffers Mesh;
+
+    for (auto _ : State)
+    {
+        Mesh.Reset();
+        FSurfaceNetsMesher::GenerateMesh(Grid, FIntVec3(0), FIntVec3(FChunkLayout::UnpaddedSize + 1), Settings, Scratch, Mesh);
+        benchmark::DoNotOptimize(Mesh.Indices.data());
+    }
+    State.counters["Vertices"] = static_cast<double>(Mesh.Positions.size());
+    State.counters["Triangles"] = static_cast<double>(Mesh.Indices.size() / 3);
+}
+BENCHMARK(BM_SurfaceNetsChunk)
+    ->ArgNames({ "Placement", "Manifold" })
+    ->ArgsProduct({ { static_cast<int64_t>(EVertexPlacement::Centroid), static_cast<int64_t>(EVertexPlacement::Qef) }, { 0, 1 } });
+
+template <EMeshLayout MeshLayout>
+static void BM_SurfaceNetsChunkLayout(benchmark::State& State)
+{
+    const FChunkLayout Layout = MakeSurfaceChunk();
+    const std::vector<float> Density = MakeSurfaceDensity();
+    const FDensityGridView Grid = MakeGridView(Layout, Density);
+
+    FSurfaceNetsSettings Settings;
+    FSurfaceNetsScratch Scratch;
+    TMeshBuffers<MeshLayout> Mesh;
+
+    for (auto _ : State)
+    {
+        FSurfaceNetsMesher::GenerateMesh(Grid, FIntVec3(0), FIntVec3(FChunkLayout::UnpaddedSize + 1), Settings, Scratch, Mesh);
+        benchmark::DoNotOptimize(Mesh.Indices.data());
+    }
+    State.counters["Vertices"] = static_cast<double>(Mesh.NumVertices());
+}
+BENCHMARK_TEMPLATE(BM_SurfaceNetsChunkLayout, EMeshLayout::ArrayOfStructs);
+BENCHMARK_TEMPLATE(BM_SurfaceNetsChunkLayout, EMeshLayout::StructOfArrays);
+
+static void BM_ConvertMeshLayout(benchmark::State& State)
+{
+    const FChunkLayout Layout = MakeSurfaceChunk();
+    const std::vector<float> Density = MakeSurfaceDensity();
+    const FDensityGridView Grid = MakeGridView(Layout, Density);
+
+    FSurfaceNetsScratch Scratch;
+    FMeshBuffers Mesh;
+    FSurfaceNetsMesher::GenerateMesh(Grid, FIntVec3(0), FIntVec3(FChunkLayout::UnpaddedSize + 1), FSurfaceNetsSettings(), Scratch, Mesh);
+
+    FMeshBuffersSoA SoA;
+    FMeshBuffers AoS;
+    ConvertMeshLayout(Mesh, SoA);
+    for (auto _ : State)
+    {
+        if (State.range(0) == 0)
+        {
+            ConvertMeshLayout(Mesh, SoA);
+            benchmark::DoNotOptimize(SoA.NormalZ.data());
+        }
+        else
+        {
+            ConvertMeshLayout(SoA, AoS);
+            benchmark::DoNotOptimize(AoS.Normals.data());
+        }
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Mesh.NumVertices());
+}
+BENCHMARK(BM_ConvertMeshLayout)
+    ->ArgName("ToAoS")->Arg(0)->Arg(1);
+
+static void BM_MarchingCubesChunk(benchmark::State& State)
+{
+    const FChunkLayout Layout = MakeSurfaceChunk();
+    const std::vector<float> Density = MakeSurfaceDensity();
+    const FDensityGridView Grid = MakeGridView(Layout, Density);
+
+    FSurfaceNetsScratch Scratch;
+    FMeshBuffers Mesh;
+
+    for (auto _ : State)
+    {
+        Mesh.Reset();
+        FMarchingCubesMesher::GenerateMesh(Grid, FIntVec3(0), FIntVec3(FChunkLayout::UnpaddedSize + 1), Scratch, Mesh);
+        benchmark::DoNotOptimize(Mesh.Indices.data());
+    }
+    State.counters["Vertices"] = static_cast<double>(Mesh.Positions.size());
+    State.counters["Triangles"] = static_cast<double>(Mesh.Indices.size() / 3);
+}
+BENCHMARK(BM_MarchingCubesChunk);
+
+static void BM_BuildClusterHierarchy(benchmark::State& State)
+{
+    const FChunkLayout Layout = MakeSurfaceChunk();
+    const std::vector<float> Density = MakeSurfaceDensity();
+    const FDensityGridView Grid = MakeGridView(Layout, Density);
+
+    FSurfaceNetsScratch Scratch;
+    FMeshBuffers Mesh;
+    FSurfaceNetsMesher::GenerateMesh(Grid, FIntVec3(0), FIntVec3(FChunkLayout::UnpaddedSize + 1), FSurfaceNetsSettings(), Scratch, Mesh);
+
+    FClusterBuildSettings Settings;
+    Settings.BaseCellSize = Layout.VoxelSize;
+    FClusterHierarchy Hierarchy;
+
+    for (auto _ : State)
+    {
+        FClusterBuilder::Build(Mesh.Positions.data(), Mesh.Normals.data(), static_cast<int32_t>(Mesh.Positions.size()), Mesh.Indices.data(), Mesh.Indices.size(), Settings, Hierarchy);
+        benchmark::DoNotOptimize(Hierarchy.Clusters.data());
+    }
+    State.SetItemsProcessed(State.iterations() * static_cast<int64_t>(Mesh.Indices.size() / 3));
+    State.counters["Clusters"] = static_cast<double>(Hierarchy.Clusters.size());
+    State.counters["Levels"] = static_cast<double>(Hierarchy.NumLevels());
+}
+BENCHMARK(BM_BuildClusterHierarchy);
+
+static void BM_SurfaceHeightQuery(benchmark::State& State)
+{
+    const FNoiseSettings Settings = MakePlanetSettings();
+    auto Density = [&Settings](const FVec3& P) { return FFractalNoise::SampleDensity(Settings, P); };
+
+    FSdfQuerySettings QuerySettings;
+    QuerySettings.LipschitzBound = FFractalNoise::LipschitzBound(Settings);
+    const double MaxHeight = FFractalNoise::MaxHeight(Settings) + 1.0;
+
+    double Angle = 0.0;
+    for (auto _ : State)
+    {
+        const FVec3 Direction(std::cos(Angle), std::sin(Angle), 0.0);
+        double Radius = 0.0;
+        benchmark::DoNotOptimize(FSdfQueries::FindSurfaceRadius(Density, Settings.PlanetCenter, Direction, Settings.PlanetRadius - MaxHeight, Settings.PlanetRadius + MaxHeight, QuerySettings, Radius));
+        benchmark::DoNotOptimize(Radius);
+        Angle += 0.01;
+    }
+}
+BENCHMARK(BM_SurfaceHeightQuery);
+
+/** Classifying a 16^3 planet grid of 128 unit chunks, against sampling its surface chunks in BM_FillDensityGrid */
+static void BM_BuildOccupancyPyramid(benchmark::State& State)
+{
+    const FNoiseSettings Settings = MakePlanetSettings();
+    const FNoiseBounds Bounds = FNoiseBounds::Build(Settings);
+    const int32_t ChunksPerAxis = 16;
+    const float ChunkSize = 128.0f;
+    const FVec3 GridOrigin = Settings.PlanetCenter - FVec3((ChunksPerAxis / 2) * ChunkSize);
+
+    FOccupancyPyramid Pyramid;
+    for (auto _ : State)
+    {
+        Pyramid.Build(Settings, Bounds, GridOrigin, ChunkSize, ChunkSize / FChunkLayout::UnpaddedSize, ChunksPerAxis);
+        benchmark::DoNotOptimize(Pyramid.Levels.data());
+    }
+
+    int64_t NumSurface = 0;
+    for (const FDensityRange& Range : Pyramid.Levels[0])
+    {
+        NumSurface += Range.Classify() == EOccupancy::Surface;
+    }
+    State.counters["SurfaceChunks"] = static_cast<double>(NumSurface);
+}
+BENCHMARK(BM_BuildOccupancyPyramid);
+
+static void BM_CompletionQueue(benchmark::State& State)
+{
+    // Workers hand finished chunk buffers to one consumer, as the planet actor does with generated chunks
+    const int32_t NumProducers = static_cast<int32_t>(State.range(0));
+    const int32_t ItemsPerProducer = 4096;
+    using FPayload = std::unique_ptr<std::vector<FVec3>>;
+
+    for (auto _ : State)
+    {
+        TCompletionQueue<FPayload> Queue(256);
+        std::vector<std::thread> Producers;
+        for (int32_t Producer = 0; Producer < NumProducers; Producer++)
+        {
+            Producers.emplace_back([&Queue]()
+            {
+                for (int32_t Item = 0; Item < ItemsPerProducer; Item++)
+                {
+                    FPayload Payload = std::make_unique<std::vector<FVec3>>(16);
+                    while (!Queue.TryPush(std::move(Payload)))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        FPayload Payload;
+        for (int32_t Remaining = NumProducers * ItemsPerProducer; Remaining > 0;)
+        {
+            if (Queue.TryPop(Payload))
+            {
+                benchmark::DoNotOptimize(Payload->data());
+                Remaining--;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+        for (std::thread& Producer : Producers)
+        {
+            Producer.join();
+        }
+        State.counters["MaxDepth"] = static_cast<double>(Queue.GetStats().MaxDepth);
+    }
+    State.SetItemsProcessed(State.iterations() * NumProducers * ItemsPerProducer);
+}
+BENCHMARK(BM_CompletionQueue)->Arg(1)->Arg(4)->UseRealTime();
+
+static void BM_ChunkPayloadAllocation(benchmark::State& State)
+{
+    // Buffers one 16^3 chunk allocates: density, vertex grid, cell masks, positions, normals, indices and UVs
+    const size_t Sizes[] = { 18 * 18 * 18 * 4, 18 * 18 * 18 * 4, 18 * 18 * 18, 3000 * 24, 3000 * 24, 18000 * 4, 3000 * 16 };
+    const bool bSlab = State.range(0) != 0;
+    void* Buffers[sizeof(Sizes) / sizeof(Sizes[0])];
+
+    for (auto _ : State)
+    {
+        for (size_t Index = 0; Index < sizeof(Sizes) / sizeof(Sizes[0]); Index++)
+        {
+            Buffers[Index] = bSlab ? FSlabAllocator::Get().Allocate(Sizes[Index]) : ::operator new(Sizes[Index]);
+            static_cast<char*>(Buffers[Index])[0] = 1;
+        }
+        benchmark::DoNotOptimize(Buffers);
+        for (void* Buffer : Buffers)
+        {
+            if (bSlab)
+            {
+                FSlabAllocator::Get().Free(Buffer);
+            }
+            else
+            {
+                ::operator delete(Buffer);
+            }
+        }
+    }
+    State.SetLabel(bSlab ? "Slab" : "System");
+}
+BENCHMARK(BM_ChunkPayloadAllocation)->Arg(0)->Arg(1)->Threads(1)->Threads(4);
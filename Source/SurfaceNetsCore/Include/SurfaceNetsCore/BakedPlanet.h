@@ -0,0 +1,277 @@
+#pragma once
+
+#include "SurfaceNetsCore/MathTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace SurfaceNetsCore
+{
+    namespace BakeDetail
+    {
+        /** Appends trivially copyable values to a little-endian blob */
+        struct FWriter
+        {
+            std::vector<uint8_t>& Out;
+
+            template <typename T>
+            void Write(const T& Value)
+            {
+                const uint8_t* Bytes = reinterpret_cast<const uint8_t*>(&Value);
+                Out.insert(Out.end(), Bytes, Bytes + sizeof(Value));
+            }
+
+            void WriteVec(const FVec3& Vector)
+            {
+                Write(static_cast<float>(Vector.X));
+                Write(static_cast<float>(Vector.Y));
+                Write(static_cast<float>(Vector.Z));
+            }
+
+            void WriteIntVec(const FIntVec3& Vector)
+            {
+                Write(Vector.X);
+                Write(Vector.Y);
+                Write(Vector.Z);
+            }
+        };
+
+        /** Bounds-checked reads; the first overrun clears bOk and every later read is a no-op */
+        struct FReader
+        {
+            const uint8_t* Data = nullptr;
+            size_t Size = 0;
+            size_t Cursor = 0;
+            bool bOk = true;
+
+            template <typename T>
+            void Read(T& Value)
+            {
+                if (!bOk || Cursor + sizeof(Value) > Size)
+                {
+                    bOk = false;
+                    return;
+                }
+                std::memcpy(&Value, Data + Cursor, sizeof(Value));
+                Cursor += sizeof(Value);
+            }
+
+            void ReadVec(FVec3& Vector)
+            {
+                float X = 0.0f, Y = 0.0f, Z = 0.0f;
+                Read(X);
+                Read(Y);
+                Read(Z);
+                Vector = FVec3(X, Y, Z);
+            }
+
+            void ReadIntVec(FIntVec3& Vector)
+            {
+                Read(Vector.X);
+                Read(Vector.Y);
+                Read(Vector.Z);
+            }
+
+            /** Whether Count items of ItemSize bytes can still follow, checked before allocating for them */
+            bool CanRead(uint64_t Count, uint64_t ItemSize) const
+            {
+                return bOk && Count <= (Size - Cursor) / ItemSize;
+            }
+        };
+    }
+
+    /** One chunk's mesh in a baked region, indices local to the chunk */
+    struct FBakedChunk
+    {
+        FIntVec3 Coordinates;
+        std::vector<FVec3> Positions;
+        std::vector<FVec3> Normals;
+        std::vector<int32_t> Indices;
+    };
+
+    /**
+     * The surface chunks of one cubic block of the chunk grid, the unit an offline bake shards and writes.
+     * BakeHash identifies the planet and bake parameters, so a merge can reject regions from another bake.
+     */
+    struct FBakedRegion
+    {
+        static constexpr uint32_t Magic = 0x52424E53; // "SNBR"
+        static constexpr uint32_t Version = 1;
+
+        uint32_t BakeHash = 0;
+        FIntVec3 RegionCoordinates;
+        std::vector<FBakedChunk> Chunks;
+
+        uint64_t NumTriangles() const
+        {
+            uint64_t Count = 0;
+            for (const FBakedChunk& Chunk : Chunks)
+            {
+                Count += Chunk.Indices.size() / 3;
+            }
+            return Count;
+        }
+
+        /** Little-endian binary blob; positions and normals are stored as floats */
+        void Serialize(std::vector<uint8_t>& Out) const
+        {
+            Out.clear();
+            BakeDetail::FWriter Writer{ Out };
+            Writer.Write(Magic);
+            Writer.Write(Version);
+            Writer.Write(BakeHash);
+            Writer.WriteIntVec(RegionCoordinates);
+            Writer.Write(static_cast<uint32_t>(Chunks.size()));
+
+            for (const FBakedChunk& Chunk : Chunks)
+            {
+                Writer.WriteIntVec(Chunk.Coordinates);
+                Writer.Write(static_cast<uint32_t>(Chunk.Positions.size()));
+                Writer.Write(static_cast<uint32_t>(Chunk.Indices.size()));
+                for (size_t Vertex = 0; Vertex < Chunk.Positions.size(); Vertex++)
+                {
+                    Writer.WriteVec(Chunk.Positions[Vertex]);
+                    Writer.WriteVec(Chunk.Normals[Vertex]);
+                }
+                const uint8_t* IndexBytes = reinterpret_cast<const uint8_t*>(Chunk.Indices.data());
+                Out.insert(Out.end(), IndexBytes, IndexBytes + Chunk.Indices.size() * sizeof(int32_t));
+            }
+        }
+
+        /** Read a Serialize blob; false on a malformed or foreign blob or an index outside its chunk */
+        bool Deserialize(const uint8_t* Data, size_t Size)
+        {
+            Chunks.clear();
+            BakeDetail::FReader Reader{ Data, Size };
+
+            uint32_t FileMagic = 0, FileVersion = 0, NumChunks = 0;
+            Reader.Read(FileMagic);
+            Reader.Read(FileVersion);
+            Reader.Read(BakeHash);
+            Reader.ReadIntVec(RegionCoordinates);
+            Reader.Read(NumChunks);
+            if (!Reader.bOk || FileMagic != Magic || FileVersion != Version || !Reader.CanRead(NumChunks, 20))
+            {
+                return false;
+            }
+
+            Chunks.resize(NumChunks);
+            for (FBakedChunk& Chunk : Chunks)
+            {
+                uint32_t NumVertices = 0, NumIndices = 0;
+                Reader.ReadIntVec(Chunk.Coordinates);
+                Reader.Read(NumVertices);
+                Reader.Read(NumIndices);
+                if (!Reader.CanRead(NumVertices, 24) || !Reader.CanRead(NumIndices, sizeof(int32_t)))
+                {
+                    Chunks.clear();
+                    return false;
+                }
+
+                Chunk.Positions.resize(NumVertices);
+                Chunk.Normals.resize(NumVertices);
+                for (uint32_t Vertex = 0; Vertex < NumVertices; Vertex++)
+                {
+                    Reader.ReadVec(Chunk.Positions[Vertex]);
+                    Reader.ReadVec(Chunk.Normals[Vertex]);
+                }
+                Chunk.Indices.resize(NumIndices);
+                for (int32_t& Index : Chunk.Indices)
+                {
+                    Reader.Read(Index);
+                    Reader.bOk = Reader.bOk && Index >= 0 && static_cast<uint32_t>(Index) < NumVertices;
+                }
+            }
+
+            if (!Reader.bOk)
+            {
+                Chunks.clear();
+                return false;
+            }
+            return true;
+        }
+    };
+
+    /**
+     * Table of contents of a merged bake. The planet file holds the uint64 size of this blob, the blob, then the
+     * region blobs back to back; each entry's Offset counts from the end of the index.
+     */
+    struct FBakedPlanetIndex
+    {
+        static constexpr uint32_t Magic = 0x50424E53; // "SNBP"
+        static constexpr uint32_t Version = 1;
+
+        struct FRegionEntry
+        {
+            FIntVec3 RegionCoordinates;
+            uint64_t Offset = 0;
+            uint64_t Size = 0;
+            uint32_t NumChunks = 0;
+            uint64_t NumTriangles = 0;
+        };
+
+        uint32_t BakeHash = 0;
+        int32_t ChunksPerAxis = 0;
+        int32_t RegionSize = 0;
+        float ChunkSize = 0.0f;
+        std::vector<FRegionEntry> Regions;
+
+        void Serialize(std::vector<uint8_t>& Out) const
+        {
+            Out.clear();
+            BakeDetail::FWriter Writer{ Out };
+            Writer.Write(Magic);
+            Writer.Write(Version);
+            Writer.Write(BakeHash);
+            Writer.Write(ChunksPerAxis);
+            Writer.Write(RegionSize);
+            Writer.Write(ChunkSize);
+            Writer.Write(static_cast<uint32_t>(Regions.size()));
+            for (const FRegionEntry& Region : Regions)
+            {
+                Writer.WriteIntVec(Region.RegionCoordinates);
+                Writer.Write(Region.Offset);
+                Writer.Write(Region.Size);
+                Writer.Write(Region.NumChunks);
+                Writer.Write(Region.NumTriangles);
+            }
+        }
+
+        bool Deserialize(const uint8_t* Data, size_t Size)
+        {
+            Regions.clear();
+            BakeDetail::FReader Reader{ Data, Size };
+
+            uint32_t FileMagic = 0, FileVersion = 0, NumRegions = 0;
+            Reader.Read(FileMagic);
+            Reader.Read(FileVersion);
+            Reader.Read(BakeHash);
+            Reader.Read(ChunksPerAxis);
+            Reader.Read(RegionSize);
+            Reader.Read(ChunkSize);
+            Reader.Read(NumRegions);
+            if (!Reader.bOk || FileMagic != Magic || FileVersion != Version || !Reader.CanRead(NumRegions, 40))
+            {
+                return false;
+            }
+
+            Regions.resize(NumRegions);
+            for (FRegionEntry& Region : Regions)
+            {
+                Reader.ReadIntVec(Region.RegionCoordinates);
+                Reader.Read(Region.Offset);
+                Reader.Read(Region.Size);
+                Reader.Read(Region.NumChunks);
+                Reader.Read(Region.NumTriangles);
+            }
+            if (!Reader.bOk)
+            {
+                Regions.clear();
+                return false;
+            }
+            return true;
+        }
+    };
+}
@@ -0,0 +1,384 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace SurfaceNetsCore
+{
+    /** Cube corner offsets, corner index bits are x | y << 1 | z << 2 */
+    inline constexpr int32_t CubeCorners[8][3] = {
+        {0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0},
+        {0, 0, 1}, {1, 0, 1}, {0, 1, 1}, {1, 1, 1}
+    };
+
+    /** Cube edges as corner pairs */
+    inline constexpr int32_t CubeEdges[12][2] = {
+        {0, 1}, {0, 2}, {0, 4}, {1, 3}, {1, 5}, {2, 3}, {2, 6}, {3, 7}, {4, 5}, {4, 6}, {5, 7}, {6, 7}
+    };
+
+    /** Cube faces as corners in cyclic order, face F lies on axis F / 2 at its min (even F) or max (odd F) side */
+    inline constexpr int32_t CubeFaces[6][4] = {
+        {0, 2, 6, 4}, {1, 3, 7, 5}, // -X, +X
+        {0, 1, 5, 4}, {2, 3, 7, 6}, // -Y, +Y
+        {0, 1, 3, 2}, {4, 5, 7, 6}  // -Z, +Z
+    };
+
+    /**
+     * Surface topology of one sign configuration (bit i of the mask set when corner i is inside).
+     *
+     * Crossing edges are linked when they bound the same surface segment on a cube face; each connected group
+     * is one sheet of surface through the cell. Ambiguous faces (diagonal inside corners) separate the inside
+     * corners, so two cells sharing a face always agree on how it is cut.
+     */
+    struct FCellTopology
+    {
+        /** Number of separate surface sheets through the cell */
+        uint8_t NumComponents = 0;
+
+        /** Sheet each edge belongs to, -1 for edges the surface does not cross */
+        int8_t EdgeComponent[12] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+    };
+
+    /**
+     * Edges the surface crosses for one sign configuration, in ascending edge order so sums over them
+     * match a plain loop over all 12 edges.
+     */
+    struct FCellEdgeList
+    {
+        uint8_t NumEdges = 0;
+        uint8_t Edges[12] = {};
+
+        /** Bit A set when the cell's edge along axis A from corner 0 (edges 0, 1, 2) needs a quad */
+        uint8_t QuadAxes = 0;
+    };
+
+    /** Most triangles any configuration needs; the compile-time table build fails if one would need more */
+    inline constexpr int32_t MaxCellTriangles = 5;
+
+    /**
+     * Marching cubes triangulation of one sign configuration: triangles as crossing edge triples, wound like
+     * the Surface Nets quads. Sheets follow FCellTopology, so neighbouring cells cut shared faces the same way.
+     */
+    struct FCellTriangles
+    {
+        uint8_t NumTriangles = 0;
+        uint8_t Edges[MaxCellTriangles * 3] = {};
+    };
+
+    namespace CellTablesDetail
+    {
+        constexpr int32_t EdgeBetween(int32_t CornerA, int32_t CornerB)
+        {
+            for (int32_t Edge = 0; Edge < 12; Edge++)
+            {
+                if ((CubeEdges[Edge][0] == CornerA && CubeEdges[Edge][1] == CornerB) ||
+                    (CubeEdges[Edge][0] == CornerB && CubeEdges[Edge][1] == CornerA))
+                {
+                    return Edge;
+                }
+            }
+            return -1;
+        }
+
+        constexpr bool IsCornerInside(int32_t Mask, int32_t Corner)
+        {
+            return ((Mask >> Corner) & 1) != 0;
+        }
+
+        constexpr bool IsEdgeCrossed(int32_t Mask, int32_t Edge)
+        {
+            return IsCornerInside(Mask, CubeEdges[Edge][0]) != IsCornerInside(Mask, CubeEdges[Edge][1]);
+        }
+
+        /**
+         * True when, seen from outside the cube, Corner lies to the left of the segment from EdgeA's midpoint to
+         * EdgeB's midpoint on Face. Doubled coordinates keep the midpoints integral.
+         */
+        constexpr bool IsLeftOfSegment(int32_t Face, int32_t EdgeA, int32_t EdgeB, int32_t Corner)
+        {
+            int32_t A[3] = {};
+            int32_t B[3] = {};
+            int32_t C[3] = {};
+            for (int32_t i = 0; i < 3; i++)
+            {
+                A[i] = CubeCorners[CubeEdges[EdgeA][0]][i] + CubeCorners[CubeEdges[EdgeA][1]][i];
+                B[i] = CubeCorners[CubeEdges[EdgeB][0]][i] + CubeCorners[CubeEdges[EdgeB][1]][i];
+                C[i] = 2 * CubeCorners[Corner][i];
+            }
+
+            // Component of (B - A) x (C - A) along the face axis, whose outward direction depends on the side
+            const int32_t Axis = Face / 2;
+            const int32_t U = (Axis + 1) % 3;
+            const int32_t V = (Axis + 2) % 3;
+            const int32_t Cross = (B[U] - A[U]) * (C[V] - A[V]) - (B[V] - A[V]) * (C[U] - A[U]);
+            return (Face % 2 == 1) ? Cross > 0 : Cross < 0;
+        }
+
+        /**
+         * Call Visit(EdgeFrom, EdgeTo) for every surface segment on the cube faces, directed so the face's inside
+         * corners are on the left seen from outside the cube; every crossed edge then has one segment leaving
+         * and one arriving. A face has 0, 2 or 4 crossed edges; with 4 the segments wrap around each inside corner.
+         */
+        template <typename TVisitor>
+        constexpr void ForEachFaceSegment(int32_t Mask, TVisitor&& Visit)
+        {
+            for (int32_t Face = 0; Face < 6; Face++)
+            {
+                int32_t FaceEdges[4] = {};
+                int32_t Crossed[4] = {};
+                int32_t NumCrossed = 0;
+                for (int32_t Side = 0; Side < 4; Side++)
+                {
+                    FaceEdges[Side] = EdgeBetween(CubeFaces[Face][Side], CubeFaces[Face][(Side + 1) % 4]);
+                    if (IsEdgeCrossed(Mask, FaceEdges[Side]))
+                    {
+                        Crossed[NumCrossed++] = FaceEdges[Side];
+                    }
+                }
+
+                if (NumCrossed == 2)
+                {
+                    // Any inside corner of the face is on the inside of the single segment
+                    int32_t InsideCorner = CubeFaces[Face][0];
+                    for (int32_t Corner = 0; Corner < 4; Corner++)
+                    {
+                        if (IsCornerInside(Mask, CubeFaces[Face][Corner]))
+                        {
+                            InsideCorner = CubeFaces[Face][Corner];
+                        }
+                    }
+
+                    if (IsLeftOfSegment(Face, Crossed[0], Crossed[1], InsideCorner))
+                    {
+                        Visit(Crossed[0], Crossed[1]);
+                    }
+                    else
+                    {
+                        Visit(Crossed[1], Crossed[0]);
+                    }
+                }
+                else if (NumCrossed == 4)
+                {
+                    // Side k runs from corner k to corner k+1, so corner k sits between sides k-1 and k
+                    for (int32_t Corner = 0; Corner < 4; Corner++)
+                    {
+                        const int32_t CubeCorner = CubeFaces[Face][Corner];
+                        if (!IsCornerInside(Mask, CubeCorner))
+                        {
+                            continue;
+                        }
+
+                        const int32_t EdgeA = FaceEdges[(Corner + 3) % 4];
+                        const int32_t EdgeB = FaceEdges[Corner];
+                        if (IsLeftOfSegment(Face, EdgeA, EdgeB, CubeCorner))
+                        {
+                            Visit(EdgeA, EdgeB);
+                        }
+                        else
+                        {
+                            Visit(EdgeB, EdgeA);
+                        }
+                    }
+                }
+            }
+        }
+
+        constexpr FCellTopology BuildCellTopology(int32_t Mask)
+        {
+            int32_t Parent[12] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+
+            auto Find = [&Parent](int32_t Edge)
+            {
+                while (Parent[Edge] != Edge)
+                {
+                    Edge = Parent[Edge];
+                }
+                return Edge;
+            };
+
+            ForEachFaceSegment(Mask, [&Parent, &Find](int32_t EdgeA, int32_t EdgeB)
+            {
+                const int32_t RootA = Find(EdgeA);
+                const int32_t RootB = Find(EdgeB);
+                if (RootA != RootB)
+                {
+                    Parent[RootB] = RootA;
+                }
+            });
+
+            // Number components in order of their lowest edge so the table is deterministic
+            FCellTopology Topology;
+            int32_t RootComponent[12] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+            for (int32_t Edge = 0; Edge < 12; Edge++)
+            {
+                if (!IsEdgeCrossed(Mask, Edge))
+                {
+                    continue;
+                }
+
+                const int32_t Root = Find(Edge);
+                if (RootComponent[Root] < 0)
+                {
+                    RootComponent[Root] = Topology.NumComponents++;
+                }
+                Topology.EdgeComponent[Edge] = static_cast<int8_t>(RootComponent[Root]);
+            }
+
+            return Topology;
+        }
+
+        constexpr std::array<FCellTopology, 256> BuildCellTopologyTable()
+        {
+            std::array<FCellTopology, 256> Table = {};
+            for (int32_t Mask = 0; Mask < 256; Mask++)
+            {
+                Table[Mask] = BuildCellTopology(Mask);
+            }
+            return Table;
+        }
+
+        constexpr FCellEdgeList BuildCellEdgeList(int32_t Mask)
+        {
+            FCellEdgeList List;
+            for (int32_t Edge = 0; Edge < 12; Edge++)
+            {
+                if (IsEdgeCrossed(Mask, Edge))
+                {
+                    List.Edges[List.NumEdges++] = static_cast<uint8_t>(Edge);
+                }
+            }
+            for (int32_t Axis = 0; Axis < 3; Axis++)
+            {
+                if (IsEdgeCrossed(Mask, Axis))
+                {
+                    List.QuadAxes |= static_cast<uint8_t>(1u << Axis);
+                }
+            }
+            return List;
+        }
+
+        constexpr bool IsEdgeOnFace(int32_t Edge, int32_t Face)
+        {
+            int32_t NumOnFace = 0;
+            for (int32_t Corner = 0; Corner < 4; Corner++)
+            {
+                NumOnFace += (CubeFaces[Face][Corner] == CubeEdges[Edge][0] || CubeFaces[Face][Corner] == CubeEdges[Edge][1]) ? 1 : 0;
+            }
+            return NumOnFace == 2;
+        }
+
+        constexpr bool DoEdgesShareFace(int32_t EdgeA, int32_t EdgeB)
+        {
+            for (int32_t Face = 0; Face < 6; Face++)
+            {
+                if (IsEdgeOnFace(EdgeA, Face) && IsEdgeOnFace(EdgeB, Face))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * Walk each sheet's loop of face segments and fan it into triangles. The fan apex is chosen so no
+         * diagonal lies in a cube face: on an ambiguous face it would join the two segments and collide with
+         * the neighbouring cell's triangles.
+         */
+        constexpr FCellTriangles BuildCellTriangles(int32_t Mask)
+        {
+            int32_t Next[12] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+            ForEachFaceSegment(Mask, [&Next](int32_t EdgeFrom, int32_t EdgeTo)
+            {
+                Next[EdgeFrom] = EdgeTo;
+            });
+
+            FCellTriangles Triangles;
+            bool Visited[12] = {};
+            for (int32_t Start = 0; Start < 12; Start++)
+            {
+                if (Next[Start] < 0 || Visited[Start])
+                {
+                    continue;
+                }
+
+                int32_t Loop[12] = {};
+                int32_t LoopSize = 0;
+                for (int32_t Edge = Start; !Visited[Edge]; Edge = Next[Edge])
+                {
+                    Visited[Edge] = true;
+                    Loop[LoopSize++] = Edge;
+                }
+
+                int32_t Apex = 0;
+                for (int32_t Candidate = 0; Candidate < LoopSize; Candidate++)
+                {
+                    bool bInteriorDiagonals = true;
+                    for (int32_t i = 2; i + 1 < LoopSize; i++)
+                    {
+                        if (DoEdgesShareFace(Loop[Candidate], Loop[(Candidate + i) % LoopSize]))
+                        {
+                            bInteriorDiagonals = false;
+                        }
+                    }
+                    if (bInteriorDiagonals)
+                    {
+                        Apex = Candidate;
+                        break;
+                    }
+                }
+
+                for (int32_t i = 1; i + 1 < LoopSize; i++)
+                {
+                    Triangles.Edges[Triangles.NumTriangles * 3 + 0] = static_cast<uint8_t>(Loop[Apex]);
+                    Triangles.Edges[Triangles.NumTriangles * 3 + 1] = static_cast<uint8_t>(Loop[(Apex + i) % LoopSize]);
+                    Triangles.Edges[Triangles.NumTriangles * 3 + 2] = static_cast<uint8_t>(Loop[(Apex + i + 1) % LoopSize]);
+                    Triangles.NumTriangles++;
+                }
+            }
+
+            return Triangles;
+        }
+
+        constexpr std::array<FCellTriangles, 256> BuildCellTriangleTable()
+        {
+            std::array<FCellTriangles, 256> Table = {};
+            for (int32_t Mask = 0; Mask < 256; Mask++)
+            {
+                Table[Mask] = BuildCellTriangles(Mask);
+            }
+            return Table;
+        }
+
+        constexpr std::array<FCellEdgeList, 256> BuildCellEdgeTable()
+        {
+            std::array<FCellEdgeList, 256> Table = {};
+            for (int32_t Mask = 0; Mask < 256; Mask++)
+            {
+                Table[Mask] = BuildCellEdgeList(Mask);
+            }
+            return Table;
+        }
+    }
+
+    /** Crossing edges per corner sign mask, built at compile time; masks 0 and 255 have none */
+    inline constexpr std::array<FCellEdgeList, 256> CellEdgeTable = CellTablesDetail::BuildCellEdgeTable();
+
+    /** Marching cubes triangles per corner sign mask, built at compile time */
+    inline constexpr std::array<FCellTriangles, 256> CellTriangleTable = CellTablesDetail::BuildCellTriangleTable();
+
+    /** Surface sheets per corner sign mask, built at compile time */
+    inline constexpr std::array<FCellTopology, 256> CellTopologyTable = CellTablesDetail::BuildCellTopologyTable();
+
+    /** At most four separate sheets can pass through one cell */
+    inline constexpr int32_t MaxCellComponents = 4;
+
+    /**
+     * Cube edge that a quad's grid edge maps to in each of the four cells sharing it,
+     * per axis, in the order (P, P - B, P - C, P - B - C) used by the quad builder.
+     */
+    inline constexpr int32_t QuadCellEdges[3][4] = {
+        {0, 5, 8, 11}, // X edges, B = Y, C = Z
+        {1, 9, 3, 10}, // Y edges, B = Z, C = X
+        {2, 4, 6, 7}   // Z edges, B = X, C = Y
+    };
+}
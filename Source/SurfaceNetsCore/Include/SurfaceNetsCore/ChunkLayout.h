@@ -0,0 +1,58 @@
+#pragma once
+
+#include "SurfaceNetsCore/MathTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SurfaceNetsCore
+{
+    /**
+     * Voxel layout of a single chunk, equivalent to the Rust chunk shape:
+     * 16³ unpadded, 18³ with one voxel of boundary padding on every side for seamless stitching
+     */
+    struct FChunkLayout
+    {
+        static constexpr int32_t UnpaddedSize = 16;
+        static constexpr int32_t PaddedSize = UnpaddedSize + 2;
+
+        /** World position of the padded grid's first sample */
+        FVec3 PaddedOrigin;
+
+        /** Distance between two neighbouring samples */
+        float VoxelSize = 1.0f;
+
+        /** Samples per axis of the padded grid */
+        int32_t GridSize = PaddedSize;
+
+        /** Build the padded layout for a chunk centred at Center with the given world size */
+        static FChunkLayout ForChunk(const FVec3& Center, float ChunkSize)
+        {
+            FChunkLayout Layout;
+            Layout.GridSize = PaddedSize;
+            Layout.VoxelSize = ChunkSize / UnpaddedSize;
+
+            // Offset by one voxel so the padding sits outside the chunk's own extent
+            Layout.PaddedOrigin = Center - FVec3(ChunkSize * 0.5f) - FVec3(Layout.VoxelSize);
+            return Layout;
+        }
+
+        /** Total number of samples in the padded grid */
+        constexpr size_t NumSamples() const
+        {
+            return static_cast<size_t>(GridSize) * GridSize * GridSize;
+        }
+
+        /** Linear index of a sample, x fastest */
+        constexpr int32_t Index(int32_t X, int32_t Y, int32_t Z) const
+        {
+            return X + Y * GridSize + Z * GridSize * GridSize;
+        }
+
+        /** World position of a sample */
+        FVec3 SamplePosition(int32_t X, int32_t Y, int32_t Z) const
+        {
+            return PaddedOrigin + FVec3(X * VoxelSize, Y * VoxelSize, Z * VoxelSize);
+        }
+    };
+}
@@ -0,0 +1,651 @@
+#pragma once
+
+#include "SurfaceNetsCore/MathTypes.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace SurfaceNetsCore
+{
+    struct FClusterBuildSettings
+    {
+        /** Cluster size limits; vertices are addressed with 8-bit local indices, so at most 256 */
+        int32_t MaxTriangles = 128;
+        int32_t MaxVertices = 256;
+
+        /** Level N > 0 merges vertices on a grid of BaseCellSize * 2^N, usually the voxel size */
+        double BaseCellSize = 1.0;
+
+        /** Stop adding levels at this many, or when a level keeps more than MinReduction of the triangles */
+        int32_t MaxLevels = 8;
+        double MinReduction = 0.85;
+    };
+
+    /**
+     * A group of at most MaxTriangles triangles drawn as a unit. Its triangles index its own vertex range through
+     * 8-bit local indices.
+     */
+    struct FMeshCluster
+    {
+        /** 0 is the full-detail mesh, higher levels are coarser */
+        int32_t Level = 0;
+
+        uint32_t FirstVertex = 0;
+        uint32_t NumVertices = 0;
+        uint32_t FirstIndex = 0;
+        uint32_t NumTriangles = 0;
+
+        /** Bounds of the cluster's own triangles */
+        FVec3 BoundsMin;
+        FVec3 BoundsMax;
+
+        /**
+         * Sphere enclosing the cluster and all its descendants. LOD selection measures Error and ParentError from
+         * these spheres, which grow monotonically up the hierarchy, so exactly one level is picked along any path.
+         */
+        FVec3 LodCenter;
+        double LodRadius = 0.0;
+
+        /** Largest vertex displacement of this cluster's level from the full-detail mesh, in world units */
+        float Error = 0.0f;
+
+        /** Error of the parent level, FLT_MAX at the coarsest level */
+        float ParentError = FLT_MAX;
+
+        /** Coarser cluster covering this one, -1 at the coarsest level */
+        int32_t Parent = -1;
+    };
+
+    /**
+     * Cluster LOD hierarchy of a static mesh: each level re-partitioned into clusters, each cluster linked to the
+     * coarser cluster covering it. A renderer draws a cluster when its own error is small enough on screen and its
+     * parent's is not.
+     *
+     * Levels are simplified as a whole, so clusters of one level share their borders exactly; where the selection
+     * switches level, borders only meet within the coarser level's error, like neighbouring chunk LODs.
+     */
+    struct FClusterHierarchy
+    {
+        std::vector<FMeshCluster> Clusters;
+
+        /** Cluster vertices, each cluster's range contiguous */
+        std::vector<FVec3> Positions;
+        std::vector<FVec3> Normals;
+
+        /** Three local vertex indices per triangle, each cluster's range contiguous */
+        std::vector<uint8_t> Indices;
+
+        /** Clusters of level L are Clusters[LevelOffsets[L]] up to Clusters[LevelOffsets[L + 1]] */
+        std::vector<int32_t> LevelOffsets;
+
+        /** Children of cluster C are Children[ChildOffsets[C]] up to Children[ChildOffsets[C + 1]] */
+        std::vector<int32_t> ChildOffsets;
+        std::vector<int32_t> Children;
+
+        int32_t NumLevels() const { return LevelOffsets.empty() ? 0 : static_cast<int32_t>(LevelOffsets.size()) - 1; }
+
+        size_t NumTriangles(int32_t Level) const
+        {
+            size_t Count = 0;
+            for (int32_t Cluster = LevelOffsets[Level]; Cluster < LevelOffsets[Level + 1]; Cluster++)
+            {
+                Count += Clusters[Cluster].NumTriangles;
+            }
+            return Count;
+        }
+
+        void Reset()
+        {
+            Clusters.clear();
+            Positions.clear();
+            Normals.clear();
+            Indices.clear();
+            LevelOffsets.clear();
+            ChildOffsets.clear();
+            Children.clear();
+        }
+
+        static constexpr uint32_t Magic = 0x48434E53; // "SNCH"
+        static constexpr uint32_t Version = 1;
+
+        /** Little-endian binary blob; positions and normals are stored as floats */
+        void Serialize(std::vector<uint8_t>& Out) const
+        {
+            Out.clear();
+            auto Write = [&Out](const auto& Value)
+            {
+                const uint8_t* Bytes = reinterpret_cast<const uint8_t*>(&Value);
+                Out.insert(Out.end(), Bytes, Bytes + sizeof(Value));
+            };
+            auto WriteVec = [&Write](const FVec3& Vector)
+            {
+                Write(static_cast<float>(Vector.X));
+                Write(static_cast<float>(Vector.Y));
+                Write(static_cast<float>(Vector.Z));
+            };
+
+            Write(Magic);
+            Write(Version);
+            Write(static_cast<uint32_t>(Clusters.size()));
+            Write(static_cast<uint32_t>(Positions.size()));
+            Write(static_cast<uint32_t>(Indices.size()));
+            Write(static_cast<uint32_t>(LevelOffsets.size()));
+
+            for (const FMeshCluster& Cluster : Clusters)
+            {
+                Write(Cluster.Level);
+                Write(Cluster.FirstVertex);
+                Write(Cluster.NumVertices);
+                Write(Cluster.FirstIndex);
+                Write(Cluster.NumTriangles);
+                WriteVec(Cluster.BoundsMin);
+                WriteVec(Cluster.BoundsMax);
+                WriteVec(Cluster.LodCenter);
+                Write(static_cast<float>(Cluster.LodRadius));
+                Write(Cluster.Error);
+                Write(Cluster.ParentError);
+                Write(Cluster.Parent);
+            }
+            for (size_t Vertex = 0; Vertex < Positions.size(); Vertex++)
+            {
+                WriteVec(Positions[Vertex]);
+                WriteVec(Normals[Vertex]);
+            }
+            Out.insert(Out.end(), Indices.begin(), Indices.end());
+            for (const int32_t Offset : LevelOffsets)
+            {
+                Write(Offset);
+            }
+        }
+
+        /** Read a Serialize blob, rebuilding the child lists; false on a malformed or foreign blob */
+        bool Deserialize(const uint8_t* Data, size_t Size)
+        {
+            Reset();
+            size_t Cursor = 0;
+            bool bOk = true;
+            auto Read = [Data, Size, &Cursor, &bOk](auto& Value)
+            {
+                if (!bOk || Cursor + sizeof(Value) > Size)
+                {
+                    bOk = false;
+                    return;
+                }
+                std::memcpy(&Value, Data + Cursor, sizeof(Value));
+                Cursor += sizeof(Value);
+            };
+            auto ReadVec = [&Read](FVec3& Vector)
+            {
+                float X = 0.0f, Y = 0.0f, Z = 0.0f;
+                Read(X);
+                Read(Y);
+                Read(Z);
+                Vector = FVec3(X, Y, Z);
+            };
+
+            uint32_t FileMagic = 0, FileVersion = 0, NumClusters = 0, NumVertices = 0, NumIndices = 0, NumLevelOffsets = 0;
+            Read(FileMagic);
+            Read(FileVersion);
+            Read(NumClusters);
+            Read(NumVertices);
+            Read(NumIndices);
+            Read(NumLevelOffsets);
+            // Counts are checked against the blob size before anything is allocated from them
+            const uint64_t MinSize = static_cast<uint64_t>(NumClusters) * 72 + static_cast<uint64_t>(NumVertices) * 24 + NumIndices + NumLevelOffsets * 4ull;
+            if (!bOk || FileMagic != Magic || FileVersion != Version || MinSize > Size)
+            {
+                return false;
+            }
+
+            Clusters.resize(NumClusters);
+            for (FMeshCluster& Cluster : Clusters)
+            {
+                float LodRadius = 0.0f;
+                Read(Cluster.Level);
+                Read(Cluster.FirstVertex);
+                Read(Cluster.NumVertices);
+                Read(Cluster.FirstIndex);
+                Read(Cluster.NumTriangles);
+                ReadVec(Cluster.BoundsMin);
+                ReadVec(Cluster.BoundsMax);
+                ReadVec(Cluster.LodCenter);
+                Read(LodRadius);
+                Read(Cluster.Error);
+                Read(Cluster.ParentError);
+                Read(Cluster.Parent);
+                Cluster.LodRadius = LodRadius;
+            }
+            Positions.resize(NumVertices);
+            Normals.resize(NumVertices);
+            for (uint32_t Vertex = 0; Vertex < NumVertices; Vertex++)
+            {
+                ReadVec(Positions[Vertex]);
+                ReadVec(Normals[Vertex]);
+            }
+            if (!bOk || Cursor + NumIndices > Size)
+            {
+                Reset();
+                return false;
+            }
+            Indices.assign(Data + Cursor, Data + Cursor + NumIndices);
+            Cursor += NumIndices;
+            LevelOffsets.resize(NumLevelOffsets);
+            for (int32_t& Offset : LevelOffsets)
+            {
+                Read(Offset);
+            }
+
+            // Every range has to stay inside the arrays before anything indexes with it
+            for (const int32_t Offset : LevelOffsets)
+            {
+                bOk = bOk && Offset >= 0 && Offset <= static_cast<int32_t>(NumClusters);
+            }
+            for (const FMeshCluster& Cluster : Clusters)
+            {
+                bOk = bOk
+                    && static_cast<uint64_t>(Cluster.FirstVertex) + Cluster.NumVertices <= NumVertices
+                    && static_cast<uint64_t>(Cluster.FirstIndex) + Cluster.NumTriangles * 3ull <= NumIndices
+                    && Cluster.Parent >= -1 && Cluster.Parent < static_cast<int32_t>(NumClusters);
+            }
+            if (!bOk)
+            {
+                Reset();
+                return false;
+            }
+
+            BuildChildLists();
+            return true;
+        }
+
+        void BuildChildLists()
+        {
+            ChildOffsets.assign(Clusters.size() + 1, 0);
+            for (const FMeshCluster& Cluster : Clusters)
+            {
+                if (Cluster.Parent >= 0)
+                {
+                    ChildOffsets[Cluster.Parent + 1]++;
+                }
+            }
+            for (size_t Cluster = 0; Cluster < Clusters.size(); Cluster++)
+            {
+                ChildOffsets[Cluster + 1] += ChildOffsets[Cluster];
+            }
+
+            Children.resize(ChildOffsets.back());
+            std::vector<int32_t> Cursor(ChildOffsets.begin(), ChildOffsets.end() - 1);
+            for (size_t Cluster = 0; Cluster < Clusters.size(); Cluster++)
+            {
+                if (Clusters[Cluster].Parent >= 0)
+                {
+                    Children[Cursor[Clusters[Cluster].Parent]++] = static_cast<int32_t>(Cluster);
+                }
+            }
+        }
+    };
+
+    /**
+     * Builds FClusterHierarchy from an indexed triangle mesh on the CPU. Level 0 splits the mesh, coarser levels
+     * split vertex-clustered copies of it (vertices merged per grid cell), each by recursively splitting the
+     * triangle centroids along their longest axis.
+     */
+    struct FClusterBuilder
+    {
+        /** A whole level of the hierarchy as one indexed mesh */
+        struct FLevelMesh
+        {
+            std::vector<FVec3> Positions;
+            std::vector<FVec3> Normals;
+            std::vector<int32_t> Indices;
+
+            size_t NumTriangles() const { return Indices.size() / 3; }
+        };
+
+        static void Build(
+            const FVec3* Positions,
+            const FVec3* Normals,
+            int32_t NumVertices,
+            const int32_t* Indices,
+            size_t NumIndices,
+            const FClusterBuildSettings& Settings,
+            FClusterHierarchy& OutHierarchy)
+        {
+            OutHierarchy.Reset();
+
+            FLevelMesh Level;
+            Level.Positions.assign(Positions, Positions + NumVertices);
+            Level.Normals.assign(Normals, Normals + NumVertices);
+            Level.Indices.reserve(NumIndices - NumIndices % 3);
+            for (size_t i = 0; i + 2 < NumIndices; i += 3)
+            {
+                if (IsValidTriangle(Indices[i], Indices[i + 1], Indices[i + 2], NumVertices))
+                {
+                    Level.Indices.insert(Level.Indices.end(), { Indices[i], Indices[i + 1], Indices[i + 2] });
+                }
+            }
+
+            FClusterBuildSettings Limits = Settings;
+            Limits.MaxTriangles = std::max(Limits.MaxTriangles, 1);
+            Limits.MaxVertices = std::clamp(Limits.MaxVertices, 3, 256);
+
+            float Error = 0.0f;
+            for (int32_t LevelIndex = 0; LevelIndex < std::max(Settings.MaxLevels, 1); LevelIndex++)
+            {
+                OutHierarchy.LevelOffsets.push_back(static_cast<int32_t>(OutHierarchy.Clusters.size()));
+                AddLevelClusters(Level, LevelIndex, Error, Limits, OutHierarchy);
+                if (Level.NumTriangles() <= static_cast<size_t>(Limits.MaxTriangles))
+                {
+                    break;
+                }
+
+                // Every vertex moves at most a cell diagonal, and errors accumulate over the levels
+                const double CellSize = Settings.BaseCellSize * std::ldexp(1.0, LevelIndex + 1);
+                FLevelMesh Coarser;
+                SimplifyByVertexClustering(Level, CellSize, Coarser);
+                if (Coarser.NumTriangles() == 0 || Coarser.NumTriangles() > Level.NumTriangles() * Settings.MinReduction)
+                {
+                    break;
+                }
+                Error += static_cast<float>(CellSize * 1.7320508075688772);
+                Level = std::move(Coarser);
+            }
+            OutHierarchy.LevelOffsets.push_back(static_cast<int32_t>(OutHierarchy.Clusters.size()));
+
+            LinkLevels(OutHierarchy);
+            OutHierarchy.BuildChildLists();
+        }
+
+        /**
+         * Merge the vertices in each CellSize grid cell into their average. Cells are world aligned and averages
+         * taken over the whole level, so the result does not depend on how the level is later split.
+         */
+        static void SimplifyByVertexClustering(const FLevelMesh& In, double CellSize, FLevelMesh& Out)
+        {
+            Out.Positions.clear();
+            Out.Normals.clear();
+            Out.Indices.clear();
+
+            std::unordered_map<uint64_t, int32_t> CellVertices;
+            std::vector<int32_t> Remap(In.Positions.size());
+            std::vector<int32_t> CellCounts;
+            for (size_t Vertex = 0; Vertex < In.Positions.size(); Vertex++)
+            {
+                const uint64_t Key = MakeCellKey(In.Positions[Vertex], CellSize);
+                const auto Inserted = CellVertices.emplace(Key, static_cast<int32_t>(Out.Positions.size()));
+                if (Inserted.second)
+                {
+                    Out.Positions.push_back(FVec3());
+                    Out.Normals.push_back(FVec3());
+                    CellCounts.push_back(0);
+                }
+
+                const int32_t Merged = Inserted.first->second;
+                Remap[Vertex] = Merged;
+                Out.Positions[Merged] += In.Positions[Vertex];
+                Out.Normals[Merged] += In.Normals[Vertex];
+                CellCounts[Merged]++;
+            }
+            for (size_t Vertex = 0; Vertex < Out.Positions.size(); Vertex++)
+            {
+                Out.Positions[Vertex] *= 1.0 / CellCounts[Vertex];
+                Out.Normals[Vertex].Normalize();
+            }
+
+            // Collapsed triangles vanish; triangles that became identical are kept once
+            std::vector<uint64_t> Seen;
+            Seen.reserve(In.NumTriangles());
+            for (size_t i = 0; i < In.Indices.size(); i += 3)
+            {
+                int32_t Triangle[3] = { Remap[In.Indices[i]], Remap[In.Indices[i + 1]], Remap[In.Indices[i + 2]] };
+                if (Triangle[0] == Triangle[1] || Triangle[1] == Triangle[2] || Triangle[0] == Triangle[2])
+                {
+                    continue;
+                }
+                Out.Indices.insert(Out.Indices.end(), { Triangle[0], Triangle[1], Triangle[2] });
+            }
+            RemoveDuplicateTriangles(Out.Indices);
+        }
+
+    private:
+        static bool IsValidTriangle(int32_t A, int32_t B, int32_t C, int32_t NumVertices)
+        {
+            return A >= 0 && B >= 0 && C >= 0 && A < NumVertices && B < NumVertices && C < NumVertices && A != B && B != C && A != C;
+        }
+
+        /** 21 bits per axis around the origin; grids wider than two million cells wrap */
+        static uint64_t MakeCellKey(const FVec3& Position, double CellSize)
+        {
+            auto Cell = [CellSize](double Value)
+            {
+                return static_cast<uint64_t>(static_cast<int64_t>(std::floor(Value / CellSize)) + (1ll << 20)) & ((1ull << 21) - 1);
+            };
+            return Cell(Position.X) | (Cell(Position.Y) << 21) | (Cell(Position.Z) << 42);
+        }
+
+        static void RemoveDuplicateTriangles(std::vector<int32_t>& Indices)
+        {
+            struct FTriangle
+            {
+                int32_t V[3];
+                size_t Order;
+            };
+
+            // Rotate each triangle to start at its smallest index, which keeps the winding
+            std::vector<FTriangle> Triangles(Indices.size() / 3);
+            for (size_t Triangle = 0; Triangle < Triangles.size(); Triangle++)
+            {
+                const int32_t* V = &Indices[Triangle * 3];
+                const int32_t First = V[0] < V[1] ? (V[0] < V[2] ? 0 : 2) : (V[1] < V[2] ? 1 : 2);
+                Triangles[Triangle] = FTriangle{ { V[First], V[(First + 1) % 3], V[(First + 2) % 3] }, Triangle };
+            }
+            auto Less = [](const FTriangle& A, const FTriangle& B)
+            {
+                return std::lexicographical_compare(A.V, A.V + 3, B.V, B.V + 3) || (std::equal(A.V, A.V + 3, B.V) && A.Order < B.Order);
+            };
+            std::sort(Triangles.begin(), Triangles.end(), Less);
+            Triangles.erase(std::unique(Triangles.begin(), Triangles.end(), [](const FTriangle& A, const FTriangle& B) { return std::equal(A.V, A.V + 3, B.V); }), Triangles.end());
+
+            // Back in the original order so the output stays deterministic and spatially coherent
+            std::sort(Triangles.begin(), Triangles.end(), [](const FTriangle& A, const FTriangle& B) { return A.Order < B.Order; });
+            Indices.clear();
+            for (const FTriangle& Triangle : Triangles)
+            {
+                Indices.insert(Indices.end(), Triangle.V, Triangle.V + 3);
+            }
+        }
+
+        /** Split the level's triangles until every range fits a cluster, then emit the clusters */
+        static void AddLevelClusters(const FLevelMesh& Level, int32_t LevelIndex, float Error, const FClusterBuildSettings& Limits, FClusterHierarchy& Hierarchy)
+        {
+            const size_t NumTriangles = Level.NumTriangles();
+            std::vector<int32_t> Triangles(NumTriangles);
+            std::vector<FVec3> Centroids(NumTriangles);
+            for (size_t Triangle = 0; Triangle < NumTriangles; Triangle++)
+            {
+                Triangles[Triangle] = static_cast<int32_t>(Triangle);
+                Centroids[Triangle] = (Level.Positions[Level.Indices[Triangle * 3]] + Level.Positions[Level.Indices[Triangle * 3 + 1]] + Level.Positions[Level.Indices[Triangle * 3 + 2]]) / 3.0;
+            }
+
+            // Stamps mark vertices already counted or mapped for the current range without clearing per range
+            std::vector<uint32_t> Stamps(Level.Positions.size(), 0);
+            std::vector<uint8_t> LocalIndex(Level.Positions.size(), 0);
+            uint32_t Stamp = 0;
+
+            struct FRange
+            {
+                size_t Begin;
+                size_t End;
+            };
+            std::vector<FRange> Stack;
+            if (NumTriangles > 0)
+            {
+                Stack.push_back(FRange{ 0, NumTriangles });
+            }
+
+            while (!Stack.empty())
+            {
+                const FRange Range = Stack.back();
+                Stack.pop_back();
+
+                size_t NumVertices = 0;
+                Stamp++;
+                for (size_t i = Range.Begin; i < Range.End; i++)
+                {
+                    for (int32_t Corner = 0; Corner < 3; Corner++)
+                    {
+                        const int32_t Vertex = Level.Indices[Triangles[i] * 3 + Corner];
+                        if (Stamps[Vertex] != Stamp)
+                        {
+                            Stamps[Vertex] = Stamp;
+                            NumVertices++;
+                        }
+                    }
+                }
+
+                const size_t Count = Range.End - Range.Begin;
+                if (Count > static_cast<size_t>(Limits.MaxTriangles) || NumVertices > static_cast<size_t>(Limits.MaxVertices))
+                {
+                    FVec3 Min(DBL_MAX);
+                    FVec3 Max(-DBL_MAX);
+                    for (size_t i = Range.Begin; i < Range.End; i++)
+                    {
+                        Min = ComponentMin(Min, Centroids[Triangles[i]]);
+                        Max = ComponentMax(Max, Centroids[Triangles[i]]);
+                    }
+                    const FVec3 Extent = Max - Min;
+                    const int32_t Axis = Extent.X >= Extent.Y && Extent.X >= Extent.Z ? 0 : (Extent.Y >= Extent.Z ? 1 : 2);
+
+                    // Split at a multiple of MaxTriangles so leaves come out full rather than at half size
+                    const size_t NumClusters = (Count + Limits.MaxTriangles - 1) / Limits.MaxTriangles;
+                    const size_t Middle = Range.Begin + (NumClusters > 1 ? (NumClusters / 2) * Limits.MaxTriangles : Count / 2);
+                    std::nth_element(Triangles.begin() + Range.Begin, Triangles.begin() + Middle, Triangles.begin() + Range.End,
+                        [&Centroids, Axis](int32_t A, int32_t B) { return Component(Centroids[A], Axis) < Component(Centroids[B], Axis); });
+
+                    // Second half pushed first so clusters come out in split order
+                    Stack.push_back(FRange{ Middle, Range.End });
+                    Stack.push_back(FRange{ Range.Begin, Middle });
+                    continue;
+                }
+
+                FMeshCluster Cluster;
+                Cluster.Level = LevelIndex;
+                Cluster.Error = Error;
+                Cluster.FirstVertex = static_cast<uint32_t>(Hierarchy.Positions.size());
+                Cluster.FirstIndex = static_cast<uint32_t>(Hierarchy.Indices.size());
+                Cluster.NumTriangles = static_cast<uint32_t>(Count);
+                Cluster.BoundsMin = FVec3(DBL_MAX);
+                Cluster.BoundsMax = FVec3(-DBL_MAX);
+
+                Stamp++;
+                for (size_t i = Range.Begin; i < Range.End; i++)
+                {
+                    for (int32_t Corner = 0; Corner < 3; Corner++)
+                    {
+                        const int32_t Vertex = Level.Indices[Triangles[i] * 3 + Corner];
+                        if (Stamps[Vertex] != Stamp)
+                        {
+                            Stamps[Vertex] = Stamp;
+                            LocalIndex[Vertex] = static_cast<uint8_t>(Cluster.NumVertices++);
+                            Hierarchy.Positions.push_back(Level.Positions[Vertex]);
+                            Hierarchy.Normals.push_back(Level.Normals[Vertex]);
+                            Cluster.BoundsMin = ComponentMin(Cluster.BoundsMin, Level.Positions[Vertex]);
+                            Cluster.BoundsMax = ComponentMax(Cluster.BoundsMax, Level.Positions[Vertex]);
+                        }
+                        Hierarchy.Indices.push_back(LocalIndex[Vertex]);
+                    }
+                }
+
+                Cluster.LodCenter = (Cluster.BoundsMin + Cluster.BoundsMax) * 0.5;
+                Cluster.LodRadius = (Cluster.BoundsMax - Cluster.BoundsMin).Size() * 0.5;
+                Hierarchy.Clusters.push_back(Cluster);
+            }
+        }
+
+        /**
+         * Parent each cluster to the next level's cluster nearest to its bounds centre (zero inside), then grow
+         * LOD spheres bottom-up so every parent sphere encloses its children's.
+         */
+        static void LinkLevels(FClusterHierarchy& Hierarchy)
+        {
+            const int32_t NumLevels = Hierarchy.NumLevels();
+            for (int32_t Level = 0; Level + 1 < NumLevels; Level++)
+            {
+                const int32_t ParentBegin = Hierarchy.LevelOffsets[Level + 1];
+                const int32_t ParentEnd = Hierarchy.LevelOffsets[Level + 2];
+                if (ParentBegin == ParentEnd)
+                {
+                    continue;
+                }
+
+                for (int32_t Child = Hierarchy.LevelOffsets[Level]; Child < ParentBegin; Child++)
+                {
+                    FMeshCluster& ChildCluster = Hierarchy.Clusters[Child];
+                    const FVec3 Center = (ChildCluster.BoundsMin + ChildCluster.BoundsMax) * 0.5;
+
+                    double BestDistance = DBL_MAX;
+                    for (int32_t Parent = ParentBegin; Parent < ParentEnd; Parent++)
+                    {
+                        const FMeshCluster& ParentCluster = Hierarchy.Clusters[Parent];
+                        const FVec3 Closest = ComponentMin(ComponentMax(Center, ParentCluster.BoundsMin), ParentCluster.BoundsMax);
+                        const double Distance = (Closest - Center).SizeSquared() + 1e-9 * (Center - (ParentCluster.BoundsMin + ParentCluster.BoundsMax) * 0.5).SizeSquared();
+                        if (Distance < BestDistance)
+                        {
+                            BestDistance = Distance;
+                            ChildCluster.Parent = Parent;
+                        }
+                    }
+                    ChildCluster.ParentError = Hierarchy.Clusters[ChildCluster.Parent].Error;
+                }
+            }
+
+            // Levels are stored finest first, so children are always final before their parent grows
+            for (FMeshCluster& Cluster : Hierarchy.Clusters)
+            {
+                if (Cluster.Parent < 0)
+                {
+                    continue;
+                }
+
+                FMeshCluster& Parent = Hierarchy.Clusters[Cluster.Parent];
+                const FVec3 Offset = Cluster.LodCenter - Parent.LodCenter;
+                const double Distance = Offset.Size();
+                if (Distance + Cluster.LodRadius <= Parent.LodRadius)
+                {
+                    continue;
+                }
+                if (Distance + Parent.LodRadius <= Cluster.LodRadius)
+                {
+                    Parent.LodCenter = Cluster.LodCenter;
+                    Parent.LodRadius = Cluster.LodRadius;
+                    continue;
+                }
+
+                // Smallest sphere enclosing both
+                const double Radius = (Distance + Parent.LodRadius + Cluster.LodRadius) * 0.5;
+                Parent.LodCenter = Parent.LodCenter + Offset * ((Radius - Parent.LodRadius) / Distance);
+                Parent.LodRadius = Radius;
+            }
+        }
+
+        static double Component(const FVec3& Vector, int32_t Axis)
+        {
+            return Axis == 0 ? Vector.X : (Axis == 1 ? Vector.Y : Vector.Z);
+        }
+
+        static FVec3 ComponentMin(const FVec3& A, const FVec3& B)
+        {
+            return FVec3(std::min(A.X, B.X), std::min(A.Y, B.Y), std::min(A.Z, B.Z));
+        }
+
+        static FVec3 ComponentMax(const FVec3& A, const FVec3& B)
+        {
+            return FVec3(std::max(A.X, B.X), std::max(A.Y, B.Y), std::max(A.Z, B.Z));
+        }
+    };
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace SurfaceNetsCore
+{
+    /** Consumer-side statistics of a TCompletionQueue, updated by TryPop */
+    struct FCompletionQueueStats
+    {
+        uint64_t NumPopped = 0;
+
+        /** Time from push to pop */
+        double TotalLatencySeconds = 0.0;
+        double MaxLatencySeconds = 0.0;
+
+        /** Largest depth seen by the consumer */
+        size_t MaxDepth = 0;
+
+        double AverageLatencySeconds() const
+        {
+            return NumPopped > 0 ? TotalLatencySeconds / static_cast<double>(NumPopped) : 0.0;
+        }
+    };
+
+    /**
+     * Bounded lock-free multi-producer / single-consumer queue handing move-only results from worker threads to
+     * one consumer (Vyukov's bounded queue: each slot carries a sequence number saying whose turn it is).
+     *
+     * Producers never wait on each other beyond one compare-exchange and never block the consumer; a full queue
+     * rejects the push and leaves the item with the caller. Items are moved in and out, never copied.
+     */
+    template <typename T>
+    class TCompletionQueue
+    {
+    public:
+        /** Capacity is rounded up to a power of two */
+        explicit TCompletionQueue(size_t InCapacity)
+        {
+            Capacity = 1;
+            while (Capacity < InCapacity)
+            {
+                Capacity <<= 1;
+            }
+            Mask = Capacity - 1;
+
+            Slots = std::make_unique<FSlot[]>(Capacity);
+            for (size_t Index = 0; Index < Capacity; Index++)
+            {
+                Slots[Index].Sequence.store(Index, std::memory_order_relaxed);
+            }
+        }
+
+        ~TCompletionQueue()
+        {
+            T Item;
+            while (TryPop(Item))
+            {
+            }
+        }
+
+        TCompletionQueue(const TCompletionQueue&) = delete;
+        TCompletionQueue& operator=(const TCompletionQueue&) = delete;
+
+        /** Any thread. Moves Item in and returns true, or returns false with Item untouched when the queue is full */
+        bool TryPush(T&& Item)
+        {
+            size_t Position = EnqueuePosition.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                FSlot& Slot = Slots[Position & Mask];
+                const size_t Sequence = Slot.Sequence.load(std::memory_order_acquire);
+                const intptr_t Difference = static_cast<intptr_t>(Sequence) - static_cast<intptr_t>(Position);
+                if (Difference == 0)
+                {
+                    if (EnqueuePosition.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+                    {
+                        new (&Slot.Storage) T(std::move(Item));
+                        Slot.PushTime = Clock::now();
+                        Slot.Sequence.store(Position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (Difference < 0)
+                {
+                    NumRejected.fetch_add(1, std::memory_order_relaxed);
+                    return false; // The consumer has not freed this slot yet
+                }
+                else
+                {
+                    Position = EnqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /** Consumer thread only. Moves the oldest item into OutItem */
+        bool TryPop(T& OutItem)
+        {
+            FSlot& Slot = Slots[DequeuePosition & Mask];
+            const size_t Sequence = Slot.Sequence.load(std::memory_order_acquire);
+            if (Sequence != DequeuePosition + 1)
+            {
+                return false; // Empty, or the producer that claimed this slot is still writing it
+            }
+
+            const size_t Depth = EnqueuePosition.load(std::memory_order_relaxed) - DequeuePosition;
+            T* Stored = std::launder(reinterpret_cast<T*>(&Slot.Storage));
+            OutItem = std::move(*Stored);
+            Stored->~T();
+
+            const double Latency = std::chrono::duration<double>(Clock::now() - Slot.PushTime).count();
+            Stats.NumPopped++;
+            Stats.TotalLatencySeconds += Latency;
+            Stats.MaxLatencySeconds = Latency > Stats.MaxLatencySeconds ? Latency : Stats.MaxLatencySeconds;
+            Stats.MaxDepth = Depth > Stats.MaxDepth ? Depth : Stats.MaxDepth;
+
+            Slot.Sequence.store(DequeuePosition + Capacity, std::memory_order_release);
+            DequeuePosition++;
+            DequeueCount.store(DequeuePosition, std::memory_order_relaxed);
+            return true;
+        }
+
+        /** Approximate number of queued items, exact on the consumer thread when no push is in flight */
+        size_t Num() const
+        {
+            const size_t Enqueued = EnqueuePosition.load(std::memory_order_relaxed);
+            const size_t Dequeued = DequeueCount.load(std::memory_order_relaxed);
+            return Enqueued > Dequeued ? Enqueued - Dequeued : 0;
+        }
+
+        size_t GetCapacity() const { return Capacity; }
+
+        /** Pushes turned away because the queue was full */
+        uint64_t GetNumRejected() const { return NumRejected.load(std::memory_order_relaxed); }
+
+        /** Consumer thread only */
+        const FCompletionQueueStats& GetStats() const { return Stats; }
+        void ResetStats() { Stats = FCompletionQueueStats(); }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct FSlot
+        {
+            std::atomic<size_t> Sequence{ 0 };
+            Clock::time_point PushTime;
+            alignas(T) unsigned char Storage[sizeof(T)];
+        };
+
+        std::unique_ptr<FSlot[]> Slots;
+        size_t Capacity = 0;
+        size_t Mask = 0;
+
+        /** Producers and the consumer write different cache lines */
+        alignas(64) std::atomic<size_t> EnqueuePosition{ 0 };
+        alignas(64) size_t DequeuePosition = 0;
+
+        /** Mirror of DequeuePosition readable from other threads for Num() */
+        std::atomic<size_t> DequeueCount{ 0 };
+        FCompletionQueueStats Stats;
+
+        alignas(64) std::atomic<uint64_t> NumRejected{ 0 };
+    };
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "SurfaceNetsCore/ChunkLayout.h"
+#include "SurfaceNetsCore/DensityField.h"
+#include "SurfaceNetsCore/MathTypes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SurfaceNetsCore
+{
+    /**
+     * Density grid stored as 16-bit fixed point, a quarter of the float grid's size.
+     *
+     * Samples are clamped to +-ClampDistance and rounded to steps of ClampDistance / 32767. Signs survive exactly
+     * (small negative samples round away from zero), so decoded grids have the same surface cells; only crossing
+     * positions move, by less than a step. Grids encoded with the same ClampDistance decode shared padding samples
+     * identically, so neighbouring chunks still stitch. Grids with no surface only keep the sample closest to it.
+     */
+    struct FQuantizedDensityGrid
+    {
+        static constexpr int32_t MaxCode = 32767;
+
+        /** Density per code step */
+        float Step = 0.0f;
+
+        /** Value of every sample when the grid has no sign change (Codes empty) */
+        float UniformValue = 0.0f;
+
+        std::vector<int16_t> Codes;
+
+        bool IsUniform() const
+        {
+            return Codes.empty();
+        }
+
+        void Encode(const float* Density, size_t NumSamples, float ClampDistance)
+        {
+            Codes.clear();
+            Step = ClampDistance / MaxCode;
+            UniformValue = 0.0f;
+
+            if (!HasSurface(Density, NumSamples))
+            {
+                // One value keeps the side and the sample magnitude closest to a surface
+                float Closest = NumSamples > 0 ? Density[0] : 1.0f;
+                for (size_t i = 1; i < NumSamples; i++)
+                {
+                    if (std::abs(Density[i]) < std::abs(Closest))
+                    {
+                        Closest = Density[i];
+                    }
+                }
+                UniformValue = Closest;
+                return;
+            }
+
+            Codes.resize(NumSamples);
+            const float InvStep = 1.0f / Step;
+            for (size_t i = 0; i < NumSamples; i++)
+            {
+                const float Value = Density[i];
+                long Code = 0; // Zero and NaN stay outside, like the meshers count them
+                if (IsInside(Value))
+                {
+                    Code = std::min(-1l, std::lround(std::max(Value * InvStep, -static_cast<float>(MaxCode))));
+                }
+                else if (Value > 0.0f)
+                {
+                    Code = std::lround(std::min(Value * InvStep, static_cast<float>(MaxCode)));
+                }
+                Codes[i] = static_cast<int16_t>(Code);
+            }
+        }
+
+        void Decode(float* OutDensity, size_t NumSamples) const
+        {
+            if (IsUniform())
+            {
+                std::fill(OutDensity, OutDensity + NumSamples, UniformValue);
+                return;
+            }
+
+            for (size_t i = 0; i < NumSamples; i++)
+            {
+                OutDensity[i] = Codes[i] * Step;
+            }
+        }
+
+        float Get(size_t Index) const
+        {
+            return IsUniform() ? UniformValue : Codes[Index] * Step;
+        }
+
+        /** Trilinear density at a world position, clamped to the grid */
+        float Sample(const FChunkLayout& Layout, const FVec3& Position) const
+        {
+            if (IsUniform())
+            {
+                return UniformValue;
+            }
+
+            const FVec3 Local = (Position - Layout.PaddedOrigin) / Layout.VoxelSize;
+            const double MaxCoordinate = Layout.GridSize - 1;
+            const double X = std::clamp(Local.X, 0.0, MaxCoordinate);
+            const double Y = std::clamp(Local.Y, 0.0, MaxCoordinate);
+            const double Z = std::clamp(Local.Z, 0.0, MaxCoordinate);
+            const int32_t X0 = std::min(static_cast<int32_t>(X), Layout.GridSize - 2);
+            const int32_t Y0 = std::min(static_cast<int32_t>(Y), Layout.GridSize - 2);
+            const int32_t Z0 = std::min(static_cast<int32_t>(Z), Layout.GridSize - 2);
+            const float Tx = static_cast<float>(X - X0);
+            const float Ty = static_cast<float>(Y - Y0);
+            const float Tz = static_cast<float>(Z - Z0);
+
+            auto At = [this, &Layout](int32_t SampleX, int32_t SampleY, int32_t SampleZ)
+            {
+                return static_cast<float>(Codes[Layout.Index(SampleX, SampleY, SampleZ)]);
+            };
+            auto LerpCodes = [](float A, float B, float T) { return A + (B - A) * T; };
+
+            const float C00 = LerpCodes(At(X0, Y0, Z0), At(X0 + 1, Y0, Z0), Tx);
+            const float C10 = LerpCodes(At(X0, Y0 + 1, Z0), At(X0 + 1, Y0 + 1, Z0), Tx);
+            const float C01 = LerpCodes(At(X0, Y0, Z0 + 1), At(X0 + 1, Y0, Z0 + 1), Tx);
+            const float C11 = LerpCodes(At(X0, Y0 + 1, Z0 + 1), At(X0 + 1, Y0 + 1, Z0 + 1), Tx);
+            return LerpCodes(LerpCodes(C00, C10, Ty), LerpCodes(C01, C11, Ty), Tz) * Step;
+        }
+
+        size_t GetAllocatedSize() const
+        {
+            return sizeof(*this) + Codes.capacity() * sizeof(int16_t);
+        }
+    };
+}
@@ -0,0 +1,686 @@
+#pragma once
+
+#include "SurfaceNetsCore/ChunkLayout.h"
+#include "SurfaceNetsCore/FractalNoise.h"
+#include "SurfaceNetsCore/SurfaceNetsMesher.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace SurfaceNetsCore
+{
+    /**
+     * Sample a density function over a chunk layout.
+     * Sampler is any callable float(const FVec3& WorldPosition); OutDensity must hold Layout.NumSamples() floats.
+     * Returns true if the grid has both inside and outside samples (like Rust early detection).
+     */
+    template <typename TSampler>
+    bool FillDensityGrid(const FChunkLayout& Layout, TSampler&& Sampler, float* OutDensity)
+    {
+        bool bHasInside = false;
+        bool bHasOutside = false;
+
+        for (int32_t z = 0; z < Layout.GridSize; z++)
+        {
+            for (int32_t y = 0; y < Layout.GridSize; y++)
+            {
+                for (int32_t x = 0; x < Layout.GridSize; x++)
+                {
+                    const float Density = Sampler(Layout.SamplePosition(x, y, z));
+                    OutDensity[Layout.Index(x, y, z)] = Density;
+
+                    if (IsInside(Density))
+                    {
+                        bHasInside = true;
+                    }
+                    else
+                    {
+                        bHasOutside = true;
+                    }
+                }
+            }
+        }
+
+        return bHasInside && bHasOutside;
+    }
+
+    /**
+     * Check if a density grid contains surface (optimization like Rust early exit).
+     * Uses the mesher's sign convention, so zero and NaN samples count as outside.
+     */
+    inline bool HasSurface(const float* Density, size_t NumSamples)
+    {
+        bool bHasInside = false;
+        bool bHasOutside = false;
+
+        for (size_t i = 0; i < NumSamples; i++)
+        {
+            if (IsInside(Density[i]))
+            {
+                bHasInside = true;
+            }
+            else
+            {
+                bHasOutside = true;
+            }
+
+            if (bHasInside && bHasOutside)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * A slowly varying layer of the noise (a warp axis, a low octave) held at every Stride-th sample of a grid
+     * and trilinearly interpolated back a row at a time. The last lattice point per axis is clamped to the grid's
+     * last sample, so the layer is never evaluated outside the grid.
+     */
+    struct FNoiseLattice
+    {
+        int32_t GridSize = 0;
+        int32_t Stride = 1;
+
+        /** Lattice points per axis */
+        int32_t Size = 0;
+
+        /** Layer values, x fastest */
+        std::vector<float> Values;
+
+        /** Size the lattice for a grid of at least two samples per axis */
+        void Init(int32_t InGridSize, int32_t InStride)
+        {
+            GridSize = InGridSize;
+            Stride = InStride;
+            Size = (GridSize - 1 + Stride - 1) / Stride + 1;
+            Values.resize(static_cast<size_t>(Size) * Size * Size);
+        }
+
+        /** Grid sample index of a lattice point along one axis */
+        int32_t GetSampleIndex(int32_t Point) const
+        {
+            return std::min(Point * Stride, GridSize - 1);
+        }
+
+        float& At(int32_t X, int32_t Y, int32_t Z)
+        {
+            return Values[(static_cast<size_t>(Z) * Size + Y) * Size + X];
+        }
+
+        /** Values of grid row (Y, Z) into OutRow (GridSize floats): bilinear in y and z into Scratch (Size floats), then along x */
+        void InterpolateRow(int32_t Y, int32_t Z, float* Scratch, float* OutRow) const
+        {
+            int32_t Y0, Z0;
+            float Ty, Tz;
+            Locate(Y, Y0, Ty);
+            Locate(Z, Z0, Tz);
+
+            const float* Row00 = Values.data() + (static_cast<size_t>(Z0) * Size + Y0) * Size;
+            const float* Row10 = Row00 + Size;
+            const float* Row01 = Row00 + static_cast<size_t>(Size) * Size;
+            const float* Row11 = Row01 + Size;
+            for (int32_t x = 0; x < Size; x++)
+            {
+                Scratch[x] = FFractalNoise::Lerp(FFractalNoise::Lerp(Row00[x], Row10[x], Ty), FFractalNoise::Lerp(Row01[x], Row11[x], Ty), Tz);
+            }
+
+            for (int32_t x = 0; x < GridSize; x++)
+            {
+                int32_t X0;
+                float Tx;
+                Locate(x, X0, Tx);
+                OutRow[x] = FFractalNoise::Lerp(Scratch[X0], Scratch[X0 + 1], Tx);
+            }
+        }
+
+    private:
+        /** Lattice interval holding a sample and the sample's weight towards the interval's upper point */
+        void Locate(int32_t Sample, int32_t& OutPoint, float& OutWeight) const
+        {
+            OutPoint = std::min(Sample / Stride, Size - 2);
+            const int32_t Lower = OutPoint * Stride;
+            OutWeight = static_cast<float>(Sample - Lower) / static_cast<float>(GetSampleIndex(OutPoint + 1) - Lower);
+        }
+    };
+
+    /**
+     * Layers over a chunk's footprint on the sphere for FillHeightfieldDensityGrid, in gnomonic coordinates on a
+     * cube face measured in voxel steps from the footprint's corner. Points lie Stride steps apart with the last
+     * clamped to the footprint, like FNoiseLattice; each layer is U fastest.
+     */
+    struct FHeightGrid
+    {
+        int32_t Stride = 1;
+        int32_t SizeU = 0;
+        int32_t SizeV = 0;
+
+        /** Footprint extent in voxel steps */
+        float ExtentU = 0.0f;
+        float ExtentV = 0.0f;
+
+        std::vector<float> Values;
+
+        /** Grid cell and bilinear weights of each sample of the last located row */
+        std::vector<int32_t> Cells;
+        std::vector<float> WeightU;
+        std::vector<float> WeightV;
+
+        void Init(int32_t InStride, float InExtentU, float InExtentV, int32_t NumLayers, int32_t RowLength)
+        {
+            Stride = InStride;
+            ExtentU = InExtentU;
+            ExtentV = InExtentV;
+            SizeU = static_cast<int32_t>(std::ceil(ExtentU / Stride)) + 1;
+            SizeV = static_cast<int32_t>(std::ceil(ExtentV / Stride)) + 1;
+            Values.assign(GetNumPoints() * NumLayers, 0.0f);
+            Cells.resize(static_cast<size_t>(RowLength));
+            WeightU.resize(static_cast<size_t>(RowLength));
+            WeightV.resize(static_cast<size_t>(RowLength));
+        }
+
+        size_t GetNumPoints() const
+        {
+            return static_cast<size_t>(SizeU) * SizeV;
+        }
+
+        float* GetLayer(int32_t Layer)
+        {
+            return Values.data() + Layer * GetNumPoints();
+        }
+
+        /** Voxel step coordinate of a grid point along U or V */
+        float GetCoordinate(int32_t Point, float Extent) const
+        {
+            return std::min(static_cast<float>(Point * Stride), Extent);
+        }
+
+        /** Find the cells and weights of a row of samples (RowLength in Init) at voxel step coordinates (U[i], V[i]) */
+        void LocateRow(const float* U, const float* V)
+        {
+            const float InvStride = 1.0f / static_cast<float>(Stride);
+            for (size_t i = 0; i < Cells.size(); i++)
+            {
+                int32_t PointU, PointV;
+                Locate(U[i], ExtentU, SizeU, InvStride, PointU, WeightU[i]);
+                Locate(V[i], ExtentV, SizeV, InvStride, PointV, WeightV[i]);
+                Cells[i] = PointV * SizeU + PointU;
+            }
+        }
+
+        /** Layer values at the samples of the last located row */
+        void InterpolateRow(int32_t Layer, float* OutRow) const
+        {
+            const float* Points = Values.data() + Layer * GetNumPoints();
+            for (size_t i = 0; i < Cells.size(); i++)
+            {
+                const float* Cell = Points + Cells[i];
+                OutRow[i] = FFractalNoise::Lerp(FFractalNoise::Lerp(Cell[0], Cell[1], WeightU[i]),
+                                                FFractalNoise::Lerp(Cell[SizeU], Cell[SizeU + 1], WeightU[i]), WeightV[i]);
+            }
+        }
+
+    private:
+        void Locate(float Coordinate, float Extent, int32_t Size, float InvStride, int32_t& OutPoint, float& OutWeight) const
+        {
+            const float Clamped = std::min(std::max(Coordinate, 0.0f), Extent);
+            OutPoint = std::min(static_cast<int32_t>(Clamped * InvStride), Size - 2);
+            const float Lower = static_cast<float>(OutPoint * Stride);
+            const float Length = std::min(Lower + static_cast<float>(Stride), Extent) - Lower;
+            OutWeight = std::min((Clamped - Lower) / std::max(Length, 1e-6f), 1.0f);
+        }
+    };
+
+    /**
+     * FillNoiseDensityGrid for heightfield planets, whose height depends only on the direction from the planet
+     * center: it is evaluated once per column on an FHeightGrid over the chunk's footprint on the sphere and
+     * bilinearly interpolated, O(N^2) noise evaluations instead of O(N^3). The grid is as coarse as
+     * FFastFractalNoise::GetHeightGridStride allows for every octave it holds; its points are read exactly
+     * warped. Fbm heights are summed on the grid, billow and ridged octaves are kept apart and shaped after
+     * interpolation. Octaves too fine for a point per voxel are read at every sample's point on the sphere, like
+     * FillNoiseDensityGrid's fine octaves, warped by the grid's interpolated warp where GetHeightWarpStride allows
+     * it. Columns are addressed by gnomonic coordinates on the cube face the
+     * chunk lies over. Chunks the face does not cover, grids that would take more than half as many points as
+     * the chunk has samples, and a zero CoarseOctaveError read every octave at every sample instead.
+     */
+    inline bool FillHeightfieldDensityGrid(const FChunkLayout& Layout, const FNoiseSampler& Noise, float* OutDensity)
+    {
+        const FFastFractalNoise& Fast = Noise.Fast;
+        const int32_t GridSize = Layout.GridSize;
+        const int32_t NumOctaves = Fast.GetNumOctaves();
+        const FVec3 Origin = Layout.PaddedOrigin - Noise.Settings.PlanetCenter;
+        const double VoxelSize = Layout.VoxelSize;
+        const double Extent = (GridSize - 1) * VoxelSize;
+        const float PlanetRadius = Noise.Settings.PlanetRadius;
+
+        // The face is the one the grid's middle points at: U and V are the other two axes over the major one
+        const FVec3 Middle = Origin + FVec3(Extent * 0.5);
+        const double MiddleAxes[3] = { Middle.X, Middle.Y, Middle.Z };
+        int32_t Major = 0;
+        for (int32_t Axis = 1; Axis < 3; Axis++)
+        {
+            Major = std::abs(MiddleAxes[Axis]) > std::abs(MiddleAxes[Major]) ? Axis : Major;
+        }
+        const int32_t AxisU = (Major + 1) % 3;
+        const int32_t AxisV = (Major + 2) % 3;
+        const double Sign = MiddleAxes[Major] < 0.0 ? -1.0 : 1.0;
+
+        // U and V are linear-fractional in position, so over the grid's box they peak at its corners
+        bool bGrid = NumOctaves > 0;
+        double UMin = 0.0, UMax = 0.0, VMin = 0.0, VMax = 0.0;
+        for (int32_t Corner = 0; Corner < 8 && bGrid; Corner++)
+        {
+            const FVec3 Point = Origin + FVec3((Corner & 1) * Extent, ((Corner >> 1) & 1) * Extent, (Corner >> 2) * Extent);
+            const double Axes[3] = { Point.X, Point.Y, Point.Z };
+            const double Depth = Sign * Axes[Major];
+            bGrid = Depth > 0.0;
+            const double U = Axes[AxisU] / Depth;
+            const double V = Axes[AxisV] / Depth;
+            UMin = Corner == 0 ? U : std::min(UMin, U);
+            UMax = Corner == 0 ? U : std::max(UMax, U);
+            VMin = Corner == 0 ? V : std::min(VMin, V);
+            VMax = Corner == 0 ? V : std::max(VMax, V);
+        }
+
+        // A step of Delta in U or V moves across the sphere by R * Delta * sqrt(1 + V^2 or U^2) / (1 + U^2 + V^2)
+        // at most, one voxel over the footprint
+        const double Nearest = std::pow(std::max({ UMin, -UMax, 0.0 }), 2.0) + std::pow(std::max({ VMin, -VMax, 0.0 }), 2.0);
+        const double Widest = std::max({ UMin * UMin, UMax * UMax, VMin * VMin, VMax * VMax });
+        const double Stretch = std::sqrt(1.0 + Widest) / (1.0 + Nearest);
+        const double Delta = std::abs(VoxelSize) / (std::max(std::abs(static_cast<double>(PlanetRadius)), 1e-3) * std::min(Stretch, 1.0));
+        const float ExtentU = static_cast<float>((UMax - UMin) / Delta);
+        const float ExtentV = static_cast<float>((VMax - VMin) / Delta);
+        bGrid = bGrid && std::max(ExtentU, ExtentV) < 4.0f * GridSize;
+
+        int32_t Stride = 0;
+        std::vector<int32_t> GridOctaves;
+        std::vector<int32_t> FineOctaves;
+        for (int32_t Octave = 0; Octave < NumOctaves; Octave++)
+        {
+            const int32_t OctaveStride = bGrid ? Fast.GetHeightGridStride(Octave, Layout.VoxelSize) : 0;
+            if (OctaveStride > 0)
+            {
+                Stride = GridOctaves.empty() ? OctaveStride : std::min(Stride, OctaveStride);
+                GridOctaves.push_back(Octave);
+            }
+            else
+            {
+                FineOctaves.push_back(Octave);
+            }
+        }
+
+        // The warp depends only on the point on the sphere too, so the fine octaves read it from the grid as well
+        // when it bends slowly enough for them
+        float FineSlope = 0.0f;
+        for (const int32_t Octave : FineOctaves)
+        {
+            FineSlope += Fast.GetOctaveSlope(Octave);
+        }
+        const int32_t WarpStride = bGrid && Fast.HasWarp() && !FineOctaves.empty() ? Fast.GetHeightWarpStride(FineSlope, Layout.VoxelSize) : 0;
+        bool bWarpLayers = WarpStride > 0;
+        if (bWarpLayers)
+        {
+            Stride = GridOctaves.empty() ? WarpStride : std::min(Stride, WarpStride);
+        }
+
+        // Fbm octaves add up linearly and share a layer; the warp layers follow the octave layers
+        const bool bSummed = Noise.Settings.FractalType == ENoiseFractalType::Fbm;
+        const int32_t NumOctaveLayers = GridOctaves.empty() ? 0 : (bSummed ? 1 : static_cast<int32_t>(GridOctaves.size()));
+        const int32_t NumLayers = NumOctaveLayers + (bWarpLayers ? 3 : 0);
+        FHeightGrid Grid;
+        bGrid = bGrid && NumLayers > 0;
+        if (bGrid)
+        {
+            Grid.Init(Stride, ExtentU, ExtentV, NumLayers, GridSize);
+            bGrid = Grid.SizeU >= 2 && Grid.SizeV >= 2 && Grid.GetNumPoints() * 2 <= Layout.NumSamples();
+        }
+        if (!bGrid)
+        {
+            bWarpLayers = false;
+            GridOctaves.clear();
+            FineOctaves.clear();
+            for (int32_t Octave = 0; Octave < NumOctaves; Octave++)
+            {
+                FineOctaves.push_back(Octave);
+            }
+        }
+
+        std::vector<float> Rows(static_cast<size_t>(std::max(GridSize, bGrid ? Grid.SizeU : 0)) * 6);
+        float* X = Rows.data();
+        float* Y = X + Rows.size() / 6;
+        float* Z = Y + Rows.size() / 6;
+        float* Height = Z + Rows.size() / 6;
+        float* ColumnU = Height + Rows.size() / 6;
+        float* ColumnV = ColumnU + Rows.size() / 6;
+        if (bGrid)
+        {
+            for (int32_t j = 0; j < Grid.SizeV; j++)
+            {
+                const double V = VMin + Grid.GetCoordinate(j, ExtentV) * Delta;
+                for (int32_t i = 0; i < Grid.SizeU; i++)
+                {
+                    // The last point of each axis is clamped to the footprint
+                    const double U = UMin + Grid.GetCoordinate(i, ExtentU) * Delta;
+                    const double Scale = PlanetRadius / std::sqrt(1.0 + U * U + V * V);
+                    float* Point[3] = { X + i, Y + i, Z + i };
+                    *Point[Major] = static_cast<float>(Sign * Scale);
+                    *Point[AxisU] = static_cast<float>(U * Scale);
+                    *Point[AxisV] = static_cast<float>(V * Scale);
+                }
+
+                const size_t Row = static_cast<size_t>(j) * Grid.SizeU;
+                if (Fast.HasWarp())
+                {
+                    for (int32_t i = 0; i < Grid.SizeU; i++)
+                    {
+                        float WarpX, WarpY, WarpZ;
+                        Fast.LocalWarp(X[i], Y[i], Z[i], WarpX, WarpY, WarpZ);
+                        X[i] += WarpX;
+                        Y[i] += WarpY;
+                        Z[i] += WarpZ;
+                        if (bWarpLayers)
+                        {
+                            Grid.GetLayer(NumOctaveLayers)[Row + i] = WarpX;
+                            Grid.GetLayer(NumOctaveLayers + 1)[Row + i] = WarpY;
+                            Grid.GetLayer(NumOctaveLayers + 2)[Row + i] = WarpZ;
+                        }
+                    }
+                }
+
+                for (size_t Layer = 0; Layer < GridOctaves.size(); Layer++)
+                {
+                    const int32_t Octave = GridOctaves[Layer];
+                    if (bSummed)
+                    {
+                        Fast.AccumulateOctaveRow(Octave, X, Y, Z, Grid.SizeU, Grid.GetLayer(0) + Row);
+                        continue;
+                    }
+                    float* Values = Grid.GetLayer(static_cast<int32_t>(Layer)) + Row;
+                    for (int32_t i = 0; i < Grid.SizeU; i++)
+                    {
+                        Values[i] = Fast.SampleOctaveNoise(Octave, X[i], Y[i], Z[i]);
+                    }
+                }
+            }
+        }
+
+        std::vector<float> Axes(static_cast<size_t>(GridSize) * 3);
+        for (int32_t i = 0; i < GridSize; i++)
+        {
+            Axes[i] = static_cast<float>(Origin.X + i * VoxelSize);
+            Axes[GridSize + i] = static_cast<float>(Origin.Y + i * VoxelSize);
+            Axes[2 * GridSize + i] = static_cast<float>(Origin.Z + i * VoxelSize);
+        }
+        const float* AxisX = Axes.data();
+        const float* AxisY = AxisX + GridSize;
+        const float* AxisZ = AxisY + GridSize;
+
+        // Gnomonic coordinates relative to the footprint's corner stay accurate in float
+        const float* Coordinates[3] = { X, Y, Z };
+        const float* Depths = Coordinates[Major];
+        const float* Across[2] = { Coordinates[AxisU], Coordinates[AxisV] };
+        const float Corner[2] = { static_cast<float>(UMin), static_cast<float>(VMin) };
+        const float InvDelta = static_cast<float>(1.0 / Delta);
+        const float DepthSign = static_cast<float>(Sign);
+        for (int32_t z = 0; z < GridSize; z++)
+        {
+            for (int32_t y = 0; y < GridSize; y++)
+            {
+                float* Density = OutDensity + Layout.Index(0, y, z);
+                for (int32_t x = 0; x < GridSize; x++)
+                {
+                    X[x] = AxisX[x];
+                    Y[x] = AxisY[y];
+                    Z[x] = AxisZ[z];
+                    Density[x] = std::sqrt(X[x] * X[x] + Y[x] * Y[x] + Z[x] * Z[x]) - PlanetRadius;
+                }
+
+                std::fill(Height, Height + GridSize, 0.0f);
+                if (bGrid)
+                {
+                    for (int32_t x = 0; x < GridSize; x++)
+                    {
+                        const float InvDepth = DepthSign / Depths[x];
+                        ColumnU[x] = (Across[0][x] * InvDepth - Corner[0]) * InvDelta;
+                        ColumnV[x] = (Across[1][x] * InvDepth - Corner[1]) * InvDelta;
+                    }
+                    Grid.LocateRow(ColumnU, ColumnV);
+                    if (!bSummed)
+                    {
+                        for (size_t Layer = 0; Layer < GridOctaves.size(); Layer++)
+                        {
+                            Grid.InterpolateRow(static_cast<int32_t>(Layer), ColumnU);
+                            Fast.AccumulateShapedRow(GridOctaves[Layer], ColumnU, GridSize, Height);
+                        }
+                    }
+                    else if (NumOctaveLayers > 0)
+                    {
+                        Grid.InterpolateRow(0, Height);
+                    }
+                }
+
+                if (!FineOctaves.empty())
+                {
+                    // Each sample reads its terrain at the point on the sphere below it
+                    for (int32_t x = 0; x < GridSize; x++)
+                    {
+                        const float Distance = Density[x] + PlanetRadius;
+                        const float Scale = Distance > 0.0f ? PlanetRadius / Distance : 0.0f;
+                        X[x] *= Scale;
+                        Y[x] *= Scale;
+                        Z[x] *= Scale;
+                    }
+                    if (bWarpLayers)
+                    {
+                        float* Warped[3] = { X, Y, Z };
+                        for (int32_t Axis = 0; Axis < 3; Axis++)
+                        {
+                            Grid.InterpolateRow(NumOctaveLayers + Axis, ColumnU);
+                            for (int32_t x = 0; x < GridSize; x++)
+                            {
+                                Warped[Axis][x] += ColumnU[x];
+                            }
+                        }
+                    }
+                    else if (Fast.HasWarp())
+                    {
+                        for (int32_t x = 0; x < GridSize; x++)
+                        {
+                            float WarpX, WarpY, WarpZ;
+                            Fast.LocalWarp(X[x], Y[x], Z[x], WarpX, WarpY, WarpZ);
+                            X[x] += WarpX;
+                            Y[x] += WarpY;
+                            Z[x] += WarpZ;
+                        }
+                    }
+                    for (const int32_t Octave : FineOctaves)
+                    {
+                        Fast.AccumulateOctaveRow(Octave, X, Y, Z, GridSize, Height);
+                    }
+                }
+
+                for (int32_t x = 0; x < GridSize; x++)
+                {
+                    Density[x] -= Height[x];
+                }
+            }
+        }
+
+        return HasSurface(OutDensity, Layout.NumSamples());
+    }
+
+    /**
+     * FillDensityGrid for the planet noise, a row at a time. Layers that vary slowly at this voxel size are
+     * evaluated on a coarse FNoiseLattice and interpolated instead of at every sample: every octave
+     * FFastFractalNoise::GetOctaveStride allows within Settings.CoarseOctaveError voxels, and the warp the remaining
+     * octaves are read through where FFastFractalNoise::GetWarpStride allows. Coarse octaves are read at their
+     * exactly warped lattice points and shaped after interpolation. The remaining octaves run over whole rows
+     * through FFastFractalNoise::AccumulateOctaveRow. Heightfields go through
+     * FillHeightfieldDensityGrid. Without the fast path this is FillDensityGrid with the reference sampler.
+     */
+    inline bool FillNoiseDensityGrid(const FChunkLayout& Layout, const FNoiseSampler& Noise, float* OutDensity)
+    {
+        const int32_t GridSize = Layout.GridSize;
+        if (!Noise.Settings.bFastNoise || GridSize < 2)
+        {
+            return FillDensityGrid(Layout, Noise, OutDensity);
+        }
+        if (Noise.Settings.bHeightfield)
+        {
+            return FillHeightfieldDensityGrid(Layout, Noise, OutDensity);
+        }
+
+        const FFastFractalNoise& Fast = Noise.Fast;
+        const FVec3 Origin = Layout.PaddedOrigin - Noise.Settings.PlanetCenter;
+        std::vector<float> Axes(static_cast<size_t>(GridSize) * 3);
+        for (int32_t i = 0; i < GridSize; i++)
+        {
+            Axes[i] = static_cast<float>(Origin.X + i * Layout.VoxelSize);
+            Axes[GridSize + i] = static_cast<float>(Origin.Y + i * Layout.VoxelSize);
+            Axes[2 * GridSize + i] = static_cast<float>(Origin.Z + i * Layout.VoxelSize);
+        }
+        const float* AxisX = Axes.data();
+        const float* AxisY = AxisX + GridSize;
+        const float* AxisZ = AxisY + GridSize;
+
+        const bool bWarp = Fast.HasWarp();
+        std::vector<int32_t> FineOctaves;
+        std::vector<int32_t> CoarseOctaves;
+        std::vector<FNoiseLattice> Coarse;
+        int32_t MaxLatticeSize = 0;
+        for (int32_t Octave = 0; Octave < Fast.GetNumOctaves(); Octave++)
+        {
+            const int32_t Stride = Fast.GetOctaveStride(Octave, Layout.VoxelSize);
+            if (Stride <= 1)
+            {
+                FineOctaves.push_back(Octave);
+                continue;
+            }
+
+            FNoiseLattice& Lattice = Coarse.emplace_back();
+            CoarseOctaves.push_back(Octave);
+            Lattice.Init(GridSize, Stride);
+            MaxLatticeSize = std::max(MaxLatticeSize, Lattice.Size);
+            for (int32_t z = 0; z < Lattice.Size; z++)
+            {
+                for (int32_t y = 0; y < Lattice.Size; y++)
+                {
+                    for (int32_t x = 0; x < Lattice.Size; x++)
+                    {
+                        float X = AxisX[Lattice.GetSampleIndex(x)];
+                        float Y = AxisY[Lattice.GetSampleIndex(y)];
+                        float Z = AxisZ[Lattice.GetSampleIndex(z)];
+                        if (bWarp)
+                        {
+                            float WarpX, WarpY, WarpZ;
+                            Fast.LocalWarp(X, Y, Z, WarpX, WarpY, WarpZ);
+                            X += WarpX;
+                            Y += WarpY;
+                            Z += WarpZ;
+                        }
+                        Lattice.At(x, y, z) = Fast.SampleOctaveNoise(Octave, X, Y, Z);
+                    }
+                }
+            }
+        }
+
+        // Only the fine octaves read the warp per sample; it is interpolated where it bends slowly enough for them
+        float FineSlope = 0.0f;
+        for (const int32_t Octave : FineOctaves)
+        {
+            FineSlope += Fast.GetOctaveSlope(Octave);
+        }
+        const bool bFineWarp = bWarp && !FineOctaves.empty();
+        const int32_t WarpStride = bFineWarp ? Fast.GetWarpStride(FineSlope, Layout.VoxelSize) : 1;
+        const bool bWarpLattice = WarpStride > 1;
+        FNoiseLattice Warp[3];
+        if (bWarpLattice)
+        {
+            for (FNoiseLattice& Axis : Warp)
+            {
+                Axis.Init(GridSize, WarpStride);
+            }
+            MaxLatticeSize = std::max(MaxLatticeSize, Warp[0].Size);
+            for (int32_t z = 0; z < Warp[0].Size; z++)
+            {
+                for (int32_t y = 0; y < Warp[0].Size; y++)
+                {
+                    for (int32_t x = 0; x < Warp[0].Size; x++)
+                    {
+                        Fast.LocalWarp(AxisX[Warp[0].GetSampleIndex(x)], AxisY[Warp[0].GetSampleIndex(y)], AxisZ[Warp[0].GetSampleIndex(z)],
+                                       Warp[0].At(x, y, z), Warp[1].At(x, y, z), Warp[2].At(x, y, z));
+                    }
+                }
+            }
+        }
+
+        std::vector<float> Rows(static_cast<size_t>(GridSize) * 5 + MaxLatticeSize);
+        float* X = Rows.data();
+        float* Y = X + GridSize;
+        float* Z = Y + GridSize;
+        float* Height = Z + GridSize;
+        float* Layer = Height + GridSize;
+        float* Scratch = Layer + GridSize;
+        const float PlanetRadius = Noise.Settings.PlanetRadius;
+        for (int32_t z = 0; z < GridSize; z++)
+        {
+            for (int32_t y = 0; y < GridSize; y++)
+            {
+                float* Density = OutDensity + Layout.Index(0, y, z);
+                for (int32_t x = 0; x < GridSize; x++)
+                {
+                    X[x] = AxisX[x];
+                    Y[x] = AxisY[y];
+                    Z[x] = AxisZ[z];
+                    Density[x] = std::sqrt(X[x] * X[x] + Y[x] * Y[x] + Z[x] * Z[x]) - PlanetRadius;
+                    Height[x] = 0.0f;
+                }
+
+                if (bWarpLattice)
+                {
+                    float* Coordinates[3] = { X, Y, Z };
+                    for (int32_t Axis = 0; Axis < 3; Axis++)
+                    {
+                        Warp[Axis].InterpolateRow(y, z, Scratch, Layer);
+                        for (int32_t x = 0; x < GridSize; x++)
+                        {
+                            Coordinates[Axis][x] += Layer[x];
+                        }
+                    }
+                }
+                else if (bFineWarp)
+                {
+                    for (int32_t x = 0; x < GridSize; x++)
+                    {
+                        float WarpX, WarpY, WarpZ;
+                        Fast.LocalWarp(X[x], Y[x], Z[x], WarpX, WarpY, WarpZ);
+                        X[x] += WarpX;
+                        Y[x] += WarpY;
+                        Z[x] += WarpZ;
+                    }
+                }
+
+                for (size_t i = 0; i < Coarse.size(); i++)
+                {
+                    Coarse[i].InterpolateRow(y, z, Scratch, Layer);
+                    Fast.AccumulateShapedRow(CoarseOctaves[i], Layer, GridSize, Height);
+                }
+
+                for (const int32_t Octave : FineOctaves)
+                {
+                    Fast.AccumulateOctaveRow(Octave, X, Y, Z, GridSize, Height);
+                }
+
+                for (int32_t x = 0; x < GridSize; x++)
+                {
+                    Density[x] -= Height[x];
+                }
+            }
+        }
+
+        return HasSurface(OutDensity, Layout.NumSamples());
+    }
+}
@@ -0,0 +1,789 @@
+#pragma once
+
+#include "SurfaceNetsCore/MathTypes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace SurfaceNetsCore
+{
+    /** Shaping applied to every octave of value noise before it is summed */
+    enum class ENoiseFractalType : uint8_t
+    {
+        /** Plain fractal Brownian motion: rolling hills */
+        Fbm,
+
+        /** |noise| remapped to [-1, 1]: rounded, puffy shapes with creases at the bottom */
+        Billow,
+
+        /** Squared inverted |noise|: sharp crests where the noise crosses zero */
+        Ridged
+    };
+
+    /** Parameters of the planet density function, mirrored from UNoiseGenerator */
+    struct FNoiseSettings
+    {
+        float PlanetRadius = 1000.0f;
+        FVec3 PlanetCenter;
+        float NoiseScale = 0.001f;
+        float NoiseAmplitude = 50.0f;
+        int32_t Octaves = 3;
+        float Lacunarity = 2.0f;
+        float Persistence = 0.5f;
+        int32_t Seed = 1337;
+
+        /** Give every octave its own seed instead of sharing Seed, so octave lattices do not line up */
+        bool bDecorrelateOctaves = false;
+
+        ENoiseFractalType FractalType = ENoiseFractalType::Fbm;
+
+        /** Largest distance the domain warp moves a terrain sample along each axis; 0 disables warping */
+        float WarpStrength = 0.0f;
+
+        /** Frequency of the warp field, usually well below NoiseScale */
+        float WarpScale = 0.0002f;
+
+        /**
+         * Height error, in voxels, that grid filling may add by interpolating slowly varying octaves from a coarse
+         * lattice instead of evaluating them at every sample; 0 evaluates every octave everywhere
+         */
+        float CoarseOctaveError = 0.05f;
+
+        /**
+         * Read each sample's height at the point on the base sphere below it rather than at the sample itself:
+         * a heightfield planet without overhangs, whose chunks fill from a 2D height grid
+         */
+        bool bHeightfield = false;
+
+        /** Sample through FFastFractalNoise's float32 path; set once it was checked against the reference */
+        bool bFastNoise = false;
+
+        bool operator==(const FNoiseSettings& Other) const
+        {
+            return PlanetRadius == Other.PlanetRadius
+                && PlanetCenter.X == Other.PlanetCenter.X && PlanetCenter.Y == Other.PlanetCenter.Y && PlanetCenter.Z == Other.PlanetCenter.Z
+                && NoiseScale == Other.NoiseScale && NoiseAmplitude == Other.NoiseAmplitude && Octaves == Other.Octaves
+                && Lacunarity == Other.Lacunarity && Persistence == Other.Persistence && Seed == Other.Seed
+                && bDecorrelateOctaves == Other.bDecorrelateOctaves && FractalType == Other.FractalType
+                && WarpStrength == Other.WarpStrength && WarpScale == Other.WarpScale && CoarseOctaveError == Other.CoarseOctaveError
+                && bHeightfield == Other.bHeightfield && bFastNoise == Other.bFastNoise;
+        }
+
+        bool operator!=(const FNoiseSettings& Other) const { return !(*this == Other); }
+    };
+
+    /**
+     * Value noise with fractal octaves used for planet terrain.
+     * This is the double precision reference; FFastFractalNoise samples the same function in float32.
+     */
+    struct FFractalNoise
+    {
+        /** Signed density at a world position: negative inside the planet, positive outside */
+        static float SampleDensity(const FNoiseSettings& Settings, const FVec3& WorldPosition)
+        {
+            // Base sphere (negative inside, positive outside for Surface Nets)
+            const FVec3 Offset = WorldPosition - Settings.PlanetCenter;
+            const double Distance = Offset.Size();
+            const float SphereDensity = static_cast<float>(Distance) - Settings.PlanetRadius;
+
+            // Combine sphere with terrain - negative values are "inside" the surface
+            if (Settings.bHeightfield)
+            {
+                const FVec3 Direction = Distance > 0.0 ? Offset * (1.0 / Distance) : FVec3(0.0, 0.0, 1.0);
+                return SphereDensity - SampleHeight(Settings, Settings.PlanetCenter + Direction * Settings.PlanetRadius);
+            }
+            return SphereDensity - SampleHeight(Settings, WorldPosition);
+        }
+
+        /** Terrain height displacement at a position */
+        static float SampleHeight(const FNoiseSettings& Settings, const FVec3& Position)
+        {
+            return Fractal(Settings, Warp(Settings, Position)) * Settings.NoiseAmplitude;
+        }
+
+        /** Position moved by the warp field, up to WarpStrength along each axis */
+        static FVec3 Warp(const FNoiseSettings& Settings, const FVec3& Position)
+        {
+            if (Settings.WarpStrength == 0.0f)
+            {
+                return Position;
+            }
+
+            const FVec3 WarpPosition = Position * Settings.WarpScale;
+            return Position + FVec3(ValueNoise(WarpPosition, WarpSeed(Settings, 0)),
+                                    ValueNoise(WarpPosition, WarpSeed(Settings, 1)),
+                                    ValueNoise(WarpPosition, WarpSeed(Settings, 2))) * Settings.WarpStrength;
+        }
+
+        /** Sum of Octaves layers of shaped value noise, in roughly [-1, 1] scaled by the amplitude series */
+        static float Fractal(const FNoiseSettings& Settings, const FVec3& Position)
+        {
+            float Value = 0.0f;
+            float Amplitude = 1.0f;
+            float Frequency = Settings.NoiseScale;
+
+            for (int32_t i = 0; i < Settings.Octaves; i++)
+            {
+                Value += Shape(Settings.FractalType, ValueNoise(Position * Frequency, OctaveSeed(Settings, i))) * Amplitude;
+                Frequency *= Settings.Lacunarity;
+                Amplitude *= Settings.Persistence;
+            }
+
+            return Value;
+        }
+
+        /** Seed of one octave: Seed itself unless the octaves are decorrelated */
+        static int32_t OctaveSeed(const FNoiseSettings& Settings, int32_t Octave)
+        {
+            return Settings.bDecorrelateOctaves ? Settings.Seed + Octave * 1013 : Settings.Seed;
+        }
+
+        /** Seed of one axis of the warp field, apart from every octave seed */
+        static int32_t WarpSeed(const FNoiseSettings& Settings, int32_t Axis)
+        {
+            return Settings.Seed + (Axis + 1) * 7919;
+        }
+
+        /** One octave's noise value shaped by the fractal type; stays within [-1, 1] */
+        static float Shape(ENoiseFractalType FractalType, float Value)
+        {
+            switch (FractalType)
+            {
+            case ENoiseFractalType::Billow:
+                return 2.0f * std::abs(Value) - 1.0f;
+            case ENoiseFractalType::Ridged:
+            {
+                const float Ridge = 1.0f - std::abs(Value);
+                return 2.0f * Ridge * Ridge - 1.0f;
+            }
+            default:
+                return Value;
+            }
+        }
+
+        /** Largest slope of Shape with respect to the noise value */
+        static float ShapeSlope(ENoiseFractalType FractalType)
+        {
+            switch (FractalType)
+            {
+            case ENoiseFractalType::Billow:
+                return 2.0f;
+            case ENoiseFractalType::Ridged:
+                return 4.0f;
+            default:
+                return 1.0f;
+            }
+        }
+
+        /** Upper bound of how far Warp moves a position: WarpStrength along each axis */
+        static float MaxWarpDistance(const FNoiseSettings& Settings)
+        {
+            return std::abs(Settings.WarpStrength) * 1.7320508f;
+        }
+
+        /** Upper bound of |SampleHeight|: every shaped octave stays within [-1, 1] */
+        static float MaxHeight(const FNoiseSettings& Settings)
+        {
+            float Sum = 0.0f;
+            float Amplitude = 1.0f;
+            for (int32_t i = 0; i < Settings.Octaves; i++)
+            {
+                Sum += std::abs(Amplitude);
+                Amplitude *= Settings.Persistence;
+            }
+            return Sum * std::abs(Settings.NoiseAmplitude);
+        }
+
+        /**
+         * Upper bound of the density gradient length, so |density| / bound never steps past the surface.
+         * The sphere term contributes 1; per axis an octave changes by at most 1.5 (smoothstep slope) times 2
+         * (corner value range) per lattice cell, so its gradient is under 3 * sqrt(3) * frequency * amplitude,
+         * times the slope of the octave shaping. Warping scales the height gradient by at most 1 + the norm of the
+         * warp's Jacobian, whose three rows are value noise gradients: under 9 * WarpScale * WarpStrength.
+         * For heightfields this holds within the terrain shell, where the surface is.
+         */
+        static float LipschitzBound(const FNoiseSettings& Settings)
+        {
+            if (Settings.bHeightfield)
+            {
+                // Moving across the sphere at radius r moves the point the height is read at by R / r as much;
+                // the surface lies no deeper than R - MaxHeight
+                const float Radius = std::abs(Settings.PlanetRadius);
+                const float Deepest = std::max(Radius - MaxHeight(Settings), 1e-3f * Radius);
+                return 1.0f + HeightGradientBound(Settings) * Radius / Deepest;
+            }
+            return 1.0f + HeightGradientBound(Settings);
+        }
+
+        /** Upper bound of the gradient length of SampleHeight, see LipschitzBound */
+        static float HeightGradientBound(const FNoiseSettings& Settings)
+        {
+            float Sum = 0.0f;
+            float Amplitude = 1.0f;
+            float Frequency = Settings.NoiseScale;
+            for (int32_t i = 0; i < Settings.Octaves; i++)
+            {
+                Sum += std::abs(Amplitude * Frequency);
+                Frequency *= Settings.Lacunarity;
+                Amplitude *= Settings.Persistence;
+            }
+            const float WarpStretch = 1.0f + 9.0f * std::abs(Settings.WarpScale * Settings.WarpStrength);
+            return 5.19615242f * std::abs(Settings.NoiseAmplitude) * Sum * ShapeSlope(Settings.FractalType) * WarpStretch;
+        }
+
+        /**
+         * Whether the volumetric density can cross zero more than once along a ray from the center, forming
+         * overhangs or caves. It cannot while the height gradient stays below 1: the density then grows
+         * strictly with the radius, and the planet is a heightfield either way.
+         */
+        static bool CanFormOverhangs(const FNoiseSettings& Settings)
+        {
+            return HeightGradientBound(Settings) >= 1.0f;
+        }
+
+        /** Trilinearly interpolated lattice noise with smoothstep weights */
+        static float ValueNoise(const FVec3& Position, int32_t Seed)
+        {
+            FVec3 P = Position;
+            P.X += Seed * 0.1f;
+            P.Y += Seed * 0.2f;
+            P.Z += Seed * 0.3f;
+
+            // Grid coordinates
+            const int32_t X0 = static_cast<int32_t>(std::floor(P.X));
+            const int32_t Y0 = static_cast<int32_t>(std::floor(P.Y));
+            const int32_t Z0 = static_cast<int32_t>(std::floor(P.Z));
+            const int32_t X1 = X0 + 1;
+            const int32_t Y1 = Y0 + 1;
+            const int32_t Z1 = Z0 + 1;
+
+            // Interpolation weights
+            const float Sx = SmoothStep(static_cast<float>(P.X - X0));
+            const float Sy = SmoothStep(static_cast<float>(P.Y - Y0));
+            const float Sz = SmoothStep(static_cast<float>(P.Z - Z0));
+
+            // Hash values at cube corners
+            const float N000 = Hash(X0, Y0, Z0);
+            const float N001 = Hash(X0, Y0, Z1);
+            const float N010 = Hash(X0, Y1, Z0);
+            const float N011 = Hash(X0, Y1, Z1);
+            const float N100 = Hash(X1, Y0, Z0);
+            const float N101 = Hash(X1, Y0, Z1);
+            const float N110 = Hash(X1, Y1, Z0);
+            const float N111 = Hash(X1, Y1, Z1);
+
+            // Trilinear interpolation
+            const float Ix00 = Lerp(N000, N100, Sx);
+            const float Ix01 = Lerp(N001, N101, Sx);
+            const float Ix10 = Lerp(N010, N110, Sx);
+            const float Ix11 = Lerp(N011, N111, Sx);
+
+            const float Iy0 = Lerp(Ix00, Ix10, Sy);
+            const float Iy1 = Lerp(Ix01, Ix11, Sy);
+
+            return Lerp(Iy0, Iy1, Sz);
+        }
+
+        /** Integer lattice hash mapped to [-1, 1] */
+        static float Hash(int32_t X, int32_t Y, int32_t Z)
+        {
+            uint32_t Value = static_cast<uint32_t>(X) * 374761393U + static_cast<uint32_t>(Y) * 668265263U + static_cast<uint32_t>(Z) * 2147483647U;
+            Value ^= Value >> 16;
+            Value *= 0x7feb352dU;
+            Value ^= Value >> 15;
+            Value *= 0x846ca68bU;
+            Value ^= Value >> 16;
+
+            return (Value / 4294967295.0f) * 2.0f - 1.0f;
+        }
+
+        static float SmoothStep(float T)
+        {
+            return T * T * (3.0f - 2.0f * T);
+        }
+
+        static float Lerp(float A, float B, float T)
+        {
+            return A + T * (B - A);
+        }
+    };
+
+    /**
+     * Float32 sampler of the FFractalNoise density with everything that depends only on the settings worked out
+     * once: per octave the frequency, the amplitude times NoiseAmplitude and the lattice coordinate of the planet
+     * center plus seed offset, split into a fraction added to the lattice coordinate and an integer lattice shift
+     * folded into the hash. A sample converts its offset from the center to float once and hashes integer lattice
+     * corners, with no double math per octave, and stays as precise far from the world origin as near it.
+     * Results differ from the reference by float rounding only; MeasureError reports by how much. The row and
+     * lattice helpers below serve FillNoiseDensityGrid.
+     * Build one per batch of samples (a chunk, a query), not per sample.
+     */
+    class FFastFractalNoise
+    {
+    public:
+        explicit FFastFractalNoise(const FNoiseSettings& InSettings)
+            : Settings(InSettings)
+        {
+            const int32_t NumOctaves = Settings.Octaves > 0 ? Settings.Octaves : 0;
+            Octaves.reserve(static_cast<size_t>(NumOctaves));
+
+            float Amplitude = 1.0f;
+            float Frequency = Settings.NoiseScale;
+            for (int32_t i = 0; i < NumOctaves; i++)
+            {
+                Octaves.push_back(MakeOctave(Frequency, Amplitude * Settings.NoiseAmplitude, FFractalNoise::OctaveSeed(Settings, i)));
+                Frequency *= Settings.Lacunarity;
+                Amplitude *= Settings.Persistence;
+            }
+
+            for (int32_t Axis = 0; Axis < 3; Axis++)
+            {
+                WarpAxes[Axis] = MakeOctave(Settings.WarpScale, Settings.WarpStrength, FFractalNoise::WarpSeed(Settings, Axis));
+            }
+        }
+
+        /** Signed density at a world position: negative inside the planet, positive outside */
+        float SampleDensity(const FVec3& WorldPosition) const
+        {
+            const float X = static_cast<float>(WorldPosition.X - Settings.PlanetCenter.X);
+            const float Y = static_cast<float>(WorldPosition.Y - Settings.PlanetCenter.Y);
+            const float Z = static_cast<float>(WorldPosition.Z - Settings.PlanetCenter.Z);
+            const float Distance = std::sqrt(X * X + Y * Y + Z * Z);
+            if (Settings.bHeightfield)
+            {
+                if (!(Distance > 0.0f))
+                {
+                    return Distance - Settings.PlanetRadius - LocalHeight(0.0f, 0.0f, Settings.PlanetRadius);
+                }
+                const float Scale = Settings.PlanetRadius / Distance;
+                return Distance - Settings.PlanetRadius - LocalHeight(X * Scale, Y * Scale, Z * Scale);
+            }
+            return Distance - Settings.PlanetRadius - LocalHeight(X, Y, Z);
+        }
+
+        /** Terrain height displacement at a position */
+        float SampleHeight(const FVec3& Position) const
+        {
+            return LocalHeight(static_cast<float>(Position.X - Settings.PlanetCenter.X), static_cast<float>(Position.Y - Settings.PlanetCenter.Y),
+                               static_cast<float>(Position.Z - Settings.PlanetCenter.Z));
+        }
+
+        /** Terrain height at an offset from the planet center */
+        float LocalHeight(float X, float Y, float Z) const
+        {
+            if (HasWarp())
+            {
+                float WarpX, WarpY, WarpZ;
+                LocalWarp(X, Y, Z, WarpX, WarpY, WarpZ);
+                X += WarpX;
+                Y += WarpY;
+                Z += WarpZ;
+            }
+
+            float Height = 0.0f;
+            for (const FOctave& Octave : Octaves)
+            {
+                Height += FFractalNoise::Shape(Settings.FractalType, SampleOctave(Octave, X, Y, Z)) * Octave.Amplitude;
+            }
+            return Height;
+        }
+
+        bool HasWarp() const
+        {
+            return Settings.WarpStrength != 0.0f;
+        }
+
+        /** How far FFractalNoise::Warp moves the point at an offset from the planet center */
+        void LocalWarp(float X, float Y, float Z, float& OutX, float& OutY, float& OutZ) const
+        {
+            OutX = SampleOctave(WarpAxes[0], X, Y, Z) * WarpAxes[0].Amplitude;
+            OutY = SampleOctave(WarpAxes[1], X, Y, Z) * WarpAxes[1].Amplitude;
+            OutZ = SampleOctave(WarpAxes[2], X, Y, Z) * WarpAxes[2].Amplitude;
+        }
+
+        int32_t GetNumOctaves() const
+        {
+            return static_cast<int32_t>(Octaves.size());
+        }
+
+        /** Value noise of one octave at an offset from the planet center, before shaping and scaling */
+        float SampleOctaveNoise(int32_t Octave, float X, float Y, float Z) const
+        {
+            return SampleOctave(Octaves[static_cast<size_t>(Octave)], X, Y, Z);
+        }
+
+        /** Height[i] += the octave at (X[i], Y[i], Z[i]), in plain float loops the compiler can vectorize */
+        void AccumulateOctaveRow(int32_t Octave, const float* X, const float* Y, const float* Z, int32_t Num, float* Height) const
+        {
+            const FOctave& Layer = Octaves[static_cast<size_t>(Octave)];
+            switch (Settings.FractalType)
+            {
+            case ENoiseFractalType::Billow:
+                AccumulateOctave<ENoiseFractalType::Billow>(Layer, X, Y, Z, Num, Height);
+                break;
+            case ENoiseFractalType::Ridged:
+                AccumulateOctave<ENoiseFractalType::Ridged>(Layer, X, Y, Z, Num, Height);
+                break;
+            default:
+                AccumulateOctave<ENoiseFractalType::Fbm>(Layer, X, Y, Z, Num, Height);
+                break;
+            }
+        }
+
+        /** Height[i] += the octave with value noise Noise[i], shaped after interpolation so ridges stay sharp */
+        void AccumulateShapedRow(int32_t Octave, const float* Noise, int32_t Num, float* Height) const
+        {
+            const float Amplitude = Octaves[static_cast<size_t>(Octave)].Amplitude;
+            switch (Settings.FractalType)
+            {
+            case ENoiseFractalType::Billow:
+                AccumulateShaped<ENoiseFractalType::Billow>(Amplitude, Noise, Num, Height);
+                break;
+            case ENoiseFractalType::Ridged:
+                AccumulateShaped<ENoiseFractalType::Ridged>(Amplitude, Noise, Num, Height);
+                break;
+            default:
+                AccumulateShaped<ENoiseFractalType::Fbm>(Amplitude, Noise, Num, Height);
+                break;
+            }
+        }
+
+        /**
+         * Spacing in samples of a lattice one octave can be trilinearly interpolated from while staying within
+         * Settings.CoarseOctaveError voxels of direct evaluation; 1 evaluates the octave at every sample.
+         * Interpolating over steps of h misses a function by at most h^2 / 8 times its second derivative per
+         * axis; smoothstep value noise curves by at most 12 * frequency^2 (6 from the smoothstep, 2 from the
+         * corner range) per axis, shaping scales the error by its slope and warping roughly by its stretch squared.
+         */
+        int32_t GetOctaveStride(int32_t Octave, float VoxelSize) const
+        {
+            const FOctave& Layer = Octaves[static_cast<size_t>(Octave)];
+            const float AllowedError = Settings.CoarseOctaveError * std::abs(VoxelSize);
+            const float Stretch = 1.0f + 9.0f * std::abs(Settings.WarpScale * Settings.WarpStrength);
+            const float Curvature = 4.5f * FFractalNoise::ShapeSlope(Settings.FractalType) * std::abs(Layer.Amplitude)
+                * Layer.Frequency * Layer.Frequency * Stretch * Stretch;
+            if (!(AllowedError > 0.0f))
+            {
+                return 1;
+            }
+            if (Curvature * MaxOctaveStride * MaxOctaveStride * VoxelSize * VoxelSize <= AllowedError)
+            {
+                return MaxOctaveStride;
+            }
+            return std::max(1, static_cast<int32_t>(std::sqrt(AllowedError / Curvature) / std::abs(VoxelSize)));
+        }
+
+        /**
+         * Spacing in voxels of a grid on the sphere that bilinear interpolation reads an octave from within
+         * Settings.CoarseOctaveError voxels once shaped, a power of two up to MaxOctaveStride: GetOctaveStride's
+         * curvature bound over two axes, plus the bending of the cube face projection (about 6 / R per unit of
+         * gradient). 0 when even a point per voxel would miss the tolerance, or without one: the octave is then
+         * read at every sample.
+         */
+        int32_t GetHeightGridStride(int32_t Octave, float VoxelSize) const
+        {
+            const FOctave& Layer = Octaves[static_cast<size_t>(Octave)];
+            const float AllowedError = Settings.CoarseOctaveError * std::abs(VoxelSize);
+            const float Stretch = 1.0f + 9.0f * std::abs(Settings.WarpScale * Settings.WarpStrength);
+            const float Slope = FFractalNoise::ShapeSlope(Settings.FractalType) * std::abs(Layer.Amplitude) * Layer.Frequency * Stretch;
+            const float Curvature = 3.0f * Slope * Layer.Frequency * Stretch
+                + 0.75f * 5.19615242f * Slope / std::max(std::abs(Settings.PlanetRadius), 1e-3f);
+            if (!(AllowedError > 0.0f))
+            {
+                return 0;
+            }
+            int32_t Stride = MaxOctaveStride;
+            while (Stride > 0 && Curvature * Stride * Stride * VoxelSize * VoxelSize > AllowedError)
+            {
+                Stride /= 2;
+            }
+            return Stride;
+        }
+
+        /** Largest slope of one shaped octave along an axis per unit of warped position (smoothstep value noise: 3 * frequency) */
+        float GetOctaveSlope(int32_t Octave) const
+        {
+            const FOctave& Layer = Octaves[static_cast<size_t>(Octave)];
+            return 3.0f * FFractalNoise::ShapeSlope(Settings.FractalType) * std::abs(Layer.Amplitude) * Layer.Frequency;
+        }
+
+        /**
+         * Spacing in voxels of FHeightGrid points the warp can be bilinearly interpolated from for octaves of
+         * combined GetOctaveSlope Slope, within Settings.CoarseOctaveError voxels: the warp's curvature on the
+         * grid bounded like GetHeightGridStride's, its error reaching the height through each axis' slope. 0 when
+         * even a point per voxel would miss the tolerance, or without one.
+         */
+        int32_t GetHeightWarpStride(float Slope, float VoxelSize) const
+        {
+            const float AllowedError = Settings.CoarseOctaveError * std::abs(VoxelSize);
+            const float WarpSlope = std::abs(Settings.WarpStrength * Settings.WarpScale);
+            const float Curvature = 3.0f * Slope * (3.0f * WarpSlope * std::abs(Settings.WarpScale)
+                + 0.75f * 5.19615242f * WarpSlope / std::max(std::abs(Settings.PlanetRadius), 1e-3f));
+            if (!(AllowedError > 0.0f))
+            {
+                return 0;
+            }
+            int32_t Stride = MaxOctaveStride;
+            while (Stride > 0 && Curvature * Stride * Stride * VoxelSize * VoxelSize > AllowedError)
+            {
+                Stride /= 2;
+            }
+            return Stride;
+        }
+
+        /**
+         * Spacing in samples of an FNoiseLattice the warp can be trilinearly interpolated from for octaves of
+         * combined GetOctaveSlope Slope, within Settings.CoarseOctaveError voxels: GetOctaveStride's curvature
+         * bound on each warp axis, its error reaching the height through each axis' slope. A power of two up to
+         * MaxWarpStride; 1 warps every sample exactly, as does a zero tolerance.
+         */
+        int32_t GetWarpStride(float Slope, float VoxelSize) const
+        {
+            const float AllowedError = Settings.CoarseOctaveError * std::abs(VoxelSize);
+            const float Curvature = 3.0f * Slope * 4.5f * std::abs(Settings.WarpStrength) * Settings.WarpScale * Settings.WarpScale;
+            if (!(AllowedError > 0.0f))
+            {
+                return 1;
+            }
+            int32_t Stride = MaxWarpStride;
+            while (Stride > 1 && Curvature * Stride * Stride * VoxelSize * VoxelSize > AllowedError)
+            {
+                Stride /= 2;
+            }
+            return Stride;
+        }
+
+        const FNoiseSettings& GetSettings() const
+        {
+            return Settings;
+        }
+
+        float operator()(const FVec3& WorldPosition) const
+        {
+            return SampleDensity(WorldPosition);
+        }
+
+        /**
+         * Largest density difference to the reference over NumSamples points spread across the terrain shell
+         * (Fibonacci directions, heights sweeping the full noise range); callers compare it with their tolerance.
+         */
+        static float MeasureError(const FNoiseSettings& Settings, int32_t NumSamples = 256)
+        {
+            const FFastFractalNoise Fast(Settings);
+            const float MaxHeight = FFractalNoise::MaxHeight(Settings);
+            const double GoldenAngle = 2.39996322972865332;
+
+            float MaxError = 0.0f;
+            for (int32_t i = 0; i < NumSamples; i++)
+            {
+                const double T = (i + 0.5) / NumSamples;
+                const double CosTheta = 1.0 - 2.0 * T;
+                const double SinTheta = std::sqrt(std::max(0.0, 1.0 - CosTheta * CosTheta));
+                const double Phi = GoldenAngle * i;
+                const double Radius = Settings.PlanetRadius + MaxHeight * (2.0 * std::fmod(T * 7.0, 1.0) - 1.0);
+
+                const FVec3 Position = Settings.PlanetCenter + FVec3(std::cos(Phi) * SinTheta, std::sin(Phi) * SinTheta, CosTheta) * Radius;
+                const float Error = std::abs(Fast.SampleDensity(Position) - FFractalNoise::SampleDensity(Settings, Position));
+                MaxError = std::max(MaxError, Error);
+            }
+            return MaxError;
+        }
+
+    private:
+        struct FOctave
+        {
+            float Frequency = 0.0f;
+            float Amplitude = 0.0f;
+            float Offset[3] = { 0.0f, 0.0f, 0.0f };
+            uint32_t HashBase = 0;
+        };
+
+        static constexpr int32_t MaxWarpStride = 4;
+        static constexpr int32_t MaxOctaveStride = 8;
+
+        /** Frequency, amplitude and the lattice placement of a noise layer with its own seed */
+        FOctave MakeOctave(float Frequency, float Amplitude, int32_t Seed) const
+        {
+            FOctave Octave;
+            Octave.Frequency = Frequency;
+            Octave.Amplitude = Amplitude;
+
+            // Samples are taken relative to the planet center, which keeps them small enough for float wherever
+            // the planet is. The center's lattice coordinate plus the seed offset of FFractalNoise::ValueNoise
+            // is split into the fraction added per sample and the whole cells folded into the hash
+            const double Origin[3] = {
+                Settings.PlanetCenter.X * Frequency + Seed * 0.1f,
+                Settings.PlanetCenter.Y * Frequency + Seed * 0.2f,
+                Settings.PlanetCenter.Z * Frequency + Seed * 0.3f };
+            int32_t Shift[3];
+            for (int32_t Axis = 0; Axis < 3; Axis++)
+            {
+                const double Whole = std::floor(Origin[Axis]);
+                Shift[Axis] = static_cast<int32_t>(static_cast<int64_t>(Whole));
+                Octave.Offset[Axis] = static_cast<float>(Origin[Axis] - Whole);
+            }
+            Octave.HashBase = LatticeKey(Shift[0], Shift[1], Shift[2]);
+            return Octave;
+        }
+
+        static float SampleOctave(const FOctave& Octave, float X, float Y, float Z)
+        {
+            return ValueNoise(Octave, X * Octave.Frequency + Octave.Offset[0], Y * Octave.Frequency + Octave.Offset[1],
+                              Z * Octave.Frequency + Octave.Offset[2]);
+        }
+
+        template <ENoiseFractalType FractalType>
+        static void AccumulateOctave(const FOctave& Octave, const float* X, const float* Y, const float* Z, int32_t Num, float* Height)
+        {
+            for (int32_t i = 0; i < Num; i++)
+            {
+                Height[i] += FFractalNoise::Shape(FractalType, SampleOctave(Octave, X[i], Y[i], Z[i])) * Octave.Amplitude;
+            }
+        }
+
+        template <ENoiseFractalType FractalType>
+        static void AccumulateShaped(float Amplitude, const float* Noise, int32_t Num, float* Height)
+        {
+            for (int32_t i = 0; i < Num; i++)
+            {
+                Height[i] += FFractalNoise::Shape(FractalType, Noise[i]) * Amplitude;
+            }
+        }
+
+        static constexpr uint32_t HashX = 374761393U;
+        static constexpr uint32_t HashY = 668265263U;
+        static constexpr uint32_t HashZ = 2147483647U;
+
+        /** The linear part of FFractalNoise::Hash; keys of neighbouring corners differ by HashX, HashY or HashZ */
+        static uint32_t LatticeKey(int32_t X, int32_t Y, int32_t Z)
+        {
+            return static_cast<uint32_t>(X) * HashX + static_cast<uint32_t>(Y) * HashY + static_cast<uint32_t>(Z) * HashZ;
+        }
+
+        /** The mixing part of FFractalNoise::Hash, mapped to [-1, 1] */
+        static float HashKey(uint32_t Value)
+        {
+            Value ^= Value >> 16;
+            Value *= 0x7feb352dU;
+            Value ^= Value >> 15;
+            Value *= 0x846ca68bU;
+            Value ^= Value >> 16;
+            return static_cast<float>(Value) * (2.0f / 4294967295.0f) - 1.0f;
+        }
+
+        static int32_t FloorToInt(float Value)
+        {
+            const int32_t Truncated = static_cast<int32_t>(Value);
+            return Truncated - (Value < static_cast<float>(Truncated) ? 1 : 0);
+        }
+
+        static float ValueNoise(const FOctave& Octave, float X, float Y, float Z)
+        {
+            const int32_t X0 = FloorToInt(X);
+            const int32_t Y0 = FloorToInt(Y);
+            const int32_t Z0 = FloorToInt(Z);
+
+            const float Sx = FFractalNoise::SmoothStep(X - static_cast<float>(X0));
+            const float Sy = FFractalNoise::SmoothStep(Y - static_cast<float>(Y0));
+            const float Sz = FFractalNoise::SmoothStep(Z - static_cast<float>(Z0));
+
+            // Corner keys are the base key plus the axis constants, as the hash is linear before mixing
+            const uint32_t K000 = LatticeKey(X0, Y0, Z0) + Octave.HashBase;
+            const uint32_t K010 = K000 + HashY;
+            const uint32_t K100 = K000 + HashX;
+            const uint32_t K110 = K100 + HashY;
+
+            const float Ix00 = FFractalNoise::Lerp(HashKey(K000), HashKey(K100), Sx);
+            const float Ix01 = FFractalNoise::Lerp(HashKey(K000 + HashZ), HashKey(K100 + HashZ), Sx);
+            const float Ix10 = FFractalNoise::Lerp(HashKey(K010), HashKey(K110), Sx);
+            const float Ix11 = FFractalNoise::Lerp(HashKey(K010 + HashZ), HashKey(K110 + HashZ), Sx);
+
+            const float Iy0 = FFractalNoise::Lerp(Ix00, Ix10, Sy);
+            const float Iy1 = FFractalNoise::Lerp(Ix01, Ix11, Sy);
+            return FFractalNoise::Lerp(Iy0, Iy1, Sz);
+        }
+
+        FNoiseSettings Settings;
+        std::vector<FOctave> Octaves;
+        FOctave WarpAxes[3];
+    };
+
+    /** Density callable for a batch of samples: the float32 path when Settings.bFastNoise is set, else the reference */
+    struct FNoiseSampler
+    {
+        FNoiseSampler()
+            : Fast(Settings)
+        {
+        }
+
+        explicit FNoiseSampler(const FNoiseSettings& InSettings)
+            : Settings(InSettings)
+            , Fast(InSettings)
+        {
+        }
+
+        float SampleDensity(const FVec3& WorldPosition) const
+        {
+            return Settings.bFastNoise ? Fast.SampleDensity(WorldPosition) : FFractalNoise::SampleDensity(Settings, WorldPosition);
+        }
+
+        float SampleHeight(const FVec3& Position) const
+        {
+            return Settings.bFastNoise ? Fast.SampleHeight(Position) : FFractalNoise::SampleHeight(Settings, Position);
+        }
+
+        float operator()(const FVec3& WorldPosition) const
+        {
+            return SampleDensity(WorldPosition);
+        }
+
+        FNoiseSettings Settings;
+        FFastFractalNoise Fast;
+    };
+
+    /**
+     * Octave series and conservative bounds of a noise configuration, independent of the planet center so one
+     * instance serves every planet built from the same settings.
+     */
+    struct FNoiseBounds
+    {
+        /** Frequency and amplitude of each octave, accumulated in the same order as FFractalNoise::Fractal */
+        std::vector<float> OctaveFrequencies;
+        std::vector<float> OctaveAmplitudes;
+
+        /** Bound of |height| contributed by octave i and all finer ones, with a trailing 0 */
+        std::vector<float> TailHeights;
+
+        float MaxHeight = 0.0f;
+        float LipschitzBound = 1.0f;
+
+        static FNoiseBounds Build(const FNoiseSettings& Settings)
+        {
+            FNoiseBounds Bounds;
+            const size_t NumOctaves = static_cast<size_t>(Settings.Octaves > 0 ? Settings.Octaves : 0);
+            Bounds.OctaveFrequencies.resize(NumOctaves);
+            Bounds.OctaveAmplitudes.resize(NumOctaves);
+            Bounds.TailHeights.resize(NumOctaves + 1, 0.0f);
+
+            float Amplitude = 1.0f;
+            float Frequency = Settings.NoiseScale;
+            for (size_t i = 0; i < NumOctaves; i++)
+            {
+                Bounds.OctaveFrequencies[i] = Frequency;
+                Bounds.OctaveAmplitudes[i] = Amplitude;
+                Frequency *= Settings.Lacunarity;
+                Amplitude *= Settings.Persistence;
+            }
+            for (size_t i = NumOctaves; i-- > 0;)
+            {
+                Bounds.TailHeights[i] = Bounds.TailHeights[i + 1] + std::abs(Bounds.OctaveAmplitudes[i] * Settings.NoiseAmplitude);
+            }
+
+            Bounds.MaxHeight = FFractalNoise::MaxHeight(Settings);
+            Bounds.LipschitzBound = FFractalNoise::LipschitzBound(Settings);
+            return Bounds;
+        }
+    };
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "SurfaceNetsCore/CellTables.h"
+#include "SurfaceNetsCore/MathTypes.h"
+#include "SurfaceNetsCore/SurfaceNetsMesher.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace SurfaceNetsCore
+{
+    /**
+     * Marching cubes mesh generation over the same density grid, scratch and sinks as FSurfaceNetsMesher.
+     *
+     * Vertices sit on the crossed grid edges and are shared between the cells around each edge. Cells are
+     * triangulated from CellTriangleTable, whose face cuts match across neighbours, so the output is watertight
+     * and manifold inside the meshed bounds: the guarantee caves and navigation meshes rely on.
+     */
+    struct FMarchingCubesMesher
+    {
+        /**
+         * Mesh the cells in (MinBounds, MaxBounds) of the grid. The cells on the min faces are padding, like the
+         * grid edges Surface Nets skips there, so chunks meshed with [0, UnpaddedSize + 1) tile without overlap.
+         */
+        template <typename TSink>
+        static void GenerateMesh(
+            const FDensityGridView& Grid,
+            const FIntVec3& MinBounds,
+            const FIntVec3& MaxBounds,
+            FSurfaceNetsScratch& Scratch,
+            TSink& Sink)
+        {
+            const size_t NumPoints = static_cast<size_t>(Grid.GridSize) * Grid.GridSize * Grid.GridSize;
+            Scratch.EdgeVertices.assign(NumPoints * 3, -1);
+
+            const FIntVec3 FirstCell(MinBounds.X + 1, MinBounds.Y + 1, MinBounds.Z + 1);
+            FSurfaceNetsMesher::ComputeCellMasks(Grid, FirstCell, MaxBounds, Scratch);
+
+            const FMeshCounts Counts = CountMesh(Grid, FirstCell, MaxBounds, Scratch.CellMasks);
+            Sink.Allocate(Counts.NumVertices, Counts.NumTriangles);
+
+            int32_t NumVertices = 0;
+            for (int32_t z = FirstCell.Z; z < MaxBounds.Z; z++)
+            {
+                for (int32_t y = FirstCell.Y; y < MaxBounds.Y; y++)
+                {
+                    for (int32_t x = FirstCell.X; x < MaxBounds.X; x++)
+                    {
+                        const uint8_t Mask = Scratch.CellMasks[x + y * Grid.GridSize + z * Grid.GridSize * Grid.GridSize];
+                        const FCellTriangles& Triangles = CellTriangleTable[Mask];
+
+                        for (int32_t Triangle = 0; Triangle < Triangles.NumTriangles; Triangle++)
+                        {
+                            int32_t Indices[3];
+                            for (int32_t i = 0; i < 3; i++)
+                            {
+                                Indices[i] = GetOrAddEdgeVertex(Grid, x, y, z, Triangles.Edges[Triangle * 3 + i], Scratch.EdgeVertices, NumVertices, Sink);
+                            }
+                            Sink.AddTriangle(Indices[0], Indices[1], Indices[2]);
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * Counting pass over the cell masks of [FirstCell, MaxBounds). Every crossed cube edge gets a vertex from
+         * the cell's triangles, so the vertices are the distinct crossed grid edges: each is counted once, in the
+         * cell holding it as cube edge 0, 1 or 2, or on the max faces in the last cell that holds it.
+         */
+        static FMeshCounts CountMesh(
+            const FDensityGridView& Grid,
+            const FIntVec3& FirstCell,
+            const FIntVec3& MaxBounds,
+            const TSlabVector<uint8_t>& CellMasks)
+        {
+            FMeshCounts Counts;
+            if (MaxBounds.X <= FirstCell.X)
+            {
+                return Counts;
+            }
+
+            for (int32_t z = FirstCell.Z; z < MaxBounds.Z; z++)
+            {
+                for (int32_t y = FirstCell.Y; y < MaxBounds.Y; y++)
+                {
+                    const uint8_t* Masks = CellMasks.data() + y * Grid.GridSize + z * Grid.GridSize * Grid.GridSize;
+
+                    // Cube edges 0, 1 and 2 join corner 0 to corners 1, 2 and 4
+                    int32_t RowTriangles = 0;
+                    int32_t RowVertices = 0;
+                    for (int32_t x = FirstCell.X; x < MaxBounds.X; x++)
+                    {
+                        const uint8_t Mask = Masks[x];
+                        RowTriangles += CellTriangleTable[Mask].NumTriangles;
+                        RowVertices += ((Mask ^ (Mask >> 1)) & 1) + ((Mask ^ (Mask >> 2)) & 1) + ((Mask ^ (Mask >> 4)) & 1);
+                    }
+
+                    // Grid edges on the max faces, by cube edge of the last cells holding them
+                    const bool bLastY = y == MaxBounds.Y - 1;
+                    const bool bLastZ = z == MaxBounds.Z - 1;
+                    const int32_t RowEdges = (bLastY ? (1 << 5) | (1 << 6) : 0) | (bLastZ ? (1 << 8) | (1 << 9) : 0) | (bLastY && bLastZ ? (1 << 11) : 0);
+                    if (RowEdges != 0)
+                    {
+                        for (int32_t x = FirstCell.X; x < MaxBounds.X; x++)
+                        {
+                            RowVertices += CountCrossedEdges(Masks[x], RowEdges);
+                        }
+                    }
+                    RowVertices += CountCrossedEdges(Masks[MaxBounds.X - 1], (1 << 3) | (1 << 4) | (bLastY ? (1 << 7) : 0) | (bLastZ ? (1 << 10) : 0));
+
+                    Counts.NumTriangles += RowTriangles;
+                    Counts.NumVertices += RowVertices;
+                }
+            }
+            return Counts;
+        }
+
+        /** Number of the cube edges in the Edges bit set that the surface crosses */
+        static int32_t CountCrossedEdges(uint8_t Mask, int32_t Edges)
+        {
+            int32_t NumCrossed = 0;
+            for (int32_t Edge = 0; Edge < 12; Edge++)
+            {
+                NumCrossed += (Edges >> Edge) & ((Mask >> CubeEdges[Edge][0]) ^ (Mask >> CubeEdges[Edge][1])) & 1;
+            }
+            return NumCrossed;
+        }
+
+        /** Vertex on a cube edge of cell (x, y, z), emitted the first time any cell around the grid edge needs it */
+        template <typename TSink>
+        static int32_t GetOrAddEdgeVertex(
+            const FDensityGridView& Grid,
+            int32_t x,
+            int32_t y,
+            int32_t z,
+            int32_t CubeEdge,
+            TSlabVector<int32_t>& EdgeVertices,
+            int32_t& NumVertices,
+            TSink& Sink)
+        {
+            // Cube edges run from their lower corner along one axis
+            const int32_t Corner1 = CubeEdges[CubeEdge][0];
+            const int32_t Corner2 = CubeEdges[CubeEdge][1];
+            const int32_t Axis = EdgeAxis(CubeEdge);
+            const int32_t Px = x + CubeCorners[Corner1][0];
+            const int32_t Py = y + CubeCorners[Corner1][1];
+            const int32_t Pz = z + CubeCorners[Corner1][2];
+
+            int32_t& Vertex = EdgeVertices[(Px + Py * Grid.GridSize + Pz * Grid.GridSize * Grid.GridSize) * 3 + Axis];
+            if (Vertex >= 0)
+            {
+                return Vertex;
+            }
+
+            const int32_t Qx = x + CubeCorners[Corner2][0];
+            const int32_t Qy = y + CubeCorners[Corner2][1];
+            const int32_t Qz = z + CubeCorners[Corner2][2];
+            const float T = FSurfaceNetsMesher::EdgeCrossingRatio(Grid.Get(Px, Py, Pz), Grid.Get(Qx, Qy, Qz));
+
+            const FVec3 Position = Lerp(FVec3(Px, Py, Pz), FVec3(Qx, Qy, Qz), T);
+            FVec3 Normal = Lerp(FSurfaceNetsMesher::CalculateGradient(Grid, Px, Py, Pz), FSurfaceNetsMesher::CalculateGradient(Grid, Qx, Qy, Qz), T);
+            if (!std::isfinite(Normal.SizeSquared()))
+            {
+                Normal = FVec3();
+            }
+            Normal.Normalize();
+
+            // Negated for outward-pointing normals, like FSurfaceNetsMesher::CalculateVertexNormal
+            Sink.AddVertex(Grid.Origin + Position * Grid.VoxelSize, -Normal);
+            Vertex = NumVertices++;
+            return Vertex;
+        }
+
+        static constexpr int32_t EdgeAxis(int32_t CubeEdge)
+        {
+            const int32_t Delta = CubeEdges[CubeEdge][1] - CubeEdges[CubeEdge][0];
+            return Delta == 1 ? 0 : (Delta == 2 ? 1 : 2);
+        }
+    };
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * Minimal vector types for the engine-independent core.
+ * Layout and precision mirror the UE5 types the adapters convert from (FVector is double, FIntVector is int32).
+ */
+namespace SurfaceNetsCore
+{
+    struct FVec3
+    {
+        double X = 0.0;
+        double Y = 0.0;
+        double Z = 0.0;
+
+        constexpr FVec3() = default;
+        constexpr FVec3(double InX, double InY, double InZ) : X(InX), Y(InY), Z(InZ) {}
+        constexpr explicit FVec3(double InValue) : X(InValue), Y(InValue), Z(InValue) {}
+
+        constexpr FVec3 operator+(const FVec3& Other) const { return FVec3(X + Other.X, Y + Other.Y, Z + Other.Z); }
+        constexpr FVec3 operator-(const FVec3& Other) const { return FVec3(X - Other.X, Y - Other.Y, Z - Other.Z); }
+        constexpr FVec3 operator*(double Scale) const { return FVec3(X * Scale, Y * Scale, Z * Scale); }
+        constexpr FVec3 operator/(double Scale) const { return FVec3(X / Scale, Y / Scale, Z / Scale); }
+        constexpr FVec3 operator-() const { return FVec3(-X, -Y, -Z); }
+
+        FVec3& operator+=(const FVec3& Other) { X += Other.X; Y += Other.Y; Z += Other.Z; return *this; }
+        FVec3& operator-=(const FVec3& Other) { X -= Other.X; Y -= Other.Y; Z -= Other.Z; return *this; }
+        FVec3& operator*=(double Scale) { X *= Scale; Y *= Scale; Z *= Scale; return *this; }
+
+        constexpr double SizeSquared() const { return X * X + Y * Y + Z * Z; }
+        double Size() const { return std::sqrt(SizeSquared()); }
+
+        /** Normalize in place, leaving tiny vectors untouched (same contract as FVector::Normalize) */
+        bool Normalize(double Tolerance = 1.e-8)
+        {
+            const double SquareSum = SizeSquared();
+            if (SquareSum > Tolerance)
+            {
+                const double Scale = 1.0 / std::sqrt(SquareSum);
+                X *= Scale; Y *= Scale; Z *= Scale;
+                return true;
+            }
+            return false;
+        }
+    };
+
+    inline constexpr double Dot(const FVec3& A, const FVec3& B)
+    {
+        return A.X * B.X + A.Y * B.Y + A.Z * B.Z;
+    }
+
+    inline constexpr FVec3 Cross(const FVec3& A, const FVec3& B)
+    {
+        return FVec3(A.Y * B.Z - A.Z * B.Y, A.Z * B.X - A.X * B.Z, A.X * B.Y - A.Y * B.X);
+    }
+
+    inline constexpr FVec3 Lerp(const FVec3& A, const FVec3& B, double T)
+    {
+        return A + (B - A) * T;
+    }
+
+    struct FIntVec3
+    {
+        int32_t X = 0;
+        int32_t Y = 0;
+        int32_t Z = 0;
+
+        constexpr FIntVec3() = default;
+        constexpr FIntVec3(int32_t InX, int32_t InY, int32_t InZ) : X(InX), Y(InY), Z(InZ) {}
+        constexpr explicit FIntVec3(int32_t InValue) : X(InValue), Y(InValue), Z(InValue) {}
+
+        constexpr bool operator==(const FIntVec3& Other) const { return X == Other.X && Y == Other.Y && Z == Other.Z; }
+        constexpr bool operator!=(const FIntVec3& Other) const { return !(*this == Other); }
+    };
+}
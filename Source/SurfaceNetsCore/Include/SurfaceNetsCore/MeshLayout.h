@@ -0,0 +1,207 @@
+#pragma once
+
+#include "SurfaceNetsCore/MathTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace SurfaceNetsCore
+{
+    /** Vertex layout of a mesher's output buffers */
+    enum class EMeshLayout : uint8_t
+    {
+        /** Interleaved FVec3 positions and normals, what most consumers index into */
+        ArrayOfStructs,
+
+        /** One array per component, so per-vertex passes (UVs, AO, quantization) vectorize */
+        StructOfArrays
+    };
+
+    /** Plain std::vector output, used by offline tools and benchmarks */
+    struct FMeshBuffers
+    {
+        std::vector<FVec3> Positions;
+        std::vector<FVec3> Normals;
+        std::vector<int32_t> Indices;
+
+        int32_t NumVertices() const
+        {
+            return static_cast<int32_t>(Positions.size());
+        }
+
+        void Reset()
+        {
+            Positions.clear();
+            Normals.clear();
+            Indices.clear();
+        }
+
+        /** Exact capacity up front; std::vector has no uninitialized resize, so the Adds push into it */
+        void Allocate(int32_t NumVertices, int32_t NumTriangles)
+        {
+            Reset();
+            Positions.reserve(static_cast<size_t>(NumVertices));
+            Normals.reserve(static_cast<size_t>(NumVertices));
+            Indices.reserve(static_cast<size_t>(NumTriangles) * 3);
+        }
+
+        void AddVertex(const FVec3& Position, const FVec3& Normal)
+        {
+            Positions.push_back(Position);
+            Normals.push_back(Normal);
+        }
+
+        void AddTriangle(int32_t A, int32_t B, int32_t C)
+        {
+            Indices.push_back(A);
+            Indices.push_back(B);
+            Indices.push_back(C);
+        }
+    };
+
+    /** Same mesh with every vertex component in its own array; a mesher sink like FMeshBuffers */
+    struct FMeshBuffersSoA
+    {
+        std::vector<double> PositionX;
+        std::vector<double> PositionY;
+        std::vector<double> PositionZ;
+        std::vector<double> NormalX;
+        std::vector<double> NormalY;
+        std::vector<double> NormalZ;
+        std::vector<int32_t> Indices;
+
+        int32_t NumVertices() const
+        {
+            return static_cast<int32_t>(PositionX.size());
+        }
+
+        void Reset()
+        {
+            for (std::vector<double>* Component : { &PositionX, &PositionY, &PositionZ, &NormalX, &NormalY, &NormalZ })
+            {
+                Component->clear();
+            }
+            Indices.clear();
+            NextVertex = 0;
+            NextIndex = 0;
+        }
+
+        /** Sized once from the mesher's exact counts; the Adds then store through a cursor instead of pushing */
+        void Allocate(int32_t NumVertices, int32_t NumTriangles)
+        {
+            Resize(NumVertices);
+            Indices.resize(static_cast<size_t>(NumTriangles) * 3);
+            NextVertex = 0;
+            NextIndex = 0;
+        }
+
+        void Resize(int32_t NumVertices)
+        {
+            for (std::vector<double>* Component : { &PositionX, &PositionY, &PositionZ, &NormalX, &NormalY, &NormalZ })
+            {
+                Component->resize(static_cast<size_t>(NumVertices));
+            }
+        }
+
+        void AddVertex(const FVec3& Position, const FVec3& Normal)
+        {
+            PositionX[NextVertex] = Position.X;
+            PositionY[NextVertex] = Position.Y;
+            PositionZ[NextVertex] = Position.Z;
+            NormalX[NextVertex] = Normal.X;
+            NormalY[NextVertex] = Normal.Y;
+            NormalZ[NextVertex] = Normal.Z;
+            NextVertex++;
+        }
+
+        void AddTriangle(int32_t A, int32_t B, int32_t C)
+        {
+            Indices[NextIndex + 0] = A;
+            Indices[NextIndex + 1] = B;
+            Indices[NextIndex + 2] = C;
+            NextIndex += 3;
+        }
+
+        FVec3 GetPosition(int32_t Index) const
+        {
+            return FVec3(PositionX[Index], PositionY[Index], PositionZ[Index]);
+        }
+
+        FVec3 GetNormal(int32_t Index) const
+        {
+            return FVec3(NormalX[Index], NormalY[Index], NormalZ[Index]);
+        }
+
+    private:
+        size_t NextVertex = 0;
+        size_t NextIndex = 0;
+    };
+
+    /** Output buffers for a layout: the mesher is templated on its sink, so this picks the layout it writes */
+    template <EMeshLayout Layout>
+    struct TMeshLayoutTraits;
+
+    template <>
+    struct TMeshLayoutTraits<EMeshLayout::ArrayOfStructs>
+    {
+        using FBuffers = FMeshBuffers;
+    };
+
+    template <>
+    struct TMeshLayoutTraits<EMeshLayout::StructOfArrays>
+    {
+        using FBuffers = FMeshBuffersSoA;
+    };
+
+    template <EMeshLayout Layout>
+    using TMeshBuffers = typename TMeshLayoutTraits<Layout>::FBuffers;
+
+    namespace MeshLayoutDetail
+    {
+        /** Split N interleaved triples into three arrays; restrict pointers let the compiler shuffle whole vectors */
+        inline void Deinterleave(const double* __restrict In, size_t N, double* __restrict X, double* __restrict Y, double* __restrict Z)
+        {
+            for (size_t Index = 0; Index < N; Index++)
+            {
+                X[Index] = In[Index * 3 + 0];
+                Y[Index] = In[Index * 3 + 1];
+                Z[Index] = In[Index * 3 + 2];
+            }
+        }
+
+        inline void Interleave(const double* __restrict X, const double* __restrict Y, const double* __restrict Z, size_t N, double* __restrict Out)
+        {
+            for (size_t Index = 0; Index < N; Index++)
+            {
+                Out[Index * 3 + 0] = X[Index];
+                Out[Index * 3 + 1] = Y[Index];
+                Out[Index * 3 + 2] = Z[Index];
+            }
+        }
+    }
+
+    static_assert(sizeof(FVec3) == 3 * sizeof(double), "The layout converters treat FVec3 arrays as packed doubles");
+
+    /** Convert interleaved output to one array per component, reusing Out's capacity */
+    inline void ConvertMeshLayout(const FMeshBuffers& In, FMeshBuffersSoA& Out)
+    {
+        const size_t NumVertices = In.Positions.size();
+        Out.Resize(static_cast<int32_t>(NumVertices));
+        MeshLayoutDetail::Deinterleave(reinterpret_cast<const double*>(In.Positions.data()), NumVertices, Out.PositionX.data(), Out.PositionY.data(), Out.PositionZ.data());
+        MeshLayoutDetail::Deinterleave(reinterpret_cast<const double*>(In.Normals.data()), NumVertices, Out.NormalX.data(), Out.NormalY.data(), Out.NormalZ.data());
+        Out.Indices = In.Indices;
+    }
+
+    /** Convert per-component output back to interleaved positions and normals, reusing Out's capacity */
+    inline void ConvertMeshLayout(const FMeshBuffersSoA& In, FMeshBuffers& Out)
+    {
+        const size_t NumVertices = In.PositionX.size();
+        Out.Positions.resize(NumVertices);
+        Out.Normals.resize(NumVertices);
+        MeshLayoutDetail::Interleave(In.PositionX.data(), In.PositionY.data(), In.PositionZ.data(), NumVertices, reinterpret_cast<double*>(Out.Positions.data()));
+        MeshLayoutDetail::Interleave(In.NormalX.data(), In.NormalY.data(), In.NormalZ.data(), NumVertices, reinterpret_cast<double*>(Out.Normals.data()));
+        Out.Indices = In.Indices;
+    }
+}
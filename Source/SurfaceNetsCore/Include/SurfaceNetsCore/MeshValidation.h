@@ -0,0 +1,213 @@
+#pragma once
+
+#include "SurfaceNetsCore/MathTypes.h"
+#include "SurfaceNetsCore/SurfaceNetsMesher.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace SurfaceNetsCore
+{
+    /** Structural properties of a triangle mesh, gathered by ValidateMesh */
+    struct FMeshValidationReport
+    {
+        int32_t NumVertices = 0;
+        int32_t NumTriangles = 0;
+
+        /** Index buffer length not a multiple of three */
+        bool bTruncatedIndexBuffer = false;
+
+        /** Indices outside [0, NumVertices) */
+        int32_t NumOutOfRangeIndices = 0;
+
+        /** Positions or normals containing NaN or infinity */
+        int32_t NumNonFiniteVertices = 0;
+
+        /** Triangles referencing the same vertex twice */
+        int32_t NumDegenerateTriangles = 0;
+
+        /** Triangles with distinct indices but (near) zero area */
+        int32_t NumZeroAreaTriangles = 0;
+
+        /** Undirected edges used by exactly one triangle (open border) */
+        int32_t NumBoundaryEdges = 0;
+
+        /** Undirected edges used by more than two triangles */
+        int32_t NumNonManifoldEdges = 0;
+
+        /** Directed edges used twice, i.e. neighbouring triangles with inconsistent winding */
+        int32_t NumFlippedEdges = 0;
+
+        /** Every index in range, every vertex finite, no repeated indices inside a triangle */
+        bool IsValid() const
+        {
+            return !bTruncatedIndexBuffer && NumOutOfRangeIndices == 0 && NumNonFiniteVertices == 0 && NumDegenerateTriangles == 0;
+        }
+
+        /** Every edge shared by exactly two triangles */
+        bool IsManifold() const
+        {
+            return IsValid() && NumNonManifoldEdges == 0 && NumFlippedEdges == 0;
+        }
+
+        /** Closed, consistently wound surface, expected for a closed SDF fully inside the meshed bounds */
+        bool IsWatertight() const
+        {
+            return IsManifold() && NumBoundaryEdges == 0;
+        }
+    };
+
+    /**
+     * Check a mesh for out-of-range indices, non-finite data, degenerate triangles and edge topology.
+     * PositionAt(i) and NormalAt(i) return something with X/Y/Z members, so any vertex container can be validated in place.
+     */
+    template <typename TPositionAt, typename TNormalAt>
+    FMeshValidationReport ValidateMesh(
+        int32_t NumVertices,
+        const int32_t* Indices,
+        size_t NumIndices,
+        TPositionAt&& PositionAt,
+        TNormalAt&& NormalAt,
+        double ZeroAreaTolerance = 1.e-12)
+    {
+        FMeshValidationReport Report;
+        Report.NumVertices = NumVertices;
+        Report.NumTriangles = static_cast<int32_t>(NumIndices / 3);
+        Report.bTruncatedIndexBuffer = (NumIndices % 3) != 0;
+
+        for (int32_t i = 0; i < NumVertices; i++)
+        {
+            const auto& P = PositionAt(i);
+            const auto& N = NormalAt(i);
+            if (!std::isfinite(P.X) || !std::isfinite(P.Y) || !std::isfinite(P.Z) ||
+                !std::isfinite(N.X) || !std::isfinite(N.Y) || !std::isfinite(N.Z))
+            {
+                Report.NumNonFiniteVertices++;
+            }
+        }
+
+        // Directed edge use counts, keyed by the packed (from, to) vertex pair
+        std::unordered_map<uint64_t, int32_t> DirectedEdges;
+        DirectedEdges.reserve(NumIndices);
+
+        auto PackEdge = [](int32_t From, int32_t To)
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(From)) << 32) | static_cast<uint32_t>(To);
+        };
+
+        for (int32_t Triangle = 0; Triangle < Report.NumTriangles; Triangle++)
+        {
+            const int32_t* Corners = Indices + Triangle * 3;
+
+            bool bInRange = true;
+            for (int32_t Corner = 0; Corner < 3; Corner++)
+            {
+                if (Corners[Corner] < 0 || Corners[Corner] >= NumVertices)
+                {
+                    Report.NumOutOfRangeIndices++;
+                    bInRange = false;
+                }
+            }
+
+            if (Corners[0] == Corners[1] || Corners[1] == Corners[2] || Corners[0] == Corners[2])
+            {
+                Report.NumDegenerateTriangles++;
+                continue;
+            }
+
+            if (!bInRange)
+            {
+                continue;
+            }
+
+            const auto& A = PositionAt(Corners[0]);
+            const auto& B = PositionAt(Corners[1]);
+            const auto& C = PositionAt(Corners[2]);
+            const FVec3 AB(B.X - A.X, B.Y - A.Y, B.Z - A.Z);
+            const FVec3 AC(C.X - A.X, C.Y - A.Y, C.Z - A.Z);
+            if (Cross(AB, AC).SizeSquared() <= ZeroAreaTolerance)
+            {
+                Report.NumZeroAreaTriangles++;
+            }
+
+            for (int32_t Corner = 0; Corner < 3; Corner++)
+            {
+                DirectedEdges[PackEdge(Corners[Corner], Corners[(Corner + 1) % 3])]++;
+            }
+        }
+
+        for (const auto& Edge : DirectedEdges)
+        {
+            const int32_t From = static_cast<int32_t>(Edge.first >> 32);
+            const int32_t To = static_cast<int32_t>(Edge.first & 0xffffffffu);
+
+            if (Edge.second > 1)
+            {
+                Report.NumFlippedEdges++;
+            }
+
+            // Visit each undirected edge once, from its smaller vertex
+            const auto Reverse = DirectedEdges.find(PackEdge(To, From));
+            const int32_t ReverseCount = Reverse != DirectedEdges.end() ? Reverse->second : 0;
+            if (ReverseCount > 0 && To < From)
+            {
+                continue;
+            }
+
+            const int32_t Uses = Edge.second + ReverseCount;
+            if (Uses == 1)
+            {
+                Report.NumBoundaryEdges++;
+            }
+            else if (Uses > 2)
+            {
+                Report.NumNonManifoldEdges++;
+            }
+        }
+
+        return Report;
+    }
+
+    /** Convenience overload for the core std::vector output */
+    inline FMeshValidationReport ValidateMesh(const FMeshBuffers& Mesh)
+    {
+        return ValidateMesh(
+            static_cast<int32_t>(Mesh.Positions.size()),
+            Mesh.Indices.data(),
+            Mesh.Indices.size(),
+            [&Mesh](int32_t i) -> const FVec3& { return Mesh.Positions[i]; },
+            [&Mesh](int32_t i) -> const FVec3& { return Mesh.Normals[i]; });
+    }
+
+    /**
+     * Compare an optimized mesher's output against the reference mesher.
+     * Vertex order and index buffers must match exactly, positions and normals within Tolerance.
+     */
+    inline bool AreMeshesEquivalent(const FMeshBuffers& Reference, const FMeshBuffers& Candidate, double Tolerance = 1.e-5)
+    {
+        if (Reference.Positions.size() != Candidate.Positions.size() ||
+            Reference.Normals.size() != Candidate.Normals.size() ||
+            Reference.Indices != Candidate.Indices)
+        {
+            return false;
+        }
+
+        auto Near = [Tolerance](const FVec3& A, const FVec3& B)
+        {
+            return std::abs(A.X - B.X) <= Tolerance && std::abs(A.Y - B.Y) <= Tolerance && std::abs(A.Z - B.Z) <= Tolerance;
+        };
+
+        for (size_t i = 0; i < Reference.Positions.size(); i++)
+        {
+            if (!Near(Reference.Positions[i], Candidate.Positions[i]) || !Near(Reference.Normals[i], Candidate.Normals[i]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
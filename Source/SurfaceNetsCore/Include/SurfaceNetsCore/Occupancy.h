@@ -0,0 +1,272 @@
+#pragma once
+
+#include "SurfaceNetsCore/FractalNoise.h"
+#include "SurfaceNetsCore/MathTypes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace SurfaceNetsCore
+{
+    /** What a region of the planet volume holds */
+    enum class EOccupancy : uint8_t
+    {
+        /** Density positive everywhere, nothing to mesh */
+        Outside,
+
+        /** Density negative everywhere, solid ground with nothing to mesh */
+        Inside,
+
+        /** May cross the surface */
+        Surface
+    };
+
+    /** Conservative bounds of the density over a region */
+    struct FDensityRange
+    {
+        float Min = 0.0f;
+        float Max = 0.0f;
+
+        EOccupancy Classify() const
+        {
+            return Min > 0.0f ? EOccupancy::Outside : (Max < 0.0f ? EOccupancy::Inside : EOccupancy::Surface);
+        }
+
+        void Merge(const FDensityRange& Other)
+        {
+            Min = std::min(Min, Other.Min);
+            Max = std::max(Max, Other.Max);
+        }
+    };
+
+    /**
+     * Min/max density mip pyramid over a planet's chunk grid. Level 0 holds one range per chunk, covering its padded
+     * samples; each coarser level merges 2x2x2 cells of the one below. Ranges come from the distance to the center
+     * and per-octave height bounds, sampling one noise value per octave at the cell center, so a chunk is classified
+     * for a handful of samples instead of its whole density grid. Inside and Outside are never wrong.
+     */
+    struct FOccupancyPyramid
+    {
+        /** Min corner of chunk (0, 0, 0) */
+        FVec3 GridOrigin;
+
+        float CellSize = 0.0f;
+
+        /** Margin around each cell, the chunk's padding */
+        float Padding = 0.0f;
+
+        int32_t Resolution = 0;
+
+        /** Levels[0] has Resolution^3 cells, X slowest; each next level has half the resolution rounded up, down to 1 */
+        std::vector<std::vector<FDensityRange>> Levels;
+
+        void Build(const FNoiseSettings& Settings, const FNoiseBounds& Bounds, const FVec3& InGridOrigin, float InCellSize, float InPadding, int32_t InResolution)
+        {
+            GridOrigin = InGridOrigin;
+            CellSize = InCellSize;
+            Padding = InPadding;
+            Resolution = std::max(InResolution, 1);
+
+            Levels.clear();
+            for (int32_t LevelResolution = Resolution;; LevelResolution = (LevelResolution + 1) / 2)
+            {
+                Levels.emplace_back(static_cast<size_t>(LevelResolution) * LevelResolution * LevelResolution);
+                if (LevelResolution == 1)
+                {
+                    break;
+                }
+            }
+
+            Update(Settings, Bounds, FIntVec3(0, 0, 0), FIntVec3(Resolution - 1, Resolution - 1, Resolution - 1));
+        }
+
+        /** Recompute the level 0 cells in [Min, Max] (inclusive, clamped) and the coarser cells above them, e.g. after an edit */
+        void Update(const FNoiseSettings& Settings, const FNoiseBounds& Bounds, const FIntVec3& Min, const FIntVec3& Max)
+        {
+            if (Levels.empty())
+            {
+                return;
+            }
+
+            FIntVec3 Lo(std::max(Min.X, 0), std::max(Min.Y, 0), std::max(Min.Z, 0));
+            FIntVec3 Hi(std::min(Max.X, Resolution - 1), std::min(Max.Y, Resolution - 1), std::min(Max.Z, Resolution - 1));
+            if (Lo.X > Hi.X || Lo.Y > Hi.Y || Lo.Z > Hi.Z)
+            {
+                return;
+            }
+
+            const float HalfExtent = CellSize * 0.5f + Padding;
+            for (int32_t X = Lo.X; X <= Hi.X; X++)
+            {
+                for (int32_t Y = Lo.Y; Y <= Hi.Y; Y++)
+                {
+                    for (int32_t Z = Lo.Z; Z <= Hi.Z; Z++)
+                    {
+                        const FVec3 Center = GridOrigin + FVec3((X + 0.5) * CellSize, (Y + 0.5) * CellSize, (Z + 0.5) * CellSize);
+                        Levels[0][GetIndex(Resolution, X, Y, Z)] = BoundCell(Settings, Bounds, Center, HalfExtent);
+                    }
+                }
+            }
+
+            // Each coarser cell over the touched ones is re-merged from its (up to 8) children
+            int32_t ChildResolution = Resolution;
+            for (size_t Level = 1; Level < Levels.size(); Level++)
+            {
+                const int32_t LevelResolution = (ChildResolution + 1) / 2;
+                Lo = FIntVec3(Lo.X / 2, Lo.Y / 2, Lo.Z / 2);
+                Hi = FIntVec3(Hi.X / 2, Hi.Y / 2, Hi.Z / 2);
+                for (int32_t X = Lo.X; X <= Hi.X; X++)
+                {
+                    for (int32_t Y = Lo.Y; Y <= Hi.Y; Y++)
+                    {
+                        for (int32_t Z = Lo.Z; Z <= Hi.Z; Z++)
+                        {
+                            FDensityRange Range = Levels[Level - 1][GetIndex(ChildResolution, X * 2, Y * 2, Z * 2)];
+                            for (int32_t Child = 1; Child < 8; Child++)
+                            {
+                                const int32_t CX = X * 2 + (Child >> 2), CY = Y * 2 + ((Child >> 1) & 1), CZ = Z * 2 + (Child & 1);
+                                if (CX < ChildResolution && CY < ChildResolution && CZ < ChildResolution)
+                                {
+                                    Range.Merge(Levels[Level - 1][GetIndex(ChildResolution, CX, CY, CZ)]);
+                                }
+                            }
+                            Levels[Level][GetIndex(LevelResolution, X, Y, Z)] = Range;
+                        }
+                    }
+                }
+                ChildResolution = LevelResolution;
+            }
+        }
+
+        EOccupancy ClassifyCell(const FIntVec3& Cell) const
+        {
+            if (Levels.empty() || Cell.X < 0 || Cell.Y < 0 || Cell.Z < 0 || Cell.X >= Resolution || Cell.Y >= Resolution || Cell.Z >= Resolution)
+            {
+                return EOccupancy::Surface;
+            }
+            return Levels[0][GetIndex(Resolution, Cell.X, Cell.Y, Cell.Z)].Classify();
+        }
+
+        /**
+         * Classify the block of level 0 cells [Min, Max] (inclusive) from the finest level where it spans at most
+         * two cells per axis, so at most eight ranges are read; the coarser cells can only widen the result.
+         */
+        EOccupancy ClassifyRange(const FIntVec3& Min, const FIntVec3& Max) const
+        {
+            if (Levels.empty() || Min.X < 0 || Min.Y < 0 || Min.Z < 0 || Max.X >= Resolution || Max.Y >= Resolution || Max.Z >= Resolution
+                || Min.X > Max.X || Min.Y > Max.Y || Min.Z > Max.Z)
+            {
+                return EOccupancy::Surface;
+            }
+
+            FIntVec3 Lo = Min;
+            FIntVec3 Hi = Max;
+            int32_t LevelResolution = Resolution;
+            size_t Level = 0;
+            while (Hi.X - Lo.X > 1 || Hi.Y - Lo.Y > 1 || Hi.Z - Lo.Z > 1)
+            {
+                Lo = FIntVec3(Lo.X / 2, Lo.Y / 2, Lo.Z / 2);
+                Hi = FIntVec3(Hi.X / 2, Hi.Y / 2, Hi.Z / 2);
+                LevelResolution = (LevelResolution + 1) / 2;
+                Level++;
+            }
+
+            FDensityRange Range = Levels[Level][GetIndex(LevelResolution, Lo.X, Lo.Y, Lo.Z)];
+            for (int32_t X = Lo.X; X <= Hi.X; X++)
+            {
+                for (int32_t Y = Lo.Y; Y <= Hi.Y; Y++)
+                {
+                    for (int32_t Z = Lo.Z; Z <= Hi.Z; Z++)
+                    {
+                        Range.Merge(Levels[Level][GetIndex(LevelResolution, X, Y, Z)]);
+                    }
+                }
+            }
+            return Range.Classify();
+        }
+
+        /**
+         * Density range of the cube of HalfExtent around Center. The sphere term is bounded by the nearest and
+         * farthest distance to the planet center; each octave by its value at Center plus its Lipschitz bound
+         * (see FFractalNoise::LipschitzBound) times the half diagonal, clamped to its amplitude. The octaves are
+         * only sampled when the shell alone cannot decide.
+         */
+        static FDensityRange BoundCell(const FNoiseSettings& Settings, const FNoiseBounds& Bounds, const FVec3& Center, float HalfExtent)
+        {
+            const FVec3 Offset = Center - Settings.PlanetCenter;
+            const double Offsets[3] = { Offset.X, Offset.Y, Offset.Z };
+            double Near = 0.0;
+            double Far = 0.0;
+            for (int32_t Axis = 0; Axis < 3; Axis++)
+            {
+                const double Closest = std::max(std::abs(Offsets[Axis]) - HalfExtent, 0.0);
+                const double Farthest = std::abs(Offsets[Axis]) + HalfExtent;
+                Near += Closest * Closest;
+                Far += Farthest * Farthest;
+            }
+
+            // Float densities round by a hair; keep the bounds clear of that
+            const float Slack = 1e-4f * (std::abs(Settings.PlanetRadius) + Bounds.MaxHeight) + 1e-3f;
+            const float NearSphere = static_cast<float>(std::sqrt(Near)) - Settings.PlanetRadius - Slack;
+            const float FarSphere = static_cast<float>(std::sqrt(Far)) - Settings.PlanetRadius + Slack;
+
+            FDensityRange Range{ NearSphere - Bounds.MaxHeight, FarSphere + Bounds.MaxHeight };
+            if (Range.Classify() != EOccupancy::Surface)
+            {
+                return Range;
+            }
+
+            float MinHeight = 0.0f;
+            float MaxHeight = 0.0f;
+            // The warp can move the point a sample's terrain is read at out of the cell, by up to MaxWarpDistance
+            const float HalfDiagonal = HalfExtent * 1.7320508f;
+            FVec3 NoiseCenter = Center;
+            float Distance = HalfDiagonal;
+            bool bUnbounded = false;
+            if (Settings.bHeightfield)
+            {
+                // Heightfields read the terrain on the base sphere, across the cell's footprint there. Its angular
+                // radius is under asin(HalfDiagonal / |Offset|) <= pi/2 * HalfDiagonal / |Offset|, and the bilinear
+                // height grid of a chunk spans the footprint's bounding rectangle on a cube face, another sqrt(2)
+                const double CenterDistance = Offset.Size();
+                bUnbounded = CenterDistance <= 1.05 * HalfDiagonal;
+                if (!bUnbounded)
+                {
+                    NoiseCenter = Settings.PlanetCenter + Offset * (Settings.PlanetRadius / CenterDistance);
+                    Distance = static_cast<float>(2.25 * std::abs(Settings.PlanetRadius) * HalfDiagonal / CenterDistance);
+                }
+            }
+            Distance += FFractalNoise::MaxWarpDistance(Settings);
+            const float Slope = FFractalNoise::ShapeSlope(Settings.FractalType);
+            for (size_t Octave = 0; Octave < Bounds.OctaveFrequencies.size(); Octave++)
+            {
+                const float Amplitude = Bounds.OctaveAmplitudes[Octave] * Settings.NoiseAmplitude;
+                const float Limit = std::abs(Amplitude);
+                if (bUnbounded)
+                {
+                    MinHeight -= Limit;
+                    MaxHeight += Limit;
+                    continue;
+                }
+                const float Noise = FFractalNoise::ValueNoise(NoiseCenter * Bounds.OctaveFrequencies[Octave], FFractalNoise::OctaveSeed(Settings, static_cast<int32_t>(Octave)));
+                const float Value = FFractalNoise::Shape(Settings.FractalType, Noise) * Amplitude;
+                const float Reach = 5.19615242f * Slope * std::abs(Bounds.OctaveFrequencies[Octave]) * Limit * Distance;
+                MinHeight += std::max(Value - Reach, -Limit);
+                MaxHeight += std::min(Value + Reach, Limit);
+            }
+
+            // Density is the sphere term minus the height
+            Range.Min = NearSphere - MaxHeight - Slack;
+            Range.Max = FarSphere - MinHeight + Slack;
+            return Range;
+        }
+
+    private:
+        static size_t GetIndex(int32_t LevelResolution, int32_t X, int32_t Y, int32_t Z)
+        {
+            return (static_cast<size_t>(X) * LevelResolution + Y) * LevelResolution + Z;
+        }
+    };
+}
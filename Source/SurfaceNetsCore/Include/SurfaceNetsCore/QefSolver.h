@@ -0,0 +1,106 @@
+#pragma once
+
+#include "SurfaceNetsCore/SlabAllocator.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SurfaceNetsCore
+{
+    /**
+     * Batch of quadratic error functions, one per surface cell (dual contouring vertex placement).
+     *
+     * Each cell minimizes  sum_i (n_i . (x - p_i))^2 + w |x - c|^2  where p_i/n_i are the edge crossings and
+     * their normals and c is the mass point (centroid of the crossings). Working relative to c, the normal
+     * equations are (A + w I) y = b with A = sum n n^T, b = sum n (n . (p - c)) and x = c + y.
+     *
+     * Systems are stored structure-of-arrays and solved in one branch-free loop over the whole batch, which
+     * compilers auto-vectorize; the w I term keeps every system positive definite so no pivoting is needed.
+     */
+    struct FQefBatch
+    {
+        // Upper triangle of A
+        TSlabVector<float> A00, A01, A02, A11, A12, A22;
+        // Right-hand side
+        TSlabVector<float> B0, B1, B2;
+        // Mass point, overwritten with the solution by Solve
+        TSlabVector<float> X, Y, Z;
+
+        size_t Num() const { return X.size(); }
+
+        void Reset()
+        {
+            for (TSlabVector<float>* Array : { &A00, &A01, &A02, &A11, &A12, &A22, &B0, &B1, &B2, &X, &Y, &Z })
+            {
+                Array->clear();
+            }
+        }
+
+        /** Per-cell accumulator filled one edge crossing at a time before being appended */
+        struct FAccumulator
+        {
+            float A00 = 0.0f, A01 = 0.0f, A02 = 0.0f, A11 = 0.0f, A12 = 0.0f, A22 = 0.0f;
+            float B0 = 0.0f, B1 = 0.0f, B2 = 0.0f;
+
+            /** Add the plane through Point with unit Normal, Point given relative to the mass point */
+            void AddPlane(float Px, float Py, float Pz, float Nx, float Ny, float Nz)
+            {
+                A00 += Nx * Nx; A01 += Nx * Ny; A02 += Nx * Nz;
+                A11 += Ny * Ny; A12 += Ny * Nz; A22 += Nz * Nz;
+
+                const float Distance = Nx * Px + Ny * Py + Nz * Pz;
+                B0 += Nx * Distance; B1 += Ny * Distance; B2 += Nz * Distance;
+            }
+        };
+
+        void Add(const FAccumulator& Qef, float MassX, float MassY, float MassZ)
+        {
+            A00.push_back(Qef.A00); A01.push_back(Qef.A01); A02.push_back(Qef.A02);
+            A11.push_back(Qef.A11); A12.push_back(Qef.A12); A22.push_back(Qef.A22);
+            B0.push_back(Qef.B0); B1.push_back(Qef.B1); B2.push_back(Qef.B2);
+            X.push_back(MassX); Y.push_back(MassY); Z.push_back(MassZ);
+        }
+
+        /**
+         * Solve every system in place, then clamp the result into [MinCoord, MaxCoord]³ (the cell, in cell-local units).
+         * MassPointWeight must be > 0.
+         */
+        void Solve(float MassPointWeight, float MinCoord = 0.0f, float MaxCoord = 1.0f)
+        {
+            const size_t Count = Num();
+            float* __restrict OutX = X.data();
+            float* __restrict OutY = Y.data();
+            float* __restrict OutZ = Z.data();
+
+            for (size_t i = 0; i < Count; i++)
+            {
+                const float M00 = A00[i] + MassPointWeight;
+                const float M11 = A11[i] + MassPointWeight;
+                const float M22 = A22[i] + MassPointWeight;
+                const float M01 = A01[i];
+                const float M02 = A02[i];
+                const float M12 = A12[i];
+
+                // Symmetric 3x3 inverse by cofactors
+                const float C00 = M11 * M22 - M12 * M12;
+                const float C01 = M02 * M12 - M01 * M22;
+                const float C02 = M01 * M12 - M02 * M11;
+                const float C11 = M00 * M22 - M02 * M02;
+                const float C12 = M01 * M02 - M00 * M12;
+                const float C22 = M00 * M11 - M01 * M01;
+                const float InvDet = 1.0f / (M00 * C00 + M01 * C01 + M02 * C02);
+
+                const float Dx = (C00 * B0[i] + C01 * B1[i] + C02 * B2[i]) * InvDet;
+                const float Dy = (C01 * B0[i] + C11 * B1[i] + C12 * B2[i]) * InvDet;
+                const float Dz = (C02 * B0[i] + C12 * B1[i] + C22 * B2[i]) * InvDet;
+
+                const float Sx = OutX[i] + Dx;
+                const float Sy = OutY[i] + Dy;
+                const float Sz = OutZ[i] + Dz;
+                OutX[i] = Sx < MinCoord ? MinCoord : (Sx > MaxCoord ? MaxCoord : Sx);
+                OutY[i] = Sy < MinCoord ? MinCoord : (Sy > MaxCoord ? MaxCoord : Sy);
+                OutZ[i] = Sz < MinCoord ? MinCoord : (Sz > MaxCoord ? MaxCoord : Sz);
+            }
+        }
+    };
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "SurfaceNetsCore/MathTypes.h"
+#include "SurfaceNetsCore/SurfaceNetsMesher.h"
+
+#include <cmath>
+#include <cstdint>
+
+namespace SurfaceNetsCore
+{
+    struct FSdfQuerySettings
+    {
+        /** Largest density change per unit distance (see FFractalNoise::LipschitzBound); steps never overshoot with a true bound */
+        float LipschitzBound = 1.0f;
+
+        /** Density magnitude treated as on the surface */
+        float HitTolerance = 0.01f;
+
+        /** Step cap for sphere tracing and surface projection */
+        int32_t MaxSteps = 256;
+
+        /** Offset of the central differences used for gradients */
+        float GradientStep = 0.5f;
+    };
+
+    struct FSdfHit
+    {
+        bool bHit = false;
+
+        /** Distance along the ray and the hit position */
+        double Distance = 0.0;
+        FVec3 Position;
+    };
+
+    /**
+     * Queries against a density function Density(const FVec3&) -> float, negative inside, without any mesh or
+     * collision. Every query only reads the function, so they run on any thread.
+     */
+    struct FSdfQueries
+    {
+        /**
+         * Sphere-trace from Origin along the unit Direction up to MaxDistance, stepping |density| / Lipschitz
+         * bound. A start inside the surface hits at distance 0.
+         */
+        template <typename TDensity>
+        static FSdfHit SphereTrace(TDensity&& Density, const FVec3& Origin, const FVec3& Direction, double MaxDistance, const FSdfQuerySettings& Settings)
+        {
+            FSdfHit Hit;
+            double Distance = 0.0;
+            double PreviousDistance = 0.0;
+            float Value = Density(Origin);
+
+            for (int32_t Step = 0; Step < Settings.MaxSteps; Step++)
+            {
+                if (IsInside(Value))
+                {
+                    // Only an underestimated bound gets here past the first step; refine the crossing by bisection
+                    Hit.Distance = Step == 0 ? 0.0 : Bisect(Density, Origin, Direction, PreviousDistance, Distance, Settings);
+                    Hit.bHit = true;
+                    break;
+                }
+
+                if (Value <= Settings.HitTolerance)
+                {
+                    Hit.Distance = Distance;
+                    Hit.bHit = true;
+                    break;
+                }
+
+                PreviousDistance = Distance;
+                Distance += Value / Settings.LipschitzBound;
+                if (Distance > MaxDistance || !std::isfinite(Distance))
+                {
+                    break;
+                }
+
+                Value = Density(Origin + Direction * Distance);
+            }
+
+            if (Hit.bHit)
+            {
+                Hit.Position = Origin + Direction * Hit.Distance;
+            }
+            return Hit;
+        }
+
+        /**
+         * Move Point onto the surface by damped Newton steps along the density gradient. For distance-like fields
+         * the result is the closest surface point; false when the gradient vanishes, the steps stall in a local
+         * minimum of |density| (rugged noise has some) or run out. Callers fall back to FindSurfaceRadius.
+         */
+        template <typename TDensity>
+        static bool ProjectToSurface(TDensity&& Density, const FVec3& Point, const FSdfQuerySettings& Settings, FVec3& OutSurfacePoint)
+        {
+            FVec3 P = Point;
+            for (int32_t Step = 0; Step < Settings.MaxSteps; Step++)
+            {
+                const float Value = Density(P);
+                if (std::abs(Value) <= Settings.HitTolerance)
+                {
+                    OutSurfacePoint = P;
+                    return true;
+                }
+
+                const FVec3 Gradient = CalculateGradient(Density, P, Settings.GradientStep);
+                const double GradientSizeSquared = Gradient.SizeSquared();
+                if (!(GradientSizeSquared > 1e-12))
+                {
+                    return false;
+                }
+
+                // Backtrack until the step actually moves closer to the surface, noisy fields overshoot full steps
+                FVec3 NewtonStep = Gradient * (Value / GradientSizeSquared);
+                for (int32_t Halving = 0; ; Halving++)
+                {
+                    if (std::abs(Density(P - NewtonStep)) < std::abs(Value))
+                    {
+                        break;
+                    }
+                    if (Halving == 8)
+                    {
+                        return false; // Stuck in a local minimum of |density| off the surface
+                    }
+                    NewtonStep *= 0.5;
+                }
+                P -= NewtonStep;
+            }
+            return false;
+        }
+
+        /**
+         * Outermost surface radius along the unit Direction from Center, searching the shell [MinRadius, MaxRadius]
+         * from outside in so overhangs report their top. False when the shell has no surface on that line.
+         */
+        template <typename TDensity>
+        static bool FindSurfaceRadius(TDensity&& Density, const FVec3& Center, const FVec3& Direction, double MinRadius, double MaxRadius, const FSdfQuerySettings& Settings, double& OutRadius)
+        {
+            const FSdfHit Hit = SphereTrace(Density, Center + Direction * MaxRadius, -Direction, MaxRadius - MinRadius, Settings);
+            OutRadius = MaxRadius - Hit.Distance;
+            return Hit.bHit;
+        }
+
+        /** Central-difference gradient, pointing out of the surface */
+        template <typename TDensity>
+        static FVec3 CalculateGradient(TDensity&& Density, const FVec3& P, double Step)
+        {
+            const double InvTwoStep = 0.5 / Step;
+            return FVec3(
+                Density(P + FVec3(Step, 0.0, 0.0)) - Density(P - FVec3(Step, 0.0, 0.0)),
+                Density(P + FVec3(0.0, Step, 0.0)) - Density(P - FVec3(0.0, Step, 0.0)),
+                Density(P + FVec3(0.0, 0.0, Step)) - Density(P - FVec3(0.0, 0.0, Step))) * InvTwoStep;
+        }
+
+    private:
+        /** Distance of the crossing between an outside and an inside sample along the ray */
+        template <typename TDensity>
+        static double Bisect(TDensity&& Density, const FVec3& Origin, const FVec3& Direction, double Outside, double Inside, const FSdfQuerySettings& Settings)
+        {
+            for (int32_t Step = 0; Step < 32; Step++)
+            {
+                const double Middle = 0.5 * (Outside + Inside);
+                const float Value = Density(Origin + Direction * Middle);
+                if (std::abs(Value) <= Settings.HitTolerance)
+                {
+                    return Middle;
+                }
+                (IsInside(Value) ? Inside : Outside) = Middle;
+            }
+            return Outside;
+        }
+    };
+}
@@ -0,0 +1,487 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace SurfaceNetsCore
+{
+    /** Snapshot of FSlabAllocator usage; all sizes in bytes */
+    struct FSlabAllocatorStats
+    {
+        /** Memory taken from the system for slabs and large blocks, never returned while cached */
+        uint64_t ReservedBytes = 0;
+
+        /** Size-class bytes of live blocks, headers included */
+        uint64_t InUseBytes = 0;
+
+        /** Bytes the live blocks were asked for */
+        uint64_t RequestedBytes = 0;
+
+        uint64_t PeakInUseBytes = 0;
+        uint64_t PeakReservedBytes = 0;
+
+        uint64_t NumAllocations = 0;
+        uint64_t NumSystemAllocations = 0;
+
+        /** Frees from a thread other than the one that allocated the block */
+        uint64_t NumRemoteFrees = 0;
+
+        /** Requests above the largest size class, passed straight to the system */
+        uint64_t NumOversizeAllocations = 0;
+
+        /** Share of in-use bytes lost to rounding up to a size class */
+        double InternalFragmentation() const
+        {
+            return InUseBytes > 0 ? 1.0 - static_cast<double>(RequestedBytes) / static_cast<double>(InUseBytes) : 0.0;
+        }
+
+        /** Share of reserved bytes sitting idle in free lists and unused slab space */
+        double ExternalFragmentation() const
+        {
+            return ReservedBytes > 0 ? 1.0 - static_cast<double>(InUseBytes) / static_cast<double>(ReservedBytes) : 0.0;
+        }
+    };
+
+    /**
+     * Size-class allocator for chunk payloads (mesh arrays, density grids, mesher scratch).
+     *
+     * Each thread allocates from its own cache: per size class, a free list of recycled blocks and a slab it carves
+     * new blocks from, so the common path takes no lock and shares no cache line with other threads. A block freed
+     * by another thread, e.g. a mesh built on a worker and released on the game thread, goes on its owner's lock-free
+     * remote list and is picked up by the owner the next time that class runs dry.
+     *
+     * Size classes step by a quarter power of two from 64 bytes to 1.75 MB, which covers the output of a 16^3 chunk.
+     * Memory is kept for reuse rather than returned, except blocks too large for slabs beyond a few per class.
+     * The cache of an exited thread is adopted by the next new thread bound to the same memory node.
+     */
+    class FSlabAllocator
+    {
+    public:
+        static constexpr size_t Alignment = 16;
+        static constexpr int32_t NumSizeClasses = 60;
+        /** Slabs hold at least 16 blocks, between MinSlabSize and SlabSize, so rarely used classes reserve little */
+        static constexpr size_t MinSlabSize = 16 * 1024;
+        static constexpr size_t SlabSize = 256 * 1024;
+
+        /** Blocks above this get a system allocation each instead of sharing a slab */
+        static constexpr size_t MaxSlabBlockSize = SlabSize / 8;
+
+        /** Free blocks kept per class and thread for classes above MaxSlabBlockSize */
+        static constexpr int32_t MaxCachedLargeBlocks = 4;
+
+        /** Process-wide instance; intentionally never destroyed, blocks may be freed during static destruction */
+        static FSlabAllocator& Get()
+        {
+            static FSlabAllocator* Instance = new FSlabAllocator();
+            return *Instance;
+        }
+
+        /** Allocate Size bytes aligned to Alignment; never returns null for Size > 0 */
+        void* Allocate(size_t Size)
+        {
+            if (Size == 0)
+            {
+                return nullptr;
+            }
+
+            const size_t BlockSize = Size + sizeof(FBlockHeader);
+            const int32_t SizeClass = FindSizeClass(BlockSize);
+            FBlockHeader* Block = nullptr;
+            FThreadCache* Cache = nullptr;
+
+            if (SizeClass < 0)
+            {
+                Block = static_cast<FBlockHeader*>(SystemAllocate(BlockSize));
+                NumOversizeAllocations.fetch_add(1, std::memory_order_relaxed);
+                AddReserved(BlockSize);
+            }
+            else
+            {
+                Cache = GetThreadCache();
+                Block = Cache->Pop(SizeClass);
+                if (!Block)
+                {
+                    Cache->ReclaimRemoteFrees(*this);
+                    Block = Cache->Pop(SizeClass);
+                }
+                if (!Block)
+                {
+                    Block = CarveBlock(*Cache, SizeClass);
+                }
+            }
+
+            const size_t ClassSize = SizeClass < 0 ? BlockSize : GetSizeClassSize(SizeClass);
+            Block->Owner = Cache;
+            Block->SizeClass = SizeClass;
+            Block->RequestedSize = Size;
+
+            NumAllocations.fetch_add(1, std::memory_order_relaxed);
+            RequestedBytes.fetch_add(Size, std::memory_order_relaxed);
+            const uint64_t NewInUse = InUseBytes.fetch_add(ClassSize, std::memory_order_relaxed) + ClassSize;
+            UpdatePeak(PeakInUseBytes, NewInUse);
+
+            return Block + 1;
+        }
+
+        void Free(void* Ptr)
+        {
+            if (!Ptr)
+            {
+                return;
+            }
+
+            FBlockHeader* Block = static_cast<FBlockHeader*>(Ptr) - 1;
+            const int32_t SizeClass = Block->SizeClass;
+            const size_t ClassSize = SizeClass < 0 ? Block->RequestedSize + sizeof(FBlockHeader) : GetSizeClassSize(SizeClass);
+            RequestedBytes.fetch_sub(Block->RequestedSize, std::memory_order_relaxed);
+            InUseBytes.fetch_sub(ClassSize, std::memory_order_relaxed);
+
+            if (SizeClass < 0)
+            {
+                ReservedBytes.fetch_sub(ClassSize, std::memory_order_relaxed);
+                SystemFree(Block);
+                return;
+            }
+
+            FThreadCache* Owner = Block->Owner;
+            if (Owner == GetThreadCache())
+            {
+                ReleaseLocal(*Owner, Block);
+            }
+            else
+            {
+                NumRemoteFrees.fetch_add(1, std::memory_order_relaxed);
+                Owner->PushRemote(Block);
+            }
+        }
+
+        /** Bytes usable in the block at Ptr, at least what it was allocated with */
+        size_t GetUsableSize(const void* Ptr) const
+        {
+            const FBlockHeader* Block = static_cast<const FBlockHeader*>(Ptr) - 1;
+            return Block->SizeClass < 0 ? Block->RequestedSize : GetSizeClassSize(Block->SizeClass) - sizeof(FBlockHeader);
+        }
+
+        /** Usable bytes of the block an allocation of Size bytes would get, for containers sizing their slack */
+        size_t GetGoodSize(size_t Size) const
+        {
+            const int32_t SizeClass = FindSizeClass(Size + sizeof(FBlockHeader));
+            return SizeClass < 0 ? Size : GetSizeClassSize(SizeClass) - sizeof(FBlockHeader);
+        }
+
+        FSlabAllocatorStats GetStats() const
+        {
+            FSlabAllocatorStats Stats;
+            Stats.ReservedBytes = ReservedBytes.load(std::memory_order_relaxed);
+            Stats.InUseBytes = InUseBytes.load(std::memory_order_relaxed);
+            Stats.RequestedBytes = RequestedBytes.load(std::memory_order_relaxed);
+            Stats.PeakInUseBytes = PeakInUseBytes.load(std::memory_order_relaxed);
+            Stats.PeakReservedBytes = PeakReservedBytes.load(std::memory_order_relaxed);
+            Stats.NumAllocations = NumAllocations.load(std::memory_order_relaxed);
+            Stats.NumSystemAllocations = NumSystemAllocations.load(std::memory_order_relaxed);
+            Stats.NumRemoteFrees = NumRemoteFrees.load(std::memory_order_relaxed);
+            Stats.NumOversizeAllocations = NumOversizeAllocations.load(std::memory_order_relaxed);
+            return Stats;
+        }
+
+        /**
+         * Serve the calling thread from caches of a memory node (e.g. the socket its cores belong to), so the slabs
+         * it carves and first touches are only ever recycled by threads of that node. Threads start on node -1.
+         * Best called before the thread allocates; blocks it already holds stay with its previous cache.
+         */
+        void BindCurrentThreadToNode(int32_t Node)
+        {
+            FThreadCacheHandle& Handle = GetThreadCacheHandle();
+            Handle.Node = Node;
+            if (Handle.Cache && Handle.Cache->Node != Node)
+            {
+                {
+                    std::lock_guard<std::mutex> Lock(CachesMutex);
+                    Handle.Cache->bInUse = false;
+                }
+                Handle.Cache = nullptr;
+            }
+        }
+
+        /** Restart peak tracking from the current usage, e.g. per streaming session */
+        void ResetPeaks()
+        {
+            PeakInUseBytes.store(InUseBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            PeakReservedBytes.store(ReservedBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+
+        /** Four steps per power of two: 64, 80, 96, 112, 128, 160, ... */
+        static constexpr size_t GetSizeClassSize(int32_t SizeClass)
+        {
+            return (size_t(64) << (SizeClass / 4)) / 4 * (4 + SizeClass % 4);
+        }
+
+        FSlabAllocator(const FSlabAllocator&) = delete;
+        FSlabAllocator& operator=(const FSlabAllocator&) = delete;
+
+    private:
+        struct FThreadCache;
+
+        /** Precedes every block; keeps the payload 16-byte aligned */
+        struct alignas(Alignment) FBlockHeader
+        {
+            FThreadCache* Owner = nullptr;
+            int32_t SizeClass = 0;
+            size_t RequestedSize = 0;
+        };
+        static_assert(sizeof(FBlockHeader) == 2 * Alignment, "Block header must keep payloads aligned");
+
+        /** Free block, linked through its payload */
+        struct FFreeBlock
+        {
+            FFreeBlock* Next;
+        };
+
+        struct FThreadCache
+        {
+            FFreeBlock* FreeLists[NumSizeClasses] = {};
+            int32_t FreeCounts[NumSizeClasses] = {};
+
+            /** Unused tail of the current slab per class */
+            char* SlabCursor[NumSizeClasses] = {};
+            char* SlabEnd[NumSizeClasses] = {};
+
+            /** Blocks freed by other threads, pushed lock-free and taken all at once by the owner */
+            std::atomic<FBlockHeader*> RemoteFrees{ nullptr };
+
+            /** Memory node of the threads this cache serves, -1 for unbound threads */
+            int32_t Node = -1;
+
+            bool bInUse = false;
+
+            FBlockHeader* Pop(int32_t SizeClass)
+            {
+                FFreeBlock* Free = FreeLists[SizeClass];
+                if (!Free)
+                {
+                    return nullptr;
+                }
+                FreeLists[SizeClass] = Free->Next;
+                FreeCounts[SizeClass]--;
+                return reinterpret_cast<FBlockHeader*>(Free);
+            }
+
+            void Push(FBlockHeader* Block)
+            {
+                FFreeBlock* Free = reinterpret_cast<FFreeBlock*>(Block);
+                Free->Next = FreeLists[Block->SizeClass];
+                FreeLists[Block->SizeClass] = Free;
+                FreeCounts[Block->SizeClass]++;
+            }
+
+            /** Any thread; the header is rewritten to link the list, SizeClass stays valid */
+            void PushRemote(FBlockHeader* Block)
+            {
+                FBlockHeader* Head = RemoteFrees.load(std::memory_order_relaxed);
+                do
+                {
+                    Block->Owner = reinterpret_cast<FThreadCache*>(Head);
+                }
+                while (!RemoteFrees.compare_exchange_weak(Head, Block, std::memory_order_release, std::memory_order_relaxed));
+            }
+
+            void ReclaimRemoteFrees(FSlabAllocator& Allocator)
+            {
+                FBlockHeader* Block = RemoteFrees.exchange(nullptr, std::memory_order_acquire);
+                while (Block)
+                {
+                    FBlockHeader* Next = reinterpret_cast<FBlockHeader*>(Block->Owner);
+                    Block->Owner = this;
+                    Allocator.ReleaseLocal(*this, Block);
+                    Block = Next;
+                }
+            }
+        };
+
+        /** Returns the thread's cache to the pool when the thread exits */
+        struct FThreadCacheHandle
+        {
+            FThreadCache* Cache = nullptr;
+            int32_t Node = -1;
+
+            ~FThreadCacheHandle()
+            {
+                if (Cache)
+                {
+                    FSlabAllocator& Allocator = Get();
+                    std::lock_guard<std::mutex> Lock(Allocator.CachesMutex);
+                    Cache->bInUse = false;
+                }
+            }
+        };
+
+        FSlabAllocator() = default;
+
+        /** Smallest class holding BlockSize bytes, -1 above the largest */
+        static int32_t FindSizeClass(size_t BlockSize)
+        {
+            if (BlockSize <= 64)
+            {
+                return 0;
+            }
+
+            // BlockSize - 1 lies in [2^Bit, 2^(Bit + 1)), whose classes step by 2^(Bit - 2)
+            int32_t Bit = 6;
+            while (((BlockSize - 1) >> (Bit + 1)) != 0)
+            {
+                Bit++;
+            }
+            const size_t Step = size_t(1) << (Bit - 2);
+            const int32_t SizeClass = (Bit - 6) * 4 + static_cast<int32_t>((BlockSize - (size_t(1) << Bit) + Step - 1) >> (Bit - 2));
+            return SizeClass < NumSizeClasses ? SizeClass : -1;
+        }
+
+        static FThreadCacheHandle& GetThreadCacheHandle()
+        {
+            static thread_local FThreadCacheHandle Handle;
+            return Handle;
+        }
+
+        FThreadCache* GetThreadCache()
+        {
+            FThreadCacheHandle& Handle = GetThreadCacheHandle();
+            if (!Handle.Cache)
+            {
+                Handle.Cache = AcquireCache(Handle.Node);
+            }
+            return Handle.Cache;
+        }
+
+        FThreadCache* AcquireCache(int32_t Node)
+        {
+            std::lock_guard<std::mutex> Lock(CachesMutex);
+            for (FThreadCache* Cache : Caches)
+            {
+                if (!Cache->bInUse && Cache->Node == Node)
+                {
+                    Cache->bInUse = true;
+                    return Cache;
+                }
+            }
+
+            FThreadCache* Cache = new FThreadCache();
+            Cache->Node = Node;
+            Cache->bInUse = true;
+            Caches.push_back(Cache);
+            return Cache;
+        }
+
+        FBlockHeader* CarveBlock(FThreadCache& Cache, int32_t SizeClass)
+        {
+            const size_t ClassSize = GetSizeClassSize(SizeClass);
+            if (ClassSize > MaxSlabBlockSize)
+            {
+                AddReserved(ClassSize);
+                return static_cast<FBlockHeader*>(SystemAllocate(ClassSize));
+            }
+
+            if (static_cast<size_t>(Cache.SlabEnd[SizeClass] - Cache.SlabCursor[SizeClass]) < ClassSize)
+            {
+                // The unused tail of the previous slab stays reserved, counted as external fragmentation
+                const size_t NewSlabSize = std::min(std::max(ClassSize * 16, MinSlabSize), SlabSize);
+                Cache.SlabCursor[SizeClass] = static_cast<char*>(SystemAllocate(NewSlabSize));
+                Cache.SlabEnd[SizeClass] = Cache.SlabCursor[SizeClass] + NewSlabSize;
+                AddReserved(NewSlabSize);
+            }
+
+            FBlockHeader* Block = reinterpret_cast<FBlockHeader*>(Cache.SlabCursor[SizeClass]);
+            Cache.SlabCursor[SizeClass] += ClassSize;
+            return Block;
+        }
+
+        void ReleaseLocal(FThreadCache& Cache, FBlockHeader* Block)
+        {
+            const int32_t SizeClass = Block->SizeClass;
+            if (GetSizeClassSize(SizeClass) > MaxSlabBlockSize && Cache.FreeCounts[SizeClass] >= MaxCachedLargeBlocks)
+            {
+                ReservedBytes.fetch_sub(GetSizeClassSize(SizeClass), std::memory_order_relaxed);
+                SystemFree(Block);
+                return;
+            }
+            Cache.Push(Block);
+        }
+
+        void* SystemAllocate(size_t Size)
+        {
+            NumSystemAllocations.fetch_add(1, std::memory_order_relaxed);
+            void* Memory = ::operator new(Size, std::align_val_t(Alignment));
+            return Memory;
+        }
+
+        static void SystemFree(void* Memory)
+        {
+            ::operator delete(Memory, std::align_val_t(Alignment));
+        }
+
+        void AddReserved(size_t Size)
+        {
+            UpdatePeak(PeakReservedBytes, ReservedBytes.fetch_add(Size, std::memory_order_relaxed) + Size);
+        }
+
+        static void UpdatePeak(std::atomic<uint64_t>& Peak, uint64_t Value)
+        {
+            uint64_t Current = Peak.load(std::memory_order_relaxed);
+            while (Value > Current && !Peak.compare_exchange_weak(Current, Value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        std::mutex CachesMutex;
+        std::vector<FThreadCache*> Caches;
+
+        std::atomic<uint64_t> ReservedBytes{ 0 };
+        std::atomic<uint64_t> InUseBytes{ 0 };
+        std::atomic<uint64_t> RequestedBytes{ 0 };
+        std::atomic<uint64_t> PeakInUseBytes{ 0 };
+        std::atomic<uint64_t> PeakReservedBytes{ 0 };
+        std::atomic<uint64_t> NumAllocations{ 0 };
+        std::atomic<uint64_t> NumSystemAllocations{ 0 };
+        std::atomic<uint64_t> NumRemoteFrees{ 0 };
+        std::atomic<uint64_t> NumOversizeAllocations{ 0 };
+    };
+
+    /** Standard allocator over FSlabAllocator, for std containers holding chunk data */
+    template <typename T>
+    struct TSlabAllocator
+    {
+        using value_type = T;
+
+        TSlabAllocator() noexcept = default;
+
+        template <typename U>
+        TSlabAllocator(const TSlabAllocator<U>&) noexcept
+        {
+        }
+
+        T* allocate(size_t Count)
+        {
+            static_assert(alignof(T) <= FSlabAllocator::Alignment, "Over-aligned types are not supported");
+            return static_cast<T*>(FSlabAllocator::Get().Allocate(Count * sizeof(T)));
+        }
+
+        void deallocate(T* Ptr, size_t) noexcept
+        {
+            FSlabAllocator::Get().Free(Ptr);
+        }
+
+        template <typename U>
+        bool operator==(const TSlabAllocator<U>&) const noexcept { return true; }
+
+        template <typename U>
+        bool operator!=(const TSlabAllocator<U>&) const noexcept { return false; }
+    };
+
+    template <typename T>
+    using TSlabVector = std::vector<T, TSlabAllocator<T>>;
+}
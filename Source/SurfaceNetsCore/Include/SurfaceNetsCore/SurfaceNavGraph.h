@@ -0,0 +1,262 @@
+#pragma once
+
+#include "SurfaceNetsCore/MathTypes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace SurfaceNetsCore
+{
+    struct FSurfaceNavSettings
+    {
+        /** Up is the direction away from the planet center, so walkability follows spherical gravity */
+        FVec3 PlanetCenter;
+
+        /** Steepest walkable surface, measured from the local up */
+        double MaxSlopeDegrees = 45.0;
+
+        /** Chunk bounds; nodes within BoundaryMargin of a face become portals to the neighbouring chunk */
+        FVec3 BoundsMin;
+        FVec3 BoundsMax;
+        double BoundaryMargin = 0.0;
+
+        /** Grid step portal positions are snapped to before matching, a small fraction of a voxel */
+        double PortalQuantization = 0.01;
+    };
+
+    /**
+     * Key matching the same position in two chunk meshes: neighbouring chunks emit identical vertices along
+     * their shared face, so equal keys are one walkable point seen from both sides.
+     */
+    inline uint64_t MakePortalKey(const FVec3& Position, double Quantization)
+    {
+        // 21 bits per axis, offset so negative coordinates stay in range
+        auto Quantize = [Quantization](double Value)
+        {
+            return static_cast<uint64_t>(std::llround(Value / Quantization) + (1ll << 20)) & ((1ull << 21) - 1);
+        };
+        return Quantize(Position.X) | (Quantize(Position.Y) << 21) | (Quantize(Position.Z) << 42);
+    }
+
+    /**
+     * Walkable surface graph of one chunk mesh: walkable vertices become nodes, mesh edges between them become
+     * links weighted by length. Links are stored compressed (node N's links are Links[LinkOffsets[N]] up to
+     * Links[LinkOffsets[N + 1]]).
+     */
+    struct FSurfaceNavGraph
+    {
+        std::vector<FVec3> NodePositions;
+        std::vector<int32_t> LinkOffsets;
+        std::vector<int32_t> Links;
+        std::vector<float> LinkCosts;
+
+        /** Nodes on the chunk boundary and their portal keys */
+        std::vector<int32_t> PortalNodes;
+        std::vector<uint64_t> PortalKeys;
+        double PortalQuantization = 0.01;
+
+        int32_t NumNodes() const { return static_cast<int32_t>(NodePositions.size()); }
+
+        /** Build from an indexed triangle mesh; PositionAt(i) and NormalAt(i) return vertex i's data */
+        template <typename TPositionAt, typename TNormalAt>
+        void Build(
+            int32_t NumVertices,
+            const int32_t* Indices,
+            size_t NumIndices,
+            TPositionAt&& PositionAt,
+            TNormalAt&& NormalAt,
+            const FSurfaceNavSettings& Settings)
+        {
+            NodePositions.clear();
+            LinkOffsets.clear();
+            Links.clear();
+            LinkCosts.clear();
+            PortalNodes.clear();
+            PortalKeys.clear();
+            PortalQuantization = Settings.PortalQuantization;
+
+            const double MinUpDot = std::cos(Settings.MaxSlopeDegrees * 3.14159265358979323846 / 180.0);
+
+            // Walkable vertices get consecutive node indices
+            std::vector<int32_t> VertexNode(NumVertices, -1);
+            for (int32_t Vertex = 0; Vertex < NumVertices; Vertex++)
+            {
+                const FVec3 Position(PositionAt(Vertex));
+                const FVec3 Normal(NormalAt(Vertex));
+                FVec3 Up = Position - Settings.PlanetCenter;
+                if (!Up.Normalize() || Dot(Normal, Up) < MinUpDot)
+                {
+                    continue;
+                }
+
+                VertexNode[Vertex] = NumNodes();
+                NodePositions.push_back(Position);
+            }
+
+            // Each undirected link once, from the triangles whose edges join two walkable vertices
+            std::vector<std::pair<int32_t, int32_t>> Edges;
+            Edges.reserve(NumIndices);
+            for (size_t i = 0; i + 2 < NumIndices; i += 3)
+            {
+                for (int32_t Side = 0; Side < 3; Side++)
+                {
+                    const int32_t A = Indices[i + Side];
+                    const int32_t B = Indices[i + (Side + 1) % 3];
+                    if (A < 0 || B < 0 || A >= NumVertices || B >= NumVertices)
+                    {
+                        continue;
+                    }
+
+                    const int32_t NodeA = VertexNode[A];
+                    const int32_t NodeB = VertexNode[B];
+                    if (NodeA >= 0 && NodeB >= 0 && NodeA != NodeB)
+                    {
+                        Edges.emplace_back(std::min(NodeA, NodeB), std::max(NodeA, NodeB));
+                    }
+                }
+            }
+            std::sort(Edges.begin(), Edges.end());
+            Edges.erase(std::unique(Edges.begin(), Edges.end()), Edges.end());
+
+            LinkOffsets.assign(NodePositions.size() + 1, 0);
+            for (const std::pair<int32_t, int32_t>& Edge : Edges)
+            {
+                LinkOffsets[Edge.first + 1]++;
+                LinkOffsets[Edge.second + 1]++;
+            }
+            for (size_t Node = 0; Node < NodePositions.size(); Node++)
+            {
+                LinkOffsets[Node + 1] += LinkOffsets[Node];
+            }
+
+            Links.resize(Edges.size() * 2);
+            LinkCosts.resize(Edges.size() * 2);
+            std::vector<int32_t> Cursor(LinkOffsets.begin(), LinkOffsets.end() - 1);
+            for (const std::pair<int32_t, int32_t>& Edge : Edges)
+            {
+                const float Cost = static_cast<float>((NodePositions[Edge.first] - NodePositions[Edge.second]).Size());
+                Links[Cursor[Edge.first]] = Edge.second;
+                LinkCosts[Cursor[Edge.first]++] = Cost;
+                Links[Cursor[Edge.second]] = Edge.first;
+                LinkCosts[Cursor[Edge.second]++] = Cost;
+            }
+
+            for (int32_t Node = 0; Node < NumNodes(); Node++)
+            {
+                if (IsNearBoundary(NodePositions[Node], Settings))
+                {
+                    PortalNodes.push_back(Node);
+                    PortalKeys.push_back(PortalKeyOf(Node));
+                }
+            }
+        }
+
+        uint64_t PortalKeyOf(int32_t Node) const
+        {
+            return MakePortalKey(NodePositions[Node], PortalQuantization);
+        }
+
+        /** Closest node to Point, or -1 when none is within MaxDistance */
+        int32_t FindNearestNode(const FVec3& Point, double MaxDistance) const
+        {
+            int32_t Nearest = -1;
+            double NearestDistanceSquared = MaxDistance * MaxDistance;
+            for (int32_t Node = 0; Node < NumNodes(); Node++)
+            {
+                const double DistanceSquared = (NodePositions[Node] - Point).SizeSquared();
+                if (DistanceSquared <= NearestDistanceSquared)
+                {
+                    Nearest = Node;
+                    NearestDistanceSquared = DistanceSquared;
+                }
+            }
+            return Nearest;
+        }
+
+        static bool IsNearBoundary(const FVec3& Position, const FSurfaceNavSettings& Settings)
+        {
+            return Position.X <= Settings.BoundsMin.X + Settings.BoundaryMargin || Position.X >= Settings.BoundsMax.X - Settings.BoundaryMargin
+                || Position.Y <= Settings.BoundsMin.Y + Settings.BoundaryMargin || Position.Y >= Settings.BoundsMax.Y - Settings.BoundaryMargin
+                || Position.Z <= Settings.BoundsMin.Z + Settings.BoundaryMargin || Position.Z >= Settings.BoundsMax.Z - Settings.BoundaryMargin;
+        }
+    };
+
+    /**
+     * A* over any graph with 64-bit node ids, so callers can search across several chunk graphs joined by portals.
+     * ForEachNeighbor(Node, Visit) calls Visit(Neighbor, Cost); Heuristic(Node) must not overestimate the remaining
+     * cost. Gives up after MaxExpansions nodes. OutPath runs from Start to Goal.
+     */
+    template <typename TForEachNeighbor, typename THeuristic>
+    bool FindPath(
+        uint64_t Start,
+        uint64_t Goal,
+        TForEachNeighbor&& ForEachNeighbor,
+        THeuristic&& Heuristic,
+        std::vector<uint64_t>& OutPath,
+        size_t MaxExpansions = 100000)
+    {
+        struct FNodeRecord
+        {
+            double Cost = 0.0;
+            uint64_t Parent = 0;
+            bool bClosed = false;
+        };
+
+        using FOpenEntry = std::pair<double, uint64_t>;
+        std::priority_queue<FOpenEntry, std::vector<FOpenEntry>, std::greater<FOpenEntry>> Open;
+        std::unordered_map<uint64_t, FNodeRecord> Records;
+
+        OutPath.clear();
+        Records[Start] = FNodeRecord{ 0.0, Start, false };
+        Open.emplace(Heuristic(Start), Start);
+
+        size_t NumExpanded = 0;
+        while (!Open.empty() && NumExpanded < MaxExpansions)
+        {
+            const uint64_t Node = Open.top().second;
+            Open.pop();
+
+            FNodeRecord& Record = Records[Node];
+            if (Record.bClosed)
+            {
+                continue;
+            }
+            Record.bClosed = true;
+            NumExpanded++;
+
+            if (Node == Goal)
+            {
+                for (uint64_t Step = Goal; Step != Start; Step = Records[Step].Parent)
+                {
+                    OutPath.push_back(Step);
+                }
+                OutPath.push_back(Start);
+                std::reverse(OutPath.begin(), OutPath.end());
+                return true;
+            }
+
+            const double NodeCost = Record.Cost;
+            ForEachNeighbor(Node, [&Records, &Open, &Heuristic, Node, NodeCost](uint64_t Neighbor, double LinkCost)
+            {
+                const double Cost = NodeCost + LinkCost;
+                const auto Found = Records.find(Neighbor);
+                if (Found != Records.end() && (Found->second.bClosed || Found->second.Cost <= Cost))
+                {
+                    return;
+                }
+
+                Records[Neighbor] = FNodeRecord{ Cost, Node, false };
+                Open.emplace(Cost + Heuristic(Neighbor), Neighbor);
+            });
+        }
+
+        return false;
+    }
+}
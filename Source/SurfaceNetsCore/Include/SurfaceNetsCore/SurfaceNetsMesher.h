@@ -0,0 +1,718 @@
+#pragma once
+
+#include "SurfaceNetsCore/CellTables.h"
+#include "SurfaceNetsCore/MathTypes.h"
+#include "SurfaceNetsCore/MeshLayout.h"
+#include "SurfaceNetsCore/QefSolver.h"
+#include "SurfaceNetsCore/SlabAllocator.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace SurfaceNetsCore
+{
+    /** Sign convention shared by every surface test: only strictly negative samples are inside */
+    inline bool IsInside(float Density)
+    {
+        return Density < 0.0f;
+    }
+
+    /** Read-only view of a cubic density grid, x fastest */
+    struct FDensityGridView
+    {
+        const float* Data = nullptr;
+        int32_t GridSize = 0;
+        float VoxelSize = 1.0f;
+        FVec3 Origin;
+
+        /** Get density value at grid coordinates, outside bounds is considered positive (exterior) */
+        float Get(int32_t X, int32_t Y, int32_t Z) const
+        {
+            if (X < 0 || X >= GridSize || Y < 0 || Y >= GridSize || Z < 0 || Z >= GridSize)
+            {
+                return 1.0f;
+            }
+            return Data[X + Y * GridSize + Z * GridSize * GridSize];
+        }
+    };
+
+    /** How a surface cell's vertex is placed inside the cell */
+    enum class EVertexPlacement : uint8_t
+    {
+        /** Average of the edge crossings (classic Surface Nets, smooth) */
+        Centroid,
+        /** Minimize the quadratic error to the crossing tangent planes (dual contouring, keeps sharp edges) */
+        Qef,
+    };
+
+    struct FSurfaceNetsSettings
+    {
+        EVertexPlacement VertexPlacement = EVertexPlacement::Centroid;
+
+        /** QEF pull towards the centroid; keeps flat and degenerate cells stable, larger values round features off */
+        float QefMassPointWeight = 0.05f;
+
+        /**
+         * Emit one vertex per surface sheet instead of one per cell, so thin features that pass two sheets
+         * through a cell stay manifold (see FCellTopology). Costs a few extra vertices in ambiguous cells.
+         */
+        bool bManifold = false;
+    };
+
+    /**
+     * Working memory reused between GenerateMesh calls, shared by FSurfaceNetsMesher and FMarchingCubesMesher.
+     * Slab-backed, so a scratch created per chunk recycles the previous chunk's buffers on the same thread.
+     */
+    struct FSurfaceNetsScratch
+    {
+        TSlabVector<int32_t> VertexGrid;
+
+        /** Surface cells (or sheets, in manifold mode) in emission order and their QEFs */
+        TSlabVector<FIntVec3> SurfaceCells;
+        FQefBatch QefBatch;
+
+        /** Inside flag per grid point in bounds and the resulting corner sign mask per cell */
+        TSlabVector<uint8_t> CornerSigns;
+        TSlabVector<uint8_t> CellMasks;
+
+        /** Manifold mode: normal of each emitted sheet */
+        TSlabVector<FVec3> SheetNormals;
+
+        /** Marching cubes: vertex on each grid edge, three per grid point (X, Y and Z edges) */
+        TSlabVector<int32_t> EdgeVertices;
+    };
+
+    /** Exact output size of a GenerateMesh call, known after the sign pass */
+    struct FMeshCounts
+    {
+        int32_t NumVertices = 0;
+        int32_t NumTriangles = 0;
+    };
+
+    /**
+     * Surface Nets mesh generation, based on the Rust fast-surface-nets-rs library with chunk-friendly bounds.
+     *
+     * Output goes through a sink so each caller writes straight into its own containers:
+     *   void Allocate(int32_t NumVertices, int32_t NumTriangles);
+     *   void AddVertex(const FVec3& Position, const FVec3& Normal);
+     *   void AddTriangle(int32_t A, int32_t B, int32_t C);
+     * Allocate comes first, once, with the exact number of vertices and triangles that follow, so sinks size
+     * their storage a single time (or map GPU staging memory) and write the Add calls with plain stores.
+     * The sink is the layout policy: TMeshBuffers<EMeshLayout> selects interleaved or per-component output.
+     */
+    struct FSurfaceNetsMesher
+    {
+        /** Mesh the cells in [MinBounds, MaxBounds) of the grid */
+        template <typename TSink>
+        static void GenerateMesh(
+            const FDensityGridView& Grid,
+            const FIntVec3& MinBounds,
+            const FIntVec3& MaxBounds,
+            const FSurfaceNetsSettings& Settings,
+            FSurfaceNetsScratch& Scratch,
+            TSink& Sink)
+        {
+            const size_t NumCells = static_cast<size_t>(Grid.GridSize) * Grid.GridSize * Grid.GridSize;
+            Scratch.VertexGrid.assign(NumCells, -1);
+
+            // Corner sign mask of every cell in bounds, shared by both phases
+            ComputeCellMasks(Grid, MinBounds, MaxBounds, Scratch);
+
+            const FMeshCounts Counts = CountMesh(Grid, MinBounds, MaxBounds, Settings.bManifold, Scratch.CellMasks);
+            Sink.Allocate(Counts.NumVertices, Counts.NumTriangles);
+
+            if (Settings.bManifold)
+            {
+                EstimateSurfaceManifold(Grid, MinBounds, MaxBounds, Settings, Scratch, Sink);
+
+                // Each cell's vertices are consecutive, one per sheet, so pick the sheet the quad edge belongs to
+                const TSlabVector<int32_t>& VertexGrid = Scratch.VertexGrid;
+                const TSlabVector<uint8_t>& CellMasks = Scratch.CellMasks;
+                MakeAllQuads(Grid, MinBounds, MaxBounds, CellMasks, [&Grid, &VertexGrid, &CellMasks](int32_t x, int32_t y, int32_t z, int32_t CubeEdge)
+                {
+                    const int32_t BaseIndex = GetVertexIndex(Grid.GridSize, VertexGrid, x, y, z);
+                    if (BaseIndex < 0)
+                    {
+                        return -1;
+                    }
+                    const int32_t Sheet = CellTopologyTable[CellMasks[x + y * Grid.GridSize + z * Grid.GridSize * Grid.GridSize]].EdgeComponent[CubeEdge];
+                    return Sheet < 0 ? -1 : BaseIndex + Sheet;
+                }, Sink);
+                return;
+            }
+
+            // Phase 1: Estimate surface vertices
+            if (Settings.VertexPlacement == EVertexPlacement::Qef)
+            {
+                EstimateSurfaceQef(Grid, MinBounds, MaxBounds, Settings.QefMassPointWeight, Scratch, Sink);
+            }
+            else
+            {
+                EstimateSurface(Grid, MinBounds, MaxBounds, Scratch, Sink);
+            }
+
+            // Phase 2: Generate triangles
+            const TSlabVector<int32_t>& VertexGrid = Scratch.VertexGrid;
+            MakeAllQuads(Grid, MinBounds, MaxBounds, Scratch.CellMasks, [&Grid, &VertexGrid](int32_t x, int32_t y, int32_t z, int32_t /*CubeEdge*/)
+            {
+                return GetVertexIndex(Grid.GridSize, VertexGrid, x, y, z);
+            }, Sink);
+        }
+
+        /**
+         * Sign pass: flag which grid points in [MinBounds, MaxBounds] are inside, then pack the eight corner flags
+         * of every cell in [MinBounds, MaxBounds) into its mask (bit i set when corner i is inside). Points past
+         * the grid count as outside, like FDensityGridView::Get. Both inner loops are branch-free along x.
+         */
+        static void ComputeCellMasks(
+            const FDensityGridView& Grid,
+            const FIntVec3& MinBounds,
+            const FIntVec3& MaxBounds,
+            FSurfaceNetsScratch& Scratch)
+        {
+            const int32_t GridSize = Grid.GridSize;
+            Scratch.CellMasks.assign(static_cast<size_t>(GridSize) * GridSize * GridSize, 0);
+
+            if (MaxBounds.X <= MinBounds.X || MaxBounds.Y <= MinBounds.Y || MaxBounds.Z <= MinBounds.Z)
+            {
+                return;
+            }
+
+            const int32_t SizeX = MaxBounds.X - MinBounds.X + 1;
+            const int32_t SizeY = MaxBounds.Y - MinBounds.Y + 1;
+            const int32_t SizeZ = MaxBounds.Z - MinBounds.Z + 1;
+            Scratch.CornerSigns.assign(static_cast<size_t>(SizeX) * SizeY * SizeZ, 0);
+
+            const int32_t BeginX = MinBounds.X > 0 ? MinBounds.X : 0;
+            const int32_t EndX = MaxBounds.X + 1 < GridSize ? MaxBounds.X + 1 : GridSize;
+
+            for (int32_t z = 0; z < SizeZ; z++)
+            {
+                const int32_t GridZ = MinBounds.Z + z;
+                for (int32_t y = 0; y < SizeY; y++)
+                {
+                    const int32_t GridY = MinBounds.Y + y;
+                    if (GridY < 0 || GridY >= GridSize || GridZ < 0 || GridZ >= GridSize)
+                    {
+                        continue;
+                    }
+
+                    const float* Row = Grid.Data + GridY * GridSize + GridZ * GridSize * GridSize;
+                    uint8_t* Signs = Scratch.CornerSigns.data() + (y + z * SizeY) * SizeX;
+                    for (int32_t x = BeginX; x < EndX; x++)
+                    {
+                        Signs[x - MinBounds.X] = IsInside(Row[x]) ? 1 : 0;
+                    }
+                }
+            }
+
+            for (int32_t z = 0; z < SizeZ - 1; z++)
+            {
+                for (int32_t y = 0; y < SizeY - 1; y++)
+                {
+                    const uint8_t* S00 = Scratch.CornerSigns.data() + (y + z * SizeY) * SizeX;
+                    const uint8_t* S10 = S00 + SizeX;
+                    const uint8_t* S01 = S00 + SizeX * SizeY;
+                    const uint8_t* S11 = S01 + SizeX;
+                    uint8_t* __restrict Masks = Scratch.CellMasks.data()
+                        + MinBounds.X + (MinBounds.Y + y) * GridSize + (MinBounds.Z + z) * GridSize * GridSize;
+
+                    for (int32_t x = 0; x < SizeX - 1; x++)
+                    {
+                        Masks[x] = static_cast<uint8_t>(
+                            S00[x] | (S00[x + 1] << 1) | (S10[x] << 2) | (S10[x + 1] << 3) |
+                            (S01[x] << 4) | (S01[x + 1] << 5) | (S11[x] << 6) | (S11[x + 1] << 7));
+                    }
+                }
+            }
+        }
+
+        /**
+         * Counting pass over the cell masks: the vertices and triangles GenerateMesh will emit. A cell has a vertex
+         * (one per sheet in manifold mode) exactly when its mask is mixed. The four cells around a crossed grid edge
+         * all contain that edge, so every quad MakeAllQuads' bounds rules let through gets its four vertices and
+         * the triangles are two per crossed cube edge 0, 1 or 2 the rules allow. Keep the rules here in step.
+         */
+        static FMeshCounts CountMesh(
+            const FDensityGridView& Grid,
+            const FIntVec3& MinBounds,
+            const FIntVec3& MaxBounds,
+            bool bManifold,
+            const TSlabVector<uint8_t>& CellMasks)
+        {
+            FMeshCounts Counts;
+            if (MaxBounds.X <= MinBounds.X)
+            {
+                return Counts;
+            }
+
+            int32_t NumQuads = 0;
+            for (int32_t z = MinBounds.Z; z < MaxBounds.Z; z++)
+            {
+                for (int32_t y = MinBounds.Y; y < MaxBounds.Y; y++)
+                {
+                    const uint8_t* Masks = CellMasks.data() + y * Grid.GridSize + z * Grid.GridSize * Grid.GridSize;
+
+                    // Plain bit arithmetic so the row vectorizes: cube edges 0, 1 and 2 join corner 0 to corners 1, 2
+                    // and 4, and a mask is mixed unless it is 0 or 255
+                    int32_t RowVertices = 0;
+                    int32_t CrossedX = 0;
+                    int32_t CrossedY = 0;
+                    int32_t CrossedZ = 0;
+                    for (int32_t x = MinBounds.X; x < MaxBounds.X; x++)
+                    {
+                        const uint8_t Mask = Masks[x];
+                        RowVertices += static_cast<uint8_t>(Mask + 1) > 1 ? 1 : 0;
+                        CrossedX += (Mask ^ (Mask >> 1)) & 1;
+                        CrossedY += (Mask ^ (Mask >> 2)) & 1;
+                        CrossedZ += (Mask ^ (Mask >> 4)) & 1;
+                    }
+
+                    // Same bounds rules as MakeAllQuads: the last cell emits no X quads, the first no Y or Z quads
+                    const uint8_t First = Masks[MinBounds.X];
+                    const uint8_t Last = Masks[MaxBounds.X - 1];
+                    CrossedX -= (Last ^ (Last >> 1)) & 1;
+                    CrossedY -= (First ^ (First >> 2)) & 1;
+                    CrossedZ -= (First ^ (First >> 4)) & 1;
+
+                    NumQuads += (y > MinBounds.Y && z > MinBounds.Z) ? CrossedX : 0;
+                    NumQuads += (z > MinBounds.Z && y < MaxBounds.Y - 1) ? CrossedY : 0;
+                    NumQuads += (y > MinBounds.Y && z < MaxBounds.Z - 1) ? CrossedZ : 0;
+
+                    if (bManifold && RowVertices != 0)
+                    {
+                        RowVertices = 0;
+                        for (int32_t x = MinBounds.X; x < MaxBounds.X; x++)
+                        {
+                            RowVertices += CellTopologyTable[Masks[x]].NumComponents;
+                        }
+                    }
+                    Counts.NumVertices += RowVertices;
+                }
+            }
+
+            Counts.NumTriangles = NumQuads * 2;
+            return Counts;
+        }
+
+        /** Phase 1: place one vertex in every cell the surface crosses (estimate_surface in Rust) */
+        template <typename TSink>
+        static void EstimateSurface(
+            const FDensityGridView& Grid,
+            const FIntVec3& MinBounds,
+            const FIntVec3& MaxBounds,
+            FSurfaceNetsScratch& Scratch,
+            TSink& Sink)
+        {
+            int32_t VertexIndex = 0;
+
+            for (int32_t z = MinBounds.Z; z < MaxBounds.Z; z++)
+            {
+                for (int32_t y = MinBounds.Y; y < MaxBounds.Y; y++)
+                {
+                    for (int32_t x = MinBounds.X; x < MaxBounds.X; x++)
+                    {
+                        const int32_t CellIndex = x + y * Grid.GridSize + z * Grid.GridSize * Grid.GridSize;
+                        const uint8_t Mask = Scratch.CellMasks[CellIndex];
+                        if (CellEdgeTable[Mask].NumEdges == 0)
+                        {
+                            continue;
+                        }
+
+                        Sink.AddVertex(CalculateVertexPosition(Grid, x, y, z, Mask), CalculateVertexNormal(Grid, x, y, z));
+
+                        Scratch.VertexGrid[CellIndex] = VertexIndex;
+                        VertexIndex++;
+                    }
+                }
+            }
+        }
+
+        /**
+         * Phase 1 with dual contouring placement: accumulate one QEF per surface cell from the edge crossings
+         * and the density gradient interpolated along each edge, solve the whole batch, then emit vertices
+         * in the same cell order as EstimateSurface.
+         */
+        template <typename TSink>
+        static void EstimateSurfaceQef(
+            const FDensityGridView& Grid,
+            const FIntVec3& MinBounds,
+            const FIntVec3& MaxBounds,
+            float MassPointWeight,
+            FSurfaceNetsScratch& Scratch,
+            TSink& Sink)
+        {
+            Scratch.SurfaceCells.clear();
+            Scratch.QefBatch.Reset();
+
+            for (int32_t z = MinBounds.Z; z < MaxBounds.Z; z++)
+            {
+                for (int32_t y = MinBounds.Y; y < MaxBounds.Y; y++)
+                {
+                    for (int32_t x = MinBounds.X; x < MaxBounds.X; x++)
+                    {
+                        const uint8_t Mask = Scratch.CellMasks[x + y * Grid.GridSize + z * Grid.GridSize * Grid.GridSize];
+                        if (CellEdgeTable[Mask].NumEdges == 0)
+                        {
+                            continue;
+                        }
+
+                        Scratch.SurfaceCells.push_back(FIntVec3(x, y, z));
+                        AccumulateCellQef(Grid, x, y, z, CellEdgeTable[Mask], Scratch.QefBatch);
+                    }
+                }
+            }
+
+            Scratch.QefBatch.Solve(MassPointWeight);
+
+            const FQefBatch& Batch = Scratch.QefBatch;
+            for (size_t i = 0; i < Scratch.SurfaceCells.size(); i++)
+            {
+                const FIntVec3& Cell = Scratch.SurfaceCells[i];
+                const FVec3 Offset(Batch.X[i], Batch.Y[i], Batch.Z[i]);
+
+                Sink.AddVertex(Grid.Origin + (FVec3(Cell.X, Cell.Y, Cell.Z) + Offset) * Grid.VoxelSize, CalculateVertexNormal(Grid, Cell.X, Cell.Y, Cell.Z));
+                Scratch.VertexGrid[Cell.X + Cell.Y * Grid.GridSize + Cell.Z * Grid.GridSize * Grid.GridSize] = static_cast<int32_t>(i);
+            }
+        }
+
+        /** Build the QEF of one surface cell in cell-local coordinates and append it to the batch */
+        static void AccumulateCellQef(const FDensityGridView& Grid, int32_t x, int32_t y, int32_t z, const FCellEdgeList& Crossings, FQefBatch& Batch)
+        {
+            float CornerDists[8];
+            FVec3 CornerGradients[8];
+            for (int32_t i = 0; i < 8; i++)
+            {
+                const int32_t Cx = x + CubeCorners[i][0];
+                const int32_t Cy = y + CubeCorners[i][1];
+                const int32_t Cz = z + CubeCorners[i][2];
+                CornerDists[i] = Grid.Get(Cx, Cy, Cz);
+                CornerGradients[i] = CalculateGradient(Grid, Cx, Cy, Cz);
+            }
+
+            const FVec3 MassPoint = CalculateCentroidOfEdgeIntersections(CornerDists, Crossings);
+
+            FQefBatch::FAccumulator Qef;
+            for (int32_t i = 0; i < Crossings.NumEdges; i++)
+            {
+                const int32_t Corner1 = CubeEdges[Crossings.Edges[i]][0];
+                const int32_t Corner2 = CubeEdges[Crossings.Edges[i]][1];
+
+                const float T = EdgeCrossingRatio(CornerDists[Corner1], CornerDists[Corner2]);
+                const FVec3 Point = Lerp(CornerVector(Corner1), CornerVector(Corner2), T) - MassPoint;
+
+                FVec3 Normal = Lerp(CornerGradients[Corner1], CornerGradients[Corner2], T);
+                if (!std::isfinite(Normal.SizeSquared()) || !Normal.Normalize())
+                {
+                    continue; // No usable plane, the mass point term covers it
+                }
+
+                Qef.AddPlane(
+                    static_cast<float>(Point.X), static_cast<float>(Point.Y), static_cast<float>(Point.Z),
+                    static_cast<float>(Normal.X), static_cast<float>(Normal.Y), static_cast<float>(Normal.Z));
+            }
+
+            Batch.Add(Qef, static_cast<float>(MassPoint.X), static_cast<float>(MassPoint.Y), static_cast<float>(MassPoint.Z));
+        }
+
+        /**
+         * Phase 1 in manifold mode: one vertex per surface sheet of each cell, placed at the centroid (or QEF
+         * solution) of that sheet's edge crossings, with the normal averaged from the gradients at those crossings.
+         * A cell's sheet vertices are consecutive and VertexGrid stores the first.
+         */
+        template <typename TSink>
+        static void EstimateSurfaceManifold(
+            const FDensityGridView& Grid,
+            const FIntVec3& MinBounds,
+            const FIntVec3& MaxBounds,
+            const FSurfaceNetsSettings& Settings,
+            FSurfaceNetsScratch& Scratch,
+            TSink& Sink)
+        {
+            Scratch.SurfaceCells.clear();
+            Scratch.SheetNormals.clear();
+            Scratch.QefBatch.Reset();
+
+            for (int32_t z = MinBounds.Z; z < MaxBounds.Z; z++)
+            {
+                for (int32_t y = MinBounds.Y; y < MaxBounds.Y; y++)
+                {
+                    for (int32_t x = MinBounds.X; x < MaxBounds.X; x++)
+                    {
+                        const int32_t CellIndex = x + y * Grid.GridSize + z * Grid.GridSize * Grid.GridSize;
+                        const uint8_t Mask = Scratch.CellMasks[CellIndex];
+                        if (CellEdgeTable[Mask].NumEdges == 0)
+                        {
+                            continue;
+                        }
+
+                        float CornerDists[8];
+                        FVec3 CornerGradients[8];
+                        for (int32_t i = 0; i < 8; i++)
+                        {
+                            const int32_t Cx = x + CubeCorners[i][0];
+                            const int32_t Cy = y + CubeCorners[i][1];
+                            const int32_t Cz = z + CubeCorners[i][2];
+                            CornerDists[i] = Grid.Get(Cx, Cy, Cz);
+                            CornerGradients[i] = CalculateGradient(Grid, Cx, Cy, Cz);
+                        }
+
+                        Scratch.VertexGrid[CellIndex] = static_cast<int32_t>(Scratch.SurfaceCells.size());
+
+                        const FCellTopology& Topology = CellTopologyTable[Mask];
+                        for (int32_t Sheet = 0; Sheet < Topology.NumComponents; Sheet++)
+                        {
+                            AccumulateSheet(CornerDists, CornerGradients, CellEdgeTable[Mask], Topology, Sheet, Scratch);
+                            Scratch.SurfaceCells.push_back(FIntVec3(x, y, z));
+                        }
+                    }
+                }
+            }
+
+            if (Settings.VertexPlacement == EVertexPlacement::Qef)
+            {
+                Scratch.QefBatch.Solve(Settings.QefMassPointWeight);
+            }
+
+            const FQefBatch& Batch = Scratch.QefBatch;
+            for (size_t i = 0; i < Scratch.SurfaceCells.size(); i++)
+            {
+                const FIntVec3& Cell = Scratch.SurfaceCells[i];
+                const FVec3 Offset(Batch.X[i], Batch.Y[i], Batch.Z[i]);
+                Sink.AddVertex(Grid.Origin + (FVec3(Cell.X, Cell.Y, Cell.Z) + Offset) * Grid.VoxelSize, Scratch.SheetNormals[i]);
+            }
+        }
+
+        /** Centroid, QEF and normal of one surface sheet; the centroid is stored as the batch's mass point */
+        static void AccumulateSheet(
+            const float CornerDists[8],
+            const FVec3 CornerGradients[8],
+            const FCellEdgeList& Crossings,
+            const FCellTopology& Topology,
+            int32_t Sheet,
+            FSurfaceNetsScratch& Scratch)
+        {
+            FVec3 Points[12];
+            FVec3 Normals[12];
+            int32_t NumPoints = 0;
+            FVec3 Centroid;
+            FVec3 SheetGradient;
+
+            for (int32_t i = 0; i < Crossings.NumEdges; i++)
+            {
+                const int32_t Edge = Crossings.Edges[i];
+                if (Topology.EdgeComponent[Edge] != Sheet)
+                {
+                    continue;
+                }
+
+                const int32_t Corner1 = CubeEdges[Edge][0];
+                const int32_t Corner2 = CubeEdges[Edge][1];
+                const float T = EdgeCrossingRatio(CornerDists[Corner1], CornerDists[Corner2]);
+
+                Points[NumPoints] = Lerp(CornerVector(Corner1), CornerVector(Corner2), T);
+                Normals[NumPoints] = Lerp(CornerGradients[Corner1], CornerGradients[Corner2], T);
+                if (!std::isfinite(Normals[NumPoints].SizeSquared()) || !Normals[NumPoints].Normalize())
+                {
+                    Normals[NumPoints] = FVec3();
+                }
+
+                Centroid += Points[NumPoints];
+                SheetGradient += Normals[NumPoints];
+                NumPoints++;
+            }
+
+            Centroid = Centroid / NumPoints;
+
+            FQefBatch::FAccumulator Qef;
+            for (int32_t i = 0; i < NumPoints; i++)
+            {
+                const FVec3 Point = Points[i] - Centroid;
+                Qef.AddPlane(
+                    static_cast<float>(Point.X), static_cast<float>(Point.Y), static_cast<float>(Point.Z),
+                    static_cast<float>(Normals[i].X), static_cast<float>(Normals[i].Y), static_cast<float>(Normals[i].Z));
+            }
+            Scratch.QefBatch.Add(Qef, static_cast<float>(Centroid.X), static_cast<float>(Centroid.Y), static_cast<float>(Centroid.Z));
+
+            // Negated for outward-pointing normals, like CalculateVertexNormal
+            SheetGradient.Normalize();
+            Scratch.SheetNormals.push_back(-SheetGradient);
+        }
+
+        /** Normal from the density gradient at the cell's min corner, negated for outward-pointing normals */
+        static FVec3 CalculateVertexNormal(const FDensityGridView& Grid, int32_t x, int32_t y, int32_t z)
+        {
+            FVec3 Normal = CalculateGradient(Grid, x, y, z);
+            if (!std::isfinite(Normal.SizeSquared()))
+            {
+                // A NaN sample poisons the central difference, emit a zero normal instead of NaN
+                Normal = FVec3();
+            }
+            Normal.Normalize();
+            return -Normal;
+        }
+
+        /**
+         * Phase 2: create all quads from surface vertices (make_all_quads in Rust).
+         * A quad needs the cells behind its edge, so edges on the min faces and the last layer before max are skipped.
+         * The grid edges leaving a cell's min corner are its cube edges 0, 1 and 2, so the cell mask's QuadAxes say
+         * which of them need a face. VertexAt(x, y, z, CubeEdge) returns the vertex of cell (x, y, z) on the given
+         * cube edge, or -1.
+         */
+        template <typename TVertexLookup, typename TSink>
+        static void MakeAllQuads(
+            const FDensityGridView& Grid,
+            const FIntVec3& MinBounds,
+            const FIntVec3& MaxBounds,
+            const TSlabVector<uint8_t>& CellMasks,
+            TVertexLookup&& VertexAt,
+            TSink& Sink)
+        {
+            for (int32_t z = MinBounds.Z; z < MaxBounds.Z; z++)
+            {
+                for (int32_t y = MinBounds.Y; y < MaxBounds.Y; y++)
+                {
+                    for (int32_t x = MinBounds.X; x < MaxBounds.X; x++)
+                    {
+                        const uint8_t Mask = CellMasks[x + y * Grid.GridSize + z * Grid.GridSize * Grid.GridSize];
+                        const uint8_t QuadAxes = CellEdgeTable[Mask].QuadAxes;
+                        if (QuadAxes == 0)
+                        {
+                            continue;
+                        }
+
+                        // Faces point away from the inside end of the edge; the min corner is corner 0
+                        const bool bNegativeFace = (Mask & 1) == 0;
+                        const FIntVec3 CubePos(x, y, z);
+
+                        // Do edges parallel with the X axis
+                        if ((QuadAxes & 1) && y > MinBounds.Y && z > MinBounds.Z && x < MaxBounds.X - 1)
+                        {
+                            MaybeCreateQuad(VertexAt, CubePos, FIntVec3(0, 1, 0), FIntVec3(0, 0, 1), QuadCellEdges[0], bNegativeFace, Sink);
+                        }
+
+                        // Do edges parallel with the Y axis
+                        if ((QuadAxes & 2) && x > MinBounds.X && z > MinBounds.Z && y < MaxBounds.Y - 1)
+                        {
+                            MaybeCreateQuad(VertexAt, CubePos, FIntVec3(0, 0, 1), FIntVec3(1, 0, 0), QuadCellEdges[1], bNegativeFace, Sink);
+                        }
+
+                        // Do edges parallel with the Z axis
+                        if ((QuadAxes & 4) && x > MinBounds.X && y > MinBounds.Y && z < MaxBounds.Z - 1)
+                        {
+                            MaybeCreateQuad(VertexAt, CubePos, FIntVec3(1, 0, 0), FIntVec3(0, 1, 0), QuadCellEdges[2], bNegativeFace, Sink);
+                        }
+                    }
+                }
+            }
+        }
+
+        /** Create the quad around a crossed grid edge starting at P1, if all four cells around it have a vertex */
+        template <typename TVertexLookup, typename TSink>
+        static void MaybeCreateQuad(
+            TVertexLookup&& VertexAt,
+            const FIntVec3& P1,
+            const FIntVec3& AxisB,
+            const FIntVec3& AxisC,
+            const int32_t (&CellEdges)[4],
+            bool bNegativeFace,
+            TSink& Sink)
+        {
+            // Get the four vertices of the quad
+            const int32_t V1 = VertexAt(P1.X, P1.Y, P1.Z, CellEdges[0]);
+            const int32_t V2 = VertexAt(P1.X - AxisB.X, P1.Y - AxisB.Y, P1.Z - AxisB.Z, CellEdges[1]);
+            const int32_t V3 = VertexAt(P1.X - AxisC.X, P1.Y - AxisC.Y, P1.Z - AxisC.Z, CellEdges[2]);
+            const int32_t V4 = VertexAt(P1.X - AxisB.X - AxisC.X, P1.Y - AxisB.Y - AxisC.Y, P1.Z - AxisB.Z - AxisC.Z, CellEdges[3]);
+
+            // Validate all vertices exist
+            if (V1 == -1 || V2 == -1 || V3 == -1 || V4 == -1)
+            {
+                return;
+            }
+
+            // Reversed winding order for Unreal Engine (clockwise for front-facing)
+            if (bNegativeFace)
+            {
+                Sink.AddTriangle(V1, V2, V4);
+                Sink.AddTriangle(V1, V4, V3);
+            }
+            else
+            {
+                Sink.AddTriangle(V1, V4, V2);
+                Sink.AddTriangle(V1, V3, V4);
+            }
+        }
+
+        /** Vertex position using the centroid of the cell's edge crossings, Mask being the cell's corner sign mask */
+        static FVec3 CalculateVertexPosition(const FDensityGridView& Grid, int32_t x, int32_t y, int32_t z, uint8_t Mask)
+        {
+            // Get the signed distance values at each corner of this cube
+            float CornerDists[8];
+            for (int32_t i = 0; i < 8; i++)
+            {
+                CornerDists[i] = Grid.Get(x + CubeCorners[i][0], y + CubeCorners[i][1], z + CubeCorners[i][2]);
+            }
+
+            return Grid.Origin + (FVec3(x, y, z) + CalculateCentroidOfEdgeIntersections(CornerDists, CellEdgeTable[Mask])) * Grid.VoxelSize;
+        }
+
+        /** Average of the zero crossings on the cell's crossing edges, in cell-local [0, 1]³ */
+        static FVec3 CalculateCentroidOfEdgeIntersections(const float CornerDists[8], const FCellEdgeList& Crossings)
+        {
+            if (Crossings.NumEdges == 0)
+            {
+                // No surface crossing, fallback to cube center
+                return FVec3(0.5);
+            }
+
+            FVec3 Sum;
+            for (int32_t i = 0; i < Crossings.NumEdges; i++)
+            {
+                const int32_t Corner1 = CubeEdges[Crossings.Edges[i]][0];
+                const int32_t Corner2 = CubeEdges[Crossings.Edges[i]][1];
+                Sum += EstimateSurfaceEdgeIntersection(Corner1, Corner2, CornerDists[Corner1], CornerDists[Corner2]);
+            }
+
+            return Sum / Crossings.NumEdges;
+        }
+
+        /** Linear interpolation to find the zero crossing between two corners */
+        static FVec3 EstimateSurfaceEdgeIntersection(int32_t Corner1, int32_t Corner2, float Value1, float Value2)
+        {
+            return Lerp(CornerVector(Corner1), CornerVector(Corner2), EdgeCrossingRatio(Value1, Value2));
+        }
+
+        /** Fraction along an edge where the density crosses zero */
+        static float EdgeCrossingRatio(float Value1, float Value2)
+        {
+            // Clamp like FMath::Clamp so a NaN ratio lands on the far corner instead of propagating
+            const float Ratio = -Value1 / (Value2 - Value1);
+            return Ratio < 0.0f ? 0.0f : (Ratio < 1.0f ? Ratio : 1.0f);
+        }
+
+        /** Central-difference density gradient at a grid point */
+        static FVec3 CalculateGradient(const FDensityGridView& Grid, int32_t x, int32_t y, int32_t z)
+        {
+            return FVec3(
+                Grid.Get(x + 1, y, z) - Grid.Get(x - 1, y, z),
+                Grid.Get(x, y + 1, z) - Grid.Get(x, y - 1, z),
+                Grid.Get(x, y, z + 1) - Grid.Get(x, y, z - 1));
+        }
+
+        /** Get vertex index from vertex grid, -1 outside the grid or for cells without a vertex */
+        static int32_t GetVertexIndex(int32_t GridSize, const TSlabVector<int32_t>& VertexGrid, int32_t x, int32_t y, int32_t z)
+        {
+            if (x < 0 || x >= GridSize || y < 0 || y >= GridSize || z < 0 || z >= GridSize)
+            {
+                return -1;
+            }
+            return VertexGrid[x + y * GridSize + z * GridSize * GridSize];
+        }
+
+        static constexpr FVec3 CornerVector(int32_t Corner)
+        {
+            return FVec3(CubeCorners[Corner][0], CubeCorners[Corner][1], CubeCorners[Corner][2]);
+        }
+    };
+}
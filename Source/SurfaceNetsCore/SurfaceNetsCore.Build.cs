@@ -0,0 +1,13 @@
+using System.IO;
+using UnrealBuildTool;
+
+public class SurfaceNetsCore : ModuleRules
+{
+	public SurfaceNetsCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		// Header-only, engine-independent algorithms shared with the plain CMake build
+		Type = ModuleType.External;
+
+		PublicIncludePaths.Add(Path.Combine(ModuleDirectory, "Include"));
+	}
+}
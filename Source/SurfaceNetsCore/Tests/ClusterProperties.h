@@ -0,0 +1,340 @@
+#pragma once
+
+#include "SurfaceNetsCore/ClusterBuilder.h"
+#include "SurfaceNetsCore/MeshLayout.h"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+/**
+ * Cluster hierarchy properties: FClusterBuilder runs on one mesh and every promise of FMeshCluster and
+ * FClusterHierarchy is checked against the output, each broken one reported on stderr.
+ */
+namespace SurfaceNetsCore::Tests
+{
+    class FClusterPropertyChecker
+    {
+    public:
+        explicit FClusterPropertyChecker(const char* InMeshName) : MeshName(InMeshName) {}
+
+        int32_t GetNumFailures() const { return NumFailures; }
+
+        /**
+         * Build Mesh into clusters, then check cluster limits and ranges, level 0 against the input triangles,
+         * level errors against the full-detail vertices, parent links, child lists, LOD sphere nesting, that
+         * error-based selection picks exactly one cluster along every path, and the serialization round trip.
+         */
+        void CheckHierarchy(const FMeshBuffers& Mesh, const FClusterBuildSettings& Settings, std::mt19937& Random)
+        {
+            FClusterBuilder::Build(
+                Mesh.Positions.data(), Mesh.Normals.data(), Mesh.NumVertices(),
+                Mesh.Indices.data(), Mesh.Indices.size(), Settings, Hierarchy);
+
+            if (!CheckLayout(Settings))
+            {
+                // Later checks index with the ranges
+                return;
+            }
+            CheckFullDetailLevel(Mesh);
+            CheckLevelErrors(Mesh, Settings);
+            CheckLinks();
+            CheckSelection(Random);
+            CheckSerialization();
+        }
+
+    private:
+        /** Level and cluster ranges tile their arrays in order, within the cluster limits */
+        bool CheckLayout(const FClusterBuildSettings& Settings)
+        {
+            const std::vector<int32_t>& LevelOffsets = Hierarchy.LevelOffsets;
+            if (!Expect(LevelOffsets.size() >= 2 && LevelOffsets.front() == 0 && LevelOffsets.back() == static_cast<int32_t>(Hierarchy.Clusters.size()),
+                "level offsets do not cover the clusters"))
+            {
+                return false;
+            }
+            Expect(Hierarchy.NumLevels() <= std::max(Settings.MaxLevels, 1), "more levels than MaxLevels");
+
+            uint32_t NextVertex = 0;
+            uint32_t NextIndex = 0;
+            bool bValid = true;
+            for (int32_t Level = 0; Level < Hierarchy.NumLevels(); Level++)
+            {
+                bValid &= Expect(LevelOffsets[Level] <= LevelOffsets[Level + 1], "level offsets decrease");
+                for (int32_t Index = LevelOffsets[Level]; Index < LevelOffsets[Level + 1]; Index++)
+                {
+                    const FMeshCluster& Cluster = Hierarchy.Clusters[Index];
+                    Expect(Cluster.Level == Level, "cluster stored under another level");
+                    Expect(Cluster.NumTriangles >= 1 && Cluster.NumTriangles <= static_cast<uint32_t>(Settings.MaxTriangles), "cluster triangle count outside [1, MaxTriangles]");
+                    Expect(Cluster.NumVertices >= 3 && Cluster.NumVertices <= static_cast<uint32_t>(std::min(Settings.MaxVertices, 256)), "cluster vertex count outside [3, MaxVertices]");
+
+                    bValid &= Expect(Cluster.FirstVertex == NextVertex && Cluster.FirstIndex == NextIndex, "cluster ranges are not contiguous");
+                    NextVertex = Cluster.FirstVertex + Cluster.NumVertices;
+                    NextIndex = Cluster.FirstIndex + Cluster.NumTriangles * 3;
+                    bValid &= Expect(NextVertex <= Hierarchy.Positions.size() && NextIndex <= Hierarchy.Indices.size(), "cluster range past the end of its array");
+                    if (!bValid)
+                    {
+                        return false;
+                    }
+
+                    std::vector<bool> bReferenced(Cluster.NumVertices, false);
+                    for (uint32_t i = Cluster.FirstIndex; i < NextIndex; i++)
+                    {
+                        if (!Expect(Hierarchy.Indices[i] < Cluster.NumVertices, "local index outside the cluster's vertices"))
+                        {
+                            return false;
+                        }
+                        bReferenced[Hierarchy.Indices[i]] = true;
+                    }
+                    Expect(std::all_of(bReferenced.begin(), bReferenced.end(), [](bool b) { return b; }), "cluster vertex no triangle uses");
+
+                    for (uint32_t Vertex = Cluster.FirstVertex; Vertex < NextVertex; Vertex++)
+                    {
+                        const FVec3& Position = Hierarchy.Positions[Vertex];
+                        Expect(Position.X >= Cluster.BoundsMin.X && Position.Y >= Cluster.BoundsMin.Y && Position.Z >= Cluster.BoundsMin.Z &&
+                            Position.X <= Cluster.BoundsMax.X && Position.Y <= Cluster.BoundsMax.Y && Position.Z <= Cluster.BoundsMax.Z,
+                            "cluster vertex outside the cluster bounds");
+                    }
+                    for (int32_t Corner = 0; Corner < 8; Corner++)
+                    {
+                        const FVec3 BoundsCorner(
+                            Corner & 1 ? Cluster.BoundsMax.X : Cluster.BoundsMin.X,
+                            Corner & 2 ? Cluster.BoundsMax.Y : Cluster.BoundsMin.Y,
+                            Corner & 4 ? Cluster.BoundsMax.Z : Cluster.BoundsMin.Z);
+                        Expect((BoundsCorner - Cluster.LodCenter).Size() <= Cluster.LodRadius * (1.0 + 1e-9) + 1e-9, "LOD sphere does not enclose the cluster bounds");
+                    }
+                }
+            }
+            return Expect(NextVertex == Hierarchy.Positions.size() && NextIndex == Hierarchy.Indices.size(), "arrays hold data no cluster owns");
+        }
+
+        /** Level 0 holds exactly the input triangles, winding included */
+        void CheckFullDetailLevel(const FMeshBuffers& Mesh)
+        {
+            std::vector<FTriangleKey> Input;
+            for (size_t i = 0; i + 2 < Mesh.Indices.size(); i += 3)
+            {
+                Input.push_back(MakeTriangleKey(Mesh.Positions[Mesh.Indices[i]], Mesh.Positions[Mesh.Indices[i + 1]], Mesh.Positions[Mesh.Indices[i + 2]]));
+            }
+
+            std::vector<FTriangleKey> Clustered;
+            for (int32_t Index = Hierarchy.LevelOffsets[0]; Index < Hierarchy.LevelOffsets[1]; Index++)
+            {
+                const FMeshCluster& Cluster = Hierarchy.Clusters[Index];
+                const FVec3* Positions = &Hierarchy.Positions[Cluster.FirstVertex];
+                for (uint32_t i = Cluster.FirstIndex; i < Cluster.FirstIndex + Cluster.NumTriangles * 3; i += 3)
+                {
+                    Clustered.push_back(MakeTriangleKey(Positions[Hierarchy.Indices[i]], Positions[Hierarchy.Indices[i + 1]], Positions[Hierarchy.Indices[i + 2]]));
+                }
+                Expect(Cluster.Error == 0.0f, "level 0 cluster with a nonzero error");
+            }
+
+            std::sort(Input.begin(), Input.end());
+            std::sort(Clustered.begin(), Clustered.end());
+            Expect(Input == Clustered, "level 0 triangles differ from the input mesh");
+        }
+
+        /**
+         * Levels shrink by MinReduction, share one error that grows with the level, and keep every vertex within
+         * that error of a full-detail vertex
+         */
+        void CheckLevelErrors(const FMeshBuffers& Mesh, const FClusterBuildSettings& Settings)
+        {
+            for (int32_t Level = 1; Level < Hierarchy.NumLevels(); Level++)
+            {
+                Expect(Hierarchy.NumTriangles(Level) <= Hierarchy.NumTriangles(Level - 1) * Settings.MinReduction, "coarser level kept more than MinReduction");
+                const float LevelError = Hierarchy.Clusters[Hierarchy.LevelOffsets[Level]].Error;
+                Expect(LevelError > Hierarchy.Clusters[Hierarchy.LevelOffsets[Level - 1]].Error, "coarser level without a larger error");
+                for (int32_t Index = Hierarchy.LevelOffsets[Level]; Index < Hierarchy.LevelOffsets[Level + 1]; Index++)
+                {
+                    const FMeshCluster& Cluster = Hierarchy.Clusters[Index];
+                    Expect(Cluster.Error == LevelError, "clusters of one level with different errors");
+
+                    for (uint32_t Vertex = Cluster.FirstVertex; Vertex < Cluster.FirstVertex + Cluster.NumVertices; Vertex++)
+                    {
+                        double Nearest = DBL_MAX;
+                        for (const FVec3& Position : Mesh.Positions)
+                        {
+                            Nearest = std::min(Nearest, (Hierarchy.Positions[Vertex] - Position).SizeSquared());
+                        }
+                        if (!Expect(std::sqrt(Nearest) <= Cluster.Error * (1.0 + 1e-5), "vertex moved further than the level error"))
+                        {
+                            return;
+                        }
+                    }
+                }
+            }
+        }
+
+        /** Parents sit one level up and carry ParentError, child lists match, and LOD spheres nest */
+        void CheckLinks()
+        {
+            const int32_t NumLevels = Hierarchy.NumLevels();
+            for (size_t Index = 0; Index < Hierarchy.Clusters.size(); Index++)
+            {
+                const FMeshCluster& Cluster = Hierarchy.Clusters[Index];
+                const bool bCoarsest = Cluster.Level == NumLevels - 1;
+                if (bCoarsest)
+                {
+                    Expect(Cluster.Parent == -1 && Cluster.ParentError == FLT_MAX, "coarsest cluster with a parent");
+                    continue;
+                }
+
+                if (!Expect(Cluster.Parent >= Hierarchy.LevelOffsets[Cluster.Level + 1] && Cluster.Parent < Hierarchy.LevelOffsets[Cluster.Level + 2],
+                    "parent is not on the next level"))
+                {
+                    continue;
+                }
+
+                const FMeshCluster& Parent = Hierarchy.Clusters[Cluster.Parent];
+                Expect(Cluster.ParentError == Parent.Error && Cluster.Error <= Cluster.ParentError, "ParentError is not the parent's larger error");
+                Expect((Parent.LodCenter - Cluster.LodCenter).Size() + Cluster.LodRadius <= Parent.LodRadius * (1.0 + 1e-9) + 1e-9,
+                    "parent LOD sphere does not enclose the child's");
+            }
+
+            for (size_t Index = 0; Index < Hierarchy.Clusters.size(); Index++)
+            {
+                std::vector<int32_t> Expected;
+                for (size_t Child = 0; Child < Hierarchy.Clusters.size(); Child++)
+                {
+                    if (Hierarchy.Clusters[Child].Parent == static_cast<int32_t>(Index))
+                    {
+                        Expected.push_back(static_cast<int32_t>(Child));
+                    }
+                }
+                std::vector<int32_t> Listed(Hierarchy.Children.begin() + Hierarchy.ChildOffsets[Index], Hierarchy.Children.begin() + Hierarchy.ChildOffsets[Index + 1]);
+                std::sort(Listed.begin(), Listed.end());
+                Expect(Listed == Expected, "child list differs from the parent links");
+            }
+        }
+
+        /**
+         * A renderer draws a cluster when its error projected from its LOD sphere fits and its parent's does not;
+         * from random viewpoints and thresholds, every full-detail cluster must have exactly one drawn cluster on
+         * its path to the root.
+         */
+        void CheckSelection(std::mt19937& Random)
+        {
+            FVec3 Min(DBL_MAX);
+            FVec3 Max(-DBL_MAX);
+            for (const FVec3& Position : Hierarchy.Positions)
+            {
+                Min = FVec3(std::min(Min.X, Position.X), std::min(Min.Y, Position.Y), std::min(Min.Z, Position.Z));
+                Max = FVec3(std::max(Max.X, Position.X), std::max(Max.Y, Position.Y), std::max(Max.Z, Position.Z));
+            }
+            const FVec3 Center = (Min + Max) * 0.5;
+            const double Radius = (Max - Min).Size() * 0.5;
+
+            std::uniform_real_distribution<double> Unit(-1.0, 1.0);
+            std::uniform_real_distribution<double> Threshold(0.0, 0.5);
+
+            auto ProjectedError = [](float Error, const FMeshCluster& Sphere, const FVec3& Viewpoint)
+            {
+                if (Error == FLT_MAX)
+                {
+                    return static_cast<double>(FLT_MAX);
+                }
+                const double Distance = (Sphere.LodCenter - Viewpoint).Size() - Sphere.LodRadius;
+                return Error / std::max(Distance, 1e-6);
+            };
+
+            for (int32_t View = 0; View < 8; View++)
+            {
+                const FVec3 Viewpoint = Center + FVec3(Unit(Random), Unit(Random), Unit(Random)) * (Radius * 3.0);
+                const double MaxError = Threshold(Random);
+                for (int32_t Leaf = Hierarchy.LevelOffsets[0]; Leaf < Hierarchy.LevelOffsets[1]; Leaf++)
+                {
+                    int32_t NumDrawn = 0;
+                    for (int32_t Index = Leaf; Index >= 0; Index = Hierarchy.Clusters[Index].Parent)
+                    {
+                        const FMeshCluster& Cluster = Hierarchy.Clusters[Index];
+                        const FMeshCluster& ParentSphere = Cluster.Parent >= 0 ? Hierarchy.Clusters[Cluster.Parent] : Cluster;
+                        NumDrawn += ProjectedError(Cluster.Error, Cluster, Viewpoint) <= MaxError &&
+                            ProjectedError(Cluster.ParentError, ParentSphere, Viewpoint) > MaxError ? 1 : 0;
+                    }
+                    if (!Expect(NumDrawn == 1, "LOD selection does not draw exactly one cluster along a path"))
+                    {
+                        return;
+                    }
+                }
+            }
+        }
+
+        /** Serialize and Deserialize round trip, and truncated blobs are rejected */
+        void CheckSerialization()
+        {
+            std::vector<uint8_t> Blob;
+            Hierarchy.Serialize(Blob);
+
+            FClusterHierarchy Loaded;
+            if (!Expect(Loaded.Deserialize(Blob.data(), Blob.size()), "serialized hierarchy does not load"))
+            {
+                return;
+            }
+
+            // The blob stores floats, so loaded vectors are compared at float precision
+            auto NearFloat = [](const FVec3& A, const FVec3& B)
+            {
+                return static_cast<float>(A.X) == static_cast<float>(B.X) && static_cast<float>(A.Y) == static_cast<float>(B.Y) && static_cast<float>(A.Z) == static_cast<float>(B.Z);
+            };
+            bool bSame = Loaded.Clusters.size() == Hierarchy.Clusters.size() && Loaded.Positions.size() == Hierarchy.Positions.size() &&
+                Loaded.Indices == Hierarchy.Indices && Loaded.LevelOffsets == Hierarchy.LevelOffsets &&
+                Loaded.ChildOffsets == Hierarchy.ChildOffsets && Loaded.Children == Hierarchy.Children;
+            for (size_t Index = 0; bSame && Index < Hierarchy.Clusters.size(); Index++)
+            {
+                const FMeshCluster& A = Hierarchy.Clusters[Index];
+                const FMeshCluster& B = Loaded.Clusters[Index];
+                bSame = A.Level == B.Level && A.FirstVertex == B.FirstVertex && A.NumVertices == B.NumVertices &&
+                    A.FirstIndex == B.FirstIndex && A.NumTriangles == B.NumTriangles && A.Parent == B.Parent &&
+                    A.Error == B.Error && A.ParentError == B.ParentError && static_cast<float>(A.LodRadius) == static_cast<float>(B.LodRadius) &&
+                    NearFloat(A.BoundsMin, B.BoundsMin) && NearFloat(A.BoundsMax, B.BoundsMax) && NearFloat(A.LodCenter, B.LodCenter);
+            }
+            for (size_t Vertex = 0; bSame && Vertex < Hierarchy.Positions.size(); Vertex++)
+            {
+                bSame = NearFloat(Hierarchy.Positions[Vertex], Loaded.Positions[Vertex]) && NearFloat(Hierarchy.Normals[Vertex], Loaded.Normals[Vertex]);
+            }
+            Expect(bSame, "hierarchy changes over a serialization round trip");
+
+            for (const size_t Size : { size_t(0), Blob.size() / 3, Blob.size() / 2, Blob.size() - 1 })
+            {
+                Expect(!Loaded.Deserialize(Blob.data(), Size) && Loaded.Clusters.empty(), "truncated blob loads");
+            }
+        }
+
+        /** Triangle as its corner positions, rotated to start at the smallest so the winding is kept */
+        using FTriangleKey = std::array<double, 9>;
+
+        static FTriangleKey MakeTriangleKey(const FVec3& A, const FVec3& B, const FVec3& C)
+        {
+            const std::array<double, 3> Corners[3] = { { A.X, A.Y, A.Z }, { B.X, B.Y, B.Z }, { C.X, C.Y, C.Z } };
+            const int32_t First = static_cast<int32_t>(std::min_element(std::begin(Corners), std::end(Corners)) - std::begin(Corners));
+
+            FTriangleKey Key;
+            for (int32_t Corner = 0; Corner < 3; Corner++)
+            {
+                std::copy(Corners[(First + Corner) % 3].begin(), Corners[(First + Corner) % 3].end(), Key.begin() + Corner * 3);
+            }
+            return Key;
+        }
+
+        bool Expect(bool bCondition, const char* What)
+        {
+            if (!bCondition)
+            {
+                NumFailures++;
+                std::fprintf(stderr, "  %s: %s\n", MeshName, What);
+            }
+            return bCondition;
+        }
+
+        const char* MeshName;
+        int32_t NumFailures = 0;
+
+        FClusterHierarchy Hierarchy;
+    };
+}
@@ -0,0 +1,327 @@
+#pragma once
+
+#include "SurfaceNetsCore/MarchingCubesMesher.h"
+#include "SurfaceNetsCore/MeshLayout.h"
+#include "SurfaceNetsCore/MeshValidation.h"
+#include "SurfaceNetsCore/QefSolver.h"
+#include "SurfaceNetsCore/SurfaceNetsMesher.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Mesher properties shared by the property tests and the fuzz target. Every check runs the optimized meshers
+ * on one grid and reports each broken property on stderr, so a failing input explains itself.
+ */
+namespace SurfaceNetsCore::Tests
+{
+    /**
+     * Straightforward Surface Nets without cell masks, tables, counting or batched QEF solves: corners read
+     * one at a time, crossings found by testing all 12 edges, quads built per crossed grid edge. The optimized
+     * mesher must emit the same vertices and indices outside manifold mode.
+     */
+    struct FReferenceSurfaceNets
+    {
+        static void GenerateMesh(
+            const FDensityGridView& Grid,
+            const FIntVec3& MinBounds,
+            const FIntVec3& MaxBounds,
+            const FSurfaceNetsSettings& Settings,
+            FMeshBuffers& Mesh)
+        {
+            const int32_t GridSize = Grid.GridSize;
+            std::vector<int32_t> VertexGrid(static_cast<size_t>(GridSize) * GridSize * GridSize, -1);
+            Mesh.Reset();
+
+            for (int32_t z = MinBounds.Z; z < MaxBounds.Z; z++)
+            {
+                for (int32_t y = MinBounds.Y; y < MaxBounds.Y; y++)
+                {
+                    for (int32_t x = MinBounds.X; x < MaxBounds.X; x++)
+                    {
+                        FVec3 Offset;
+                        if (!PlaceVertex(Grid, x, y, z, Settings, Offset))
+                        {
+                            continue;
+                        }
+
+                        VertexGrid[x + y * GridSize + z * GridSize * GridSize] = Mesh.NumVertices();
+                        Mesh.AddVertex(
+                            Grid.Origin + (FVec3(x, y, z) + Offset) * Grid.VoxelSize,
+                            FSurfaceNetsMesher::CalculateVertexNormal(Grid, x, y, z));
+                    }
+                }
+            }
+
+            auto VertexAt = [&VertexGrid, GridSize](int32_t x, int32_t y, int32_t z)
+            {
+                return x < 0 || y < 0 || z < 0 ? -1 : VertexGrid[x + y * GridSize + z * GridSize * GridSize];
+            };
+
+            for (int32_t z = MinBounds.Z; z < MaxBounds.Z; z++)
+            {
+                for (int32_t y = MinBounds.Y; y < MaxBounds.Y; y++)
+                {
+                    for (int32_t x = MinBounds.X; x < MaxBounds.X; x++)
+                    {
+                        const bool bInside = IsInside(Grid.Get(x, y, z));
+                        const bool bFaceX = y > MinBounds.Y && z > MinBounds.Z && x < MaxBounds.X - 1;
+                        const bool bFaceY = x > MinBounds.X && z > MinBounds.Z && y < MaxBounds.Y - 1;
+                        const bool bFaceZ = x > MinBounds.X && y > MinBounds.Y && z < MaxBounds.Z - 1;
+
+                        if (bFaceX && bInside != IsInside(Grid.Get(x + 1, y, z)))
+                        {
+                            AddQuad(VertexAt(x, y, z), VertexAt(x, y - 1, z), VertexAt(x, y, z - 1), VertexAt(x, y - 1, z - 1), !bInside, Mesh);
+                        }
+                        if (bFaceY && bInside != IsInside(Grid.Get(x, y + 1, z)))
+                        {
+                            AddQuad(VertexAt(x, y, z), VertexAt(x, y, z - 1), VertexAt(x - 1, y, z), VertexAt(x - 1, y, z - 1), !bInside, Mesh);
+                        }
+                        if (bFaceZ && bInside != IsInside(Grid.Get(x, y, z + 1)))
+                        {
+                            AddQuad(VertexAt(x, y, z), VertexAt(x - 1, y, z), VertexAt(x, y - 1, z), VertexAt(x - 1, y - 1, z), !bInside, Mesh);
+                        }
+                    }
+                }
+            }
+        }
+
+        /** Cell-local vertex of a surface cell, false when no edge of the cell is crossed */
+        static bool PlaceVertex(const FDensityGridView& Grid, int32_t x, int32_t y, int32_t z, const FSurfaceNetsSettings& Settings, FVec3& OutOffset)
+        {
+            float CornerDists[8];
+            FVec3 CornerGradients[8];
+            for (int32_t i = 0; i < 8; i++)
+            {
+                CornerDists[i] = Grid.Get(x + CubeCorners[i][0], y + CubeCorners[i][1], z + CubeCorners[i][2]);
+                CornerGradients[i] = FSurfaceNetsMesher::CalculateGradient(Grid, x + CubeCorners[i][0], y + CubeCorners[i][1], z + CubeCorners[i][2]);
+            }
+
+            FVec3 Points[12];
+            float Ratios[12];
+            int32_t Edges[12];
+            int32_t NumCrossings = 0;
+            FVec3 Centroid;
+            for (int32_t Edge = 0; Edge < 12; Edge++)
+            {
+                const int32_t Corner1 = CubeEdges[Edge][0];
+                const int32_t Corner2 = CubeEdges[Edge][1];
+                if (IsInside(CornerDists[Corner1]) == IsInside(CornerDists[Corner2]))
+                {
+                    continue;
+                }
+
+                Ratios[NumCrossings] = FSurfaceNetsMesher::EdgeCrossingRatio(CornerDists[Corner1], CornerDists[Corner2]);
+                Points[NumCrossings] = Lerp(FSurfaceNetsMesher::CornerVector(Corner1), FSurfaceNetsMesher::CornerVector(Corner2), Ratios[NumCrossings]);
+                Edges[NumCrossings] = Edge;
+                Centroid += Points[NumCrossings];
+                NumCrossings++;
+            }
+
+            if (NumCrossings == 0)
+            {
+                return false;
+            }
+
+            Centroid = Centroid / NumCrossings;
+            OutOffset = Centroid;
+            if (Settings.VertexPlacement != EVertexPlacement::Qef)
+            {
+                return true;
+            }
+
+            FQefBatch::FAccumulator Qef;
+            for (int32_t i = 0; i < NumCrossings; i++)
+            {
+                FVec3 Normal = Lerp(CornerGradients[CubeEdges[Edges[i]][0]], CornerGradients[CubeEdges[Edges[i]][1]], Ratios[i]);
+                if (!std::isfinite(Normal.SizeSquared()) || !Normal.Normalize())
+                {
+                    continue;
+                }
+
+                const FVec3 Point = Points[i] - Centroid;
+                Qef.AddPlane(
+                    static_cast<float>(Point.X), static_cast<float>(Point.Y), static_cast<float>(Point.Z),
+                    static_cast<float>(Normal.X), static_cast<float>(Normal.Y), static_cast<float>(Normal.Z));
+            }
+
+            // A batch of one, so the batched solve is checked against cells solved on their own
+            FQefBatch Batch;
+            Batch.Add(Qef, static_cast<float>(Centroid.X), static_cast<float>(Centroid.Y), static_cast<float>(Centroid.Z));
+            Batch.Solve(Settings.QefMassPointWeight);
+            OutOffset = FVec3(Batch.X[0], Batch.Y[0], Batch.Z[0]);
+            return true;
+        }
+
+        /** Same winding as FSurfaceNetsMesher::MaybeCreateQuad */
+        static void AddQuad(int32_t V1, int32_t V2, int32_t V3, int32_t V4, bool bNegativeFace, FMeshBuffers& Mesh)
+        {
+            if (V1 == -1 || V2 == -1 || V3 == -1 || V4 == -1)
+            {
+                return;
+            }
+
+            if (bNegativeFace)
+            {
+                Mesh.AddTriangle(V1, V2, V4);
+                Mesh.AddTriangle(V1, V4, V3);
+            }
+            else
+            {
+                Mesh.AddTriangle(V1, V4, V2);
+                Mesh.AddTriangle(V1, V3, V4);
+            }
+        }
+    };
+
+    /** Sink wrapper checking the Allocate contract: called once, before any Add, with exactly the counts that follow */
+    template <typename TSink>
+    struct TCountCheckingSink
+    {
+        TSink& Inner;
+        int32_t NumAllocateCalls = 0;
+        bool bAddedBeforeAllocate = false;
+        FMeshCounts Allocated;
+        FMeshCounts Added;
+
+        explicit TCountCheckingSink(TSink& InInner) : Inner(InInner) {}
+
+        void Allocate(int32_t NumVertices, int32_t NumTriangles)
+        {
+            NumAllocateCalls++;
+            Allocated.NumVertices = NumVertices;
+            Allocated.NumTriangles = NumTriangles;
+            Inner.Allocate(NumVertices, NumTriangles);
+        }
+
+        void AddVertex(const FVec3& Position, const FVec3& Normal)
+        {
+            bAddedBeforeAllocate |= NumAllocateCalls == 0;
+            Added.NumVertices++;
+            Inner.AddVertex(Position, Normal);
+        }
+
+        void AddTriangle(int32_t A, int32_t B, int32_t C)
+        {
+            bAddedBeforeAllocate |= NumAllocateCalls == 0;
+            Added.NumTriangles++;
+            Inner.AddTriangle(A, B, C);
+        }
+
+        bool IsExact() const
+        {
+            return NumAllocateCalls == 1 && !bAddedBeforeAllocate &&
+                Allocated.NumVertices == Added.NumVertices && Allocated.NumTriangles == Added.NumTriangles;
+        }
+    };
+
+    /** Which guarantees a grid can demand on top of the ones every grid gets */
+    struct FMeshExpectations
+    {
+        /**
+         * The surface is closed and clear of the min-face padding: no mesher leaves a boundary edge and marching
+         * cubes is watertight. Surface Nets may still repeat an edge at a sub-voxel tunnel, even in manifold mode.
+         */
+        bool bClosedSurface = false;
+
+        /** Smooth closed field without thin features, where every Surface Nets mode is watertight too */
+        bool bSmoothSurface = false;
+    };
+
+    class FMeshPropertyChecker
+    {
+    public:
+        explicit FMeshPropertyChecker(const char* InGridName) : GridName(InGridName) {}
+
+        int32_t GetNumFailures() const { return NumFailures; }
+
+        /**
+         * Mesh Grid in [MinBounds, MaxBounds) with every Surface Nets placement and manifold mode, then with marching
+         * cubes, checking exact Allocate counts, ValidateMesh, identical output through the per-component sink, the
+         * reference mesher outside manifold mode, and closed or watertight output where Expectations promise it.
+         */
+        void CheckAllMeshers(const FDensityGridView& Grid, const FIntVec3& MinBounds, const FIntVec3& MaxBounds, const FMeshExpectations& Expectations = FMeshExpectations())
+        {
+            for (const EVertexPlacement Placement : { EVertexPlacement::Centroid, EVertexPlacement::Qef })
+            {
+                for (const bool bManifold : { false, true })
+                {
+                    FSurfaceNetsSettings Settings;
+                    Settings.VertexPlacement = Placement;
+                    Settings.bManifold = bManifold;
+
+                    MesherName = Placement == EVertexPlacement::Qef
+                        ? (bManifold ? "SurfaceNets/Qef/Manifold" : "SurfaceNets/Qef")
+                        : (bManifold ? "SurfaceNets/Centroid/Manifold" : "SurfaceNets/Centroid");
+
+                    CheckMesher(Expectations.bClosedSurface, Expectations.bSmoothSurface, [&](auto& Sink)
+                    {
+                        FSurfaceNetsMesher::GenerateMesh(Grid, MinBounds, MaxBounds, Settings, Scratch, Sink);
+                    });
+
+                    if (!bManifold)
+                    {
+                        FReferenceSurfaceNets::GenerateMesh(Grid, MinBounds, MaxBounds, Settings, Reference);
+                        Expect(AreMeshesEquivalent(Reference, Mesh), "output differs from FReferenceSurfaceNets");
+                    }
+                }
+            }
+
+            MesherName = "MarchingCubes";
+            CheckMesher(Expectations.bClosedSurface, Expectations.bClosedSurface, [&](auto& Sink)
+            {
+                FMarchingCubesMesher::GenerateMesh(Grid, MinBounds, MaxBounds, Scratch, Sink);
+            });
+        }
+
+    private:
+        template <typename TGenerate>
+        void CheckMesher(bool bClosed, bool bWatertight, TGenerate&& Generate)
+        {
+            TCountCheckingSink<FMeshBuffers> CountingSink(Mesh);
+            Generate(CountingSink);
+            if (!Expect(CountingSink.IsExact(), "Allocate counts differ from the emitted vertices and triangles"))
+            {
+                // The cursor-based sink would write out of bounds, skip it
+                return;
+            }
+
+            const FMeshValidationReport Report = ValidateMesh(Mesh);
+            Expect(Report.IsValid(), "invalid mesh (out-of-range, non-finite or degenerate)");
+            if (bClosed)
+            {
+                Expect(Report.NumBoundaryEdges == 0, "closed surface has boundary edges");
+            }
+            if (bWatertight)
+            {
+                Expect(Report.IsWatertight(), "closed surface is not watertight");
+            }
+
+            Generate(SoAMesh);
+            ConvertMeshLayout(SoAMesh, Converted);
+            Expect(AreMeshesEquivalent(Mesh, Converted, 0.0), "FMeshBuffersSoA output differs from FMeshBuffers");
+        }
+
+        bool Expect(bool bCondition, const char* What)
+        {
+            if (!bCondition)
+            {
+                NumFailures++;
+                std::fprintf(stderr, "  %s, %s: %s\n", GridName, MesherName, What);
+            }
+            return bCondition;
+        }
+
+        const char* GridName;
+        const char* MesherName = "";
+        int32_t NumFailures = 0;
+
+        FSurfaceNetsScratch Scratch;
+        FMeshBuffers Mesh;
+        FMeshBuffers Reference;
+        FMeshBuffersSoA SoAMesh;
+        FMeshBuffers Converted;
+    };
+}
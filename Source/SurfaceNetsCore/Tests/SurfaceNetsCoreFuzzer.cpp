@@ -0,0 +1,51 @@
+#include "MeshProperties.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace SurfaceNetsCore;
+using namespace SurfaceNetsCore::Tests;
+
+/**
+ * libFuzzer target (SURFACENETSCORE_BUILD_FUZZER, Clang only). The first byte picks the grid size, the next six
+ * the mesh bounds, and the rest are raw float samples, so NaNs, infinities, denormals and exact zeros come for
+ * free; missing samples are outside. Any broken mesher property aborts with the failed checks on stderr.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* Data, size_t Size)
+{
+    constexpr size_t HeaderSize = 7;
+    if (Size < HeaderSize)
+    {
+        return 0;
+    }
+
+    const int32_t GridSize = 2 + Data[0] % 11;
+
+    // Bounds inside [0, GridSize - 1], the range chunks mesh
+    int32_t Min[3];
+    int32_t Max[3];
+    for (int32_t Axis = 0; Axis < 3; Axis++)
+    {
+        Min[Axis] = Data[1 + Axis] % GridSize;
+        Max[Axis] = Min[Axis] + Data[4 + Axis] % (GridSize - Min[Axis]);
+    }
+
+    std::vector<float> Density(static_cast<size_t>(GridSize) * GridSize * GridSize, 1.0f);
+    const size_t NumSampleBytes = Size - HeaderSize < Density.size() * sizeof(float) ? Size - HeaderSize : Density.size() * sizeof(float);
+    std::memcpy(Density.data(), Data + HeaderSize, NumSampleBytes);
+
+    FDensityGridView Grid;
+    Grid.Data = Density.data();
+    Grid.GridSize = GridSize;
+
+    FMeshPropertyChecker Checker("Fuzz");
+    Checker.CheckAllMeshers(Grid, FIntVec3(Min[0], Min[1], Min[2]), FIntVec3(Max[0], Max[1], Max[2]));
+    if (Checker.GetNumFailures() != 0)
+    {
+        std::abort();
+    }
+    return 0;
+}
@@ -0,0 +1,314 @@
+#include "ClusterProperties.h"
+#include "MeshProperties.h"
+#include "SurfaceNetsCore/DensityField.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace SurfaceNetsCore;
+using namespace SurfaceNetsCore::Tests;
+
+/**
+ * Mesher property tests: every mesher and settings combination over seeded grid families, plus cluster
+ * hierarchies built from meshed grids and batched planet density grids, run as
+ *   SurfaceNetsCoreTests [TestCase]
+ * with no argument running them all. CTest registers one test per case.
+ */
+namespace
+{
+    constexpr int32_t NumGridsPerKind = 300;
+    constexpr int32_t NumClusterMeshes = 60;
+    constexpr int32_t NumNoiseGrids = 60;
+
+    /** A grid plus the bounds and guarantees it is meshed with */
+    struct FTestGrid
+    {
+        std::vector<float> Density;
+        FDensityGridView View;
+        FIntVec3 MinBounds;
+        FIntVec3 MaxBounds;
+        FMeshExpectations Expectations;
+    };
+
+    /** Sized, placed and bounded at random, with full-grid bounds half of the time */
+    FTestGrid MakeGrid(std::mt19937& Random, int32_t MinGridSize, int32_t MaxGridSize, bool bFullBounds)
+    {
+        FTestGrid Grid;
+        const int32_t GridSize = std::uniform_int_distribution<int32_t>(MinGridSize, MaxGridSize)(Random);
+        Grid.Density.resize(static_cast<size_t>(GridSize) * GridSize * GridSize);
+
+        std::uniform_real_distribution<float> Offset(-100.0f, 100.0f);
+        Grid.View.Data = Grid.Density.data();
+        Grid.View.GridSize = GridSize;
+        Grid.View.VoxelSize = std::uniform_real_distribution<float>(0.25f, 4.0f)(Random);
+        Grid.View.Origin = FVec3(Offset(Random), Offset(Random), Offset(Random));
+
+        // Chunks mesh [0, GridSize - 1); sub-bounds exercise the bounds rules of the quad and counting passes
+        Grid.MinBounds = FIntVec3(0);
+        Grid.MaxBounds = FIntVec3(GridSize - 1);
+        if (!bFullBounds && (Random() & 1))
+        {
+            std::uniform_int_distribution<int32_t> Coord(0, GridSize - 1);
+            int32_t* Min[3] = { &Grid.MinBounds.X, &Grid.MinBounds.Y, &Grid.MinBounds.Z };
+            int32_t* Max[3] = { &Grid.MaxBounds.X, &Grid.MaxBounds.Y, &Grid.MaxBounds.Z };
+            for (int32_t Axis = 0; Axis < 3; Axis++)
+            {
+                const int32_t A = Coord(Random);
+                const int32_t B = Coord(Random);
+                *Min[Axis] = A < B ? A : B;
+                *Max[Axis] = A < B ? B : A;
+            }
+        }
+        return Grid;
+    }
+
+    /** Independent samples at every grid point */
+    template <typename TSample>
+    int32_t CheckNoiseGrids(const char* Name, uint32_t Seed, TSample&& Sample)
+    {
+        std::mt19937 Random(Seed);
+        FMeshPropertyChecker Checker(Name);
+        for (int32_t i = 0; i < NumGridsPerKind; i++)
+        {
+            FTestGrid Grid = MakeGrid(Random, 2, 14, false);
+            for (float& Value : Grid.Density)
+            {
+                Value = Sample(Random);
+            }
+            Checker.CheckAllMeshers(Grid.View, Grid.MinBounds, Grid.MaxBounds);
+        }
+        return Checker.GetNumFailures();
+    }
+
+    int32_t CheckRandomGrids()
+    {
+        return CheckNoiseGrids("Random", 1, [](std::mt19937& Random)
+        {
+            return std::uniform_real_distribution<float>(-1.0f, 1.0f)(Random);
+        });
+    }
+
+    /** Mostly exact zeros, which are outside, next to tiny values of both signs */
+    int32_t CheckZeroHeavyGrids()
+    {
+        return CheckNoiseGrids("ZeroHeavy", 2, [](std::mt19937& Random)
+        {
+            static constexpr float Values[] = { 0.0f, 0.0f, 0.0f, -0.0f, -1.0f, 1.0f, -1.e-30f, 1.e-30f };
+            return Values[Random() % (sizeof(Values) / sizeof(Values[0]))];
+        });
+    }
+
+    /** Finite noise with NaN and infinite samples sprinkled in */
+    int32_t CheckNonFiniteGrids()
+    {
+        return CheckNoiseGrids("NonFinite", 3, [](std::mt19937& Random)
+        {
+            switch (Random() % 8)
+            {
+            case 0: return std::numeric_limits<float>::quiet_NaN();
+            case 1: return std::numeric_limits<float>::infinity();
+            case 2: return -std::numeric_limits<float>::infinity();
+            default: return std::uniform_real_distribution<float>(-1.0f, 1.0f)(Random);
+            }
+        });
+    }
+
+    /**
+     * Closed signed distance fields kept two cells clear of the grid border, so every crossed edge is meshed.
+     * Each returns the field in grid coordinates.
+     */
+    std::function<double(const FVec3&)> MakeSphereSdf(std::mt19937& Random, int32_t GridSize)
+    {
+        const double MaxRadius = (GridSize - 1) * 0.5 - 2.5;
+        const double Radius = std::uniform_real_distribution<double>(1.5, MaxRadius)(Random);
+        const double Slack = MaxRadius - Radius;
+        std::uniform_real_distribution<double> Jitter(-Slack, Slack);
+        const FVec3 Center = FVec3((GridSize - 1) * 0.5) + FVec3(Jitter(Random), Jitter(Random), Jitter(Random));
+        return [Center, Radius](const FVec3& Point) { return (Point - Center).Size() - Radius; };
+    }
+
+    /** Unions of overlapping and touching spheres: closed, but with creases, necks and thin gaps */
+    std::function<double(const FVec3&)> MakeBlobSdf(std::mt19937& Random, int32_t GridSize)
+    {
+        struct FSphere { FVec3 Center; double Radius; };
+        std::vector<FSphere> Spheres(1 + Random() % 5);
+        for (FSphere& Sphere : Spheres)
+        {
+            Sphere.Radius = std::uniform_real_distribution<double>(0.6, (GridSize - 1) * 0.25)(Random);
+            std::uniform_real_distribution<double> Coord(2.5 + Sphere.Radius, GridSize - 3.5 - Sphere.Radius);
+            Sphere.Center = FVec3(Coord(Random), Coord(Random), Coord(Random));
+        }
+        return [Spheres](const FVec3& Point)
+        {
+            double Distance = std::numeric_limits<double>::max();
+            for (const FSphere& Sphere : Spheres)
+            {
+                const double SphereDistance = (Point - Sphere.Center).Size() - Sphere.Radius;
+                Distance = SphereDistance < Distance ? SphereDistance : Distance;
+            }
+            return Distance;
+        };
+    }
+
+    void FillGrid(FTestGrid& Grid, const std::function<double(const FVec3&)>& Sdf)
+    {
+        const int32_t GridSize = Grid.View.GridSize;
+        for (int32_t z = 0; z < GridSize; z++)
+        {
+            for (int32_t y = 0; y < GridSize; y++)
+            {
+                for (int32_t x = 0; x < GridSize; x++)
+                {
+                    Grid.Density[x + y * GridSize + z * GridSize * GridSize] = static_cast<float>(Sdf(FVec3(x, y, z)));
+                }
+            }
+        }
+    }
+
+    template <typename TMakeSdf>
+    int32_t CheckClosedGrids(const char* Name, uint32_t Seed, bool bSmooth, TMakeSdf&& MakeSdf)
+    {
+        std::mt19937 Random(Seed);
+        FMeshPropertyChecker Checker(Name);
+        for (int32_t i = 0; i < NumGridsPerKind; i++)
+        {
+            FTestGrid Grid = MakeGrid(Random, 10, 24, true);
+            Grid.Expectations.bClosedSurface = true;
+            Grid.Expectations.bSmoothSurface = bSmooth;
+            FillGrid(Grid, MakeSdf(Random, Grid.View.GridSize));
+            Checker.CheckAllMeshers(Grid.View, Grid.MinBounds, Grid.MaxBounds, Grid.Expectations);
+        }
+        return Checker.GetNumFailures();
+    }
+
+    int32_t CheckSphereGrids()
+    {
+        return CheckClosedGrids("Sphere", 4, true, MakeSphereSdf);
+    }
+
+    int32_t CheckBlobGrids()
+    {
+        return CheckClosedGrids("Blobs", 5, false, MakeBlobSdf);
+    }
+
+    /** Cluster hierarchies of meshed spheres and blobs, with limits small enough to force several splits and levels */
+    int32_t CheckClusterHierarchies()
+    {
+        std::mt19937 Random(6);
+        FClusterPropertyChecker Checker("Clusters");
+        FSurfaceNetsScratch Scratch;
+        FMeshBuffers Mesh;
+        for (int32_t i = 0; i < NumClusterMeshes; i++)
+        {
+            FTestGrid Grid = MakeGrid(Random, 16, 40, true);
+            FillGrid(Grid, i % 2 == 0 ? MakeSphereSdf(Random, Grid.View.GridSize) : MakeBlobSdf(Random, Grid.View.GridSize));
+            FSurfaceNetsMesher::GenerateMesh(Grid.View, Grid.MinBounds, Grid.MaxBounds, FSurfaceNetsSettings(), Scratch, Mesh);
+
+            FClusterBuildSettings Settings;
+            Settings.MaxTriangles = std::uniform_int_distribution<int32_t>(1, 128)(Random);
+            Settings.MaxVertices = std::uniform_int_distribution<int32_t>(3, 256)(Random);
+            Settings.BaseCellSize = Grid.View.VoxelSize * std::uniform_real_distribution<double>(0.5, 2.0)(Random);
+            Settings.MaxLevels = std::uniform_int_distribution<int32_t>(1, 8)(Random);
+            Settings.MinReduction = std::uniform_real_distribution<double>(0.5, 0.95)(Random);
+            Checker.CheckHierarchy(Mesh, Settings, Random);
+        }
+        return Checker.GetNumFailures();
+    }
+
+    /**
+     * FillNoiseDensityGrid against the fast sampler evaluated at every sample: within CoarseOctaveError voxels
+     * (plus float rounding) with warp and any octave count, and exact with no tolerance
+     */
+    int32_t CheckNoiseGrids()
+    {
+        std::mt19937 Random(7);
+        std::uniform_real_distribution<float> Unit(0.0f, 1.0f);
+        const ENoiseFractalType FractalTypes[] = { ENoiseFractalType::Fbm, ENoiseFractalType::Billow, ENoiseFractalType::Ridged };
+        int32_t NumFailures = 0;
+        std::vector<float> Batched;
+        std::vector<float> Reference;
+        for (int32_t i = 0; i < NumNoiseGrids; i++)
+        {
+            FNoiseSettings Settings;
+            Settings.bFastNoise = true;
+            Settings.FractalType = FractalTypes[i % 3];
+            Settings.Octaves = 1 + i % 8;
+            Settings.NoiseScale = 0.002f + 0.02f * Unit(Random);
+            Settings.NoiseAmplitude = 20.0f + 100.0f * Unit(Random);
+            Settings.WarpStrength = i % 4 == 0 ? 0.0f : 10.0f + 200.0f * Unit(Random);
+            Settings.WarpScale = 0.001f + 0.02f * Unit(Random);
+            Settings.CoarseOctaveError = i % 2 == 0 ? 0.0f : 0.2f * Unit(Random);
+
+            const float VoxelSize = 0.5f + 8.0f * Unit(Random);
+            const FChunkLayout Layout = FChunkLayout::ForChunk(FVec3(Settings.PlanetRadius, 0.0, 0.0), VoxelSize * 16.0f);
+            const FNoiseSampler Noise(Settings);
+            Batched.resize(Layout.NumSamples());
+            Reference.resize(Layout.NumSamples());
+            FillNoiseDensityGrid(Layout, Noise, Batched.data());
+            FillDensityGrid(Layout, Noise, Reference.data());
+
+            float MaxError = 0.0f;
+            for (size_t Sample = 0; Sample < Batched.size(); Sample++)
+            {
+                MaxError = std::max(MaxError, std::abs(Batched[Sample] - Reference[Sample]));
+            }
+            const float Tolerance = Settings.CoarseOctaveError * Layout.VoxelSize + 1e-5f * Settings.PlanetRadius;
+            if (!(MaxError <= Tolerance))
+            {
+                NumFailures++;
+                std::fprintf(stderr, "  NoiseGrids, grid %d (%d octaves, warp %g): error %g over tolerance %g\n",
+                             i, Settings.Octaves, Settings.WarpStrength, MaxError, Tolerance);
+            }
+        }
+        return NumFailures;
+    }
+
+    struct FTestCase
+    {
+        const char* Name;
+        int32_t (*Run)();
+    };
+
+    constexpr FTestCase TestCases[] = {
+        { "Random", CheckRandomGrids },
+        { "ZeroHeavy", CheckZeroHeavyGrids },
+        { "NonFinite", CheckNonFiniteGrids },
+        { "Sphere", CheckSphereGrids },
+        { "Blobs", CheckBlobGrids },
+        { "Clusters", CheckClusterHierarchies },
+        { "NoiseGrids", CheckNoiseGrids },
+    };
+}
+
+int main(int ArgC, char** ArgV)
+{
+    const char* Filter = ArgC > 1 ? ArgV[1] : nullptr;
+
+    int32_t NumRun = 0;
+    int32_t NumFailed = 0;
+    for (const FTestCase& TestCase : TestCases)
+    {
+        if (Filter && std::strcmp(Filter, TestCase.Name) != 0)
+        {
+            continue;
+        }
+
+        const int32_t NumFailures = TestCase.Run();
+        std::printf("%-10s %s (%d failed checks)\n", TestCase.Name, NumFailures == 0 ? "passed" : "FAILED", NumFailures);
+        NumFailed += NumFailures != 0 ? 1 : 0;
+        NumRun++;
+    }
+
+    if (NumRun == 0)
+    {
+        std::fprintf(stderr, "Unknown test case '%s'\n", Filter);
+        return 1;
+    }
+    return NumFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,319 @@
+#include "BakePlanetCommandlet.h"
+#include "NoiseGenerator.h"
+#include "PlanetChunk.h"
+#include "PlanetWorkerPool.h"
+#include "SurfaceNetsUE.h"
+#include "SurfaceNetsCoreBridge.h"
+#include "SurfaceNetsCore/BakedPlanet.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#include <atomic>
+
+namespace
+{
+    /** Everything a region's contents depend on */
+    struct FBakeParameters
+    {
+        SurfaceNetsCore::FNoiseSettings NoiseSettings;
+        float ChunkSize = 128.0f;
+        int32 ChunksPerAxis = 16;
+        int32 RegionSize = 8;
+
+        int32 GetRegionsPerAxis() const
+        {
+            return FMath::DivideAndRoundUp(ChunksPerAxis, RegionSize);
+        }
+
+        FIntVector GetRegionCoordinates(int32 RegionIndex) const
+        {
+            const int32 RegionsPerAxis = GetRegionsPerAxis();
+            return FIntVector(RegionIndex / (RegionsPerAxis * RegionsPerAxis), (RegionIndex / RegionsPerAxis) % RegionsPerAxis, RegionIndex % RegionsPerAxis);
+        }
+
+        /** Stable across processes and machines: hashes the printed values rather than struct bytes with padding */
+        uint32 ComputeHash() const
+        {
+            const FString Description = FString::Printf(TEXT("v%u r%.9g c%.9g,%.9g,%.9g s%.9g a%.9g o%d l%.9g p%.9g seed%d dec%d type%d warp%.9g,%.9g coarse%.9g hf%d fast%d chunk%.9g n%d region%d"),
+                SurfaceNetsCore::FBakedRegion::Version,
+                NoiseSettings.PlanetRadius, NoiseSettings.PlanetCenter.X, NoiseSettings.PlanetCenter.Y, NoiseSettings.PlanetCenter.Z,
+                NoiseSettings.NoiseScale, NoiseSettings.NoiseAmplitude, NoiseSettings.Octaves, NoiseSettings.Lacunarity,
+                NoiseSettings.Persistence, NoiseSettings.Seed, NoiseSettings.bDecorrelateOctaves ? 1 : 0,
+                static_cast<int32>(NoiseSettings.FractalType), NoiseSettings.WarpStrength, NoiseSettings.WarpScale,
+                NoiseSettings.CoarseOctaveError, NoiseSettings.bHeightfield ? 1 : 0, NoiseSettings.bFastNoise ? 1 : 0, ChunkSize, ChunksPerAxis, RegionSize);
+            return FCrc::StrCrc32(*Description);
+        }
+    };
+
+    FString GetRegionPath(const FString& OutputDir, const FIntVector& Region)
+    {
+        return FPaths::Combine(OutputDir, FString::Printf(TEXT("Region_%d_%d_%d.snbr"), Region.X, Region.Y, Region.Z));
+    }
+
+    /** Mesh every chunk of a region on the workers and write the region file, replacing it atomically */
+    bool BakeRegion(const FBakeParameters& Parameters, const FIntVector& Region, const FString& OutputDir, FPlanetWorkerPool& Workers, FEvent* AllDone, uint64& OutNumTriangles)
+    {
+        // Same grid as APlanetActor::GetChunkGridOrigin, clipped where the last region overhangs it
+        const float HalfExtent = (Parameters.ChunksPerAxis / 2) * Parameters.ChunkSize;
+        const FVector StartPosition = SurfaceNetsBridge::ToUnreal(Parameters.NoiseSettings.PlanetCenter) - FVector(HalfExtent);
+        const FIntVector FirstChunk = Region * Parameters.RegionSize;
+        const FIntVector RegionChunks(
+            FMath::Min(Parameters.RegionSize, Parameters.ChunksPerAxis - FirstChunk.X),
+            FMath::Min(Parameters.RegionSize, Parameters.ChunksPerAxis - FirstChunk.Y),
+            FMath::Min(Parameters.RegionSize, Parameters.ChunksPerAxis - FirstChunk.Z));
+        const int32 NumChunks = RegionChunks.X * RegionChunks.Y * RegionChunks.Z;
+
+        TArray<TUniquePtr<FPlanetChunk>> Chunks;
+        Chunks.SetNum(NumChunks);
+        std::atomic<int32> NumRemaining{ NumChunks };
+        AllDone->Reset();
+
+        for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ChunkIndex++)
+        {
+            Workers.Launch([&, ChunkIndex]()
+            {
+                const FIntVector Coordinates = FirstChunk + FIntVector(
+                    ChunkIndex / (RegionChunks.Y * RegionChunks.Z),
+                    (ChunkIndex / RegionChunks.Z) % RegionChunks.Y,
+                    ChunkIndex % RegionChunks.Z);
+                const FVector ChunkCenter = StartPosition + (FVector(Coordinates) + FVector(0.5f)) * Parameters.ChunkSize;
+
+                TUniquePtr<FPlanetChunk> Chunk = MakeUnique<FPlanetChunk>(ChunkCenter, 0, Parameters.ChunkSize);
+                Chunk->ChunkCoordinates = Coordinates;
+                if (Chunk->GenerateMesh(Parameters.NoiseSettings))
+                {
+                    Chunks[ChunkIndex] = MoveTemp(Chunk);
+                }
+                if (NumRemaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    AllDone->Trigger();
+                }
+            });
+        }
+        AllDone->Wait();
+
+        // Assembled in grid order whichever worker finished first
+        SurfaceNetsCore::FBakedRegion Baked;
+        Baked.BakeHash = Parameters.ComputeHash();
+        Baked.RegionCoordinates = SurfaceNetsBridge::ToCore(Region);
+        for (TUniquePtr<FPlanetChunk>& Chunk : Chunks)
+        {
+            if (!Chunk.IsValid())
+            {
+                continue;
+            }
+
+            SurfaceNetsCore::FBakedChunk& BakedChunk = Baked.Chunks.emplace_back();
+            BakedChunk.Coordinates = SurfaceNetsBridge::ToCore(Chunk->ChunkCoordinates);
+            BakedChunk.Positions.reserve(Chunk->Vertices.Num());
+            BakedChunk.Normals.reserve(Chunk->Normals.Num());
+            for (int32 Vertex = 0; Vertex < Chunk->Vertices.Num(); Vertex++)
+            {
+                BakedChunk.Positions.push_back(SurfaceNetsBridge::ToCore(Chunk->Vertices[Vertex]));
+                BakedChunk.Normals.push_back(SurfaceNetsBridge::ToCore(Chunk->Normals[Vertex]));
+            }
+            BakedChunk.Indices.assign(Chunk->Triangles.GetData(), Chunk->Triangles.GetData() + Chunk->Triangles.Num());
+            Chunk.Reset();
+        }
+        OutNumTriangles = Baked.NumTriangles();
+
+        std::vector<uint8_t> Blob;
+        Baked.Serialize(Blob);
+
+        // A killed shard leaves at most a temporary file, which the merge never picks up
+        const FString RegionPath = GetRegionPath(OutputDir, Region);
+        const FString TempPath = RegionPath + TEXT(".tmp");
+        if (!FFileHelper::SaveArrayToFile(TArrayView<const uint8>(Blob.data(), static_cast<int32>(Blob.size())), *TempPath)
+            || !IFileManager::Get().Move(*RegionPath, *TempPath, true, true))
+        {
+            UE_LOG(LogSurfaceNets, Error, TEXT("BakePlanet: failed to write %s"), *RegionPath);
+            return false;
+        }
+        return true;
+    }
+
+    /** Check every region of the bake and concatenate them behind an index */
+    int32 MergeRegions(const FBakeParameters& Parameters, const FString& OutputDir, const FString& MergedPath)
+    {
+        const uint32 BakeHash = Parameters.ComputeHash();
+        const int32 RegionsPerAxis = Parameters.GetRegionsPerAxis();
+        const int32 NumRegions = RegionsPerAxis * RegionsPerAxis * RegionsPerAxis;
+
+        SurfaceNetsCore::FBakedPlanetIndex Index;
+        Index.BakeHash = BakeHash;
+        Index.ChunksPerAxis = Parameters.ChunksPerAxis;
+        Index.RegionSize = Parameters.RegionSize;
+        Index.ChunkSize = Parameters.ChunkSize;
+        Index.Regions.reserve(NumRegions);
+
+        // First pass validates every region, so a missing or foreign one fails before anything is written
+        int32 NumBadRegions = 0;
+        uint64 Offset = 0;
+        uint64 NumTriangles = 0;
+        TArray<uint8> Blob;
+        SurfaceNetsCore::FBakedRegion Region;
+        for (int32 RegionIndex = 0; RegionIndex < NumRegions; RegionIndex++)
+        {
+            const FIntVector Coordinates = Parameters.GetRegionCoordinates(RegionIndex);
+            const FString RegionPath = GetRegionPath(OutputDir, Coordinates);
+            if (!FFileHelper::LoadFileToArray(Blob, *RegionPath, FILEREAD_Silent)
+                || !Region.Deserialize(Blob.GetData(), Blob.Num())
+                || Region.BakeHash != BakeHash
+                || Region.RegionCoordinates != SurfaceNetsBridge::ToCore(Coordinates))
+            {
+                UE_LOG(LogSurfaceNets, Error, TEXT("BakePlanet: %s is missing or not from this bake"), *RegionPath);
+                NumBadRegions++;
+                continue;
+            }
+
+            SurfaceNetsCore::FBakedPlanetIndex::FRegionEntry& Entry = Index.Regions.emplace_back();
+            Entry.RegionCoordinates = Region.RegionCoordinates;
+            Entry.Offset = Offset;
+            Entry.Size = static_cast<uint64>(Blob.Num());
+            Entry.NumChunks = static_cast<uint32>(Region.Chunks.size());
+            Entry.NumTriangles = Region.NumTriangles();
+            Offset += Entry.Size;
+            NumTriangles += Entry.NumTriangles;
+        }
+        if (NumBadRegions > 0)
+        {
+            UE_LOG(LogSurfaceNets, Error, TEXT("BakePlanet: %d of %d regions missing or stale, run the remaining shards first"), NumBadRegions, NumRegions);
+            return 1;
+        }
+
+        std::vector<uint8_t> IndexBlob;
+        Index.Serialize(IndexBlob);
+
+        const FString TempPath = MergedPath + TEXT(".tmp");
+        TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+        if (!Writer)
+        {
+            UE_LOG(LogSurfaceNets, Error, TEXT("BakePlanet: failed to create %s"), *TempPath);
+            return 1;
+        }
+
+        uint64 IndexSize = IndexBlob.size();
+        Writer->Serialize(&IndexSize, sizeof(IndexSize));
+        Writer->Serialize(IndexBlob.data(), static_cast<int64>(IndexBlob.size()));
+        for (const SurfaceNetsCore::FBakedPlanetIndex::FRegionEntry& Entry : Index.Regions)
+        {
+            const FString RegionPath = GetRegionPath(OutputDir, SurfaceNetsBridge::ToUnreal(Entry.RegionCoordinates));
+            if (!FFileHelper::LoadFileToArray(Blob, *RegionPath) || static_cast<uint64>(Blob.Num()) != Entry.Size)
+            {
+                UE_LOG(LogSurfaceNets, Error, TEXT("BakePlanet: %s changed during the merge"), *RegionPath);
+                Writer.Reset();
+                IFileManager::Get().Delete(*TempPath);
+                return 1;
+            }
+            Writer->Serialize(Blob.GetData(), Blob.Num());
+        }
+
+        const bool bWriteFailed = Writer->IsError() || !Writer->Close();
+        Writer.Reset();
+        if (bWriteFailed || !IFileManager::Get().Move(*MergedPath, *TempPath, true, true))
+        {
+            UE_LOG(LogSurfaceNets, Error, TEXT("BakePlanet: failed to write %s"), *MergedPath);
+            return 1;
+        }
+
+        UE_LOG(LogSurfaceNets, Display, TEXT("BakePlanet: merged %d regions, %llu triangles (%llu MB) into %s"),
+               NumRegions, NumTriangles, (sizeof(IndexSize) + IndexBlob.size() + Offset) >> 20, *MergedPath);
+        return 0;
+    }
+}
+
+UBakePlanetCommandlet::UBakePlanetCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UBakePlanetCommandlet::Main(const FString& Params)
+{
+    const TCHAR* Cmd = *Params;
+
+    FString OutputDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PlanetBake"));
+    FParse::Value(Cmd, TEXT("Output="), OutputDir);
+
+    FBakeParameters Parameters;
+    float PlanetRadius = 1000.0f;
+    FParse::Value(Cmd, TEXT("PlanetRadius="), PlanetRadius);
+    FParse::Value(Cmd, TEXT("ChunkSize="), Parameters.ChunkSize);
+    FParse::Value(Cmd, TEXT("ChunksPerAxis="), Parameters.ChunksPerAxis);
+    FParse::Value(Cmd, TEXT("RegionSize="), Parameters.RegionSize);
+    if (Parameters.ChunkSize <= 0.0f || Parameters.ChunksPerAxis <= 0 || Parameters.RegionSize <= 0)
+    {
+        UE_LOG(LogSurfaceNets, Error, TEXT("BakePlanet: ChunkSize, ChunksPerAxis and RegionSize must be positive"));
+        return 1;
+    }
+
+    UNoiseGenerator* NoiseGenerator = NewObject<UNoiseGenerator>();
+    NoiseGenerator->PlanetRadius = PlanetRadius;
+    NoiseGenerator->PlanetCenter = FVector::ZeroVector;
+    FParse::Value(Cmd, TEXT("Seed="), NoiseGenerator->Seed);
+    FParse::Value(Cmd, TEXT("NoiseScale="), NoiseGenerator->NoiseScale);
+    FParse::Value(Cmd, TEXT("NoiseAmplitude="), NoiseGenerator->NoiseAmplitude);
+    FParse::Value(Cmd, TEXT("Octaves="), NoiseGenerator->Octaves);
+    Parameters.NoiseSettings = NoiseGenerator->GetNoiseSettings();
+
+    if (FParse::Param(Cmd, TEXT("Merge")))
+    {
+        FString MergedPath = FPaths::Combine(OutputDir, TEXT("Planet.bake"));
+        FParse::Value(Cmd, TEXT("MergedOutput="), MergedPath);
+        return MergeRegions(Parameters, OutputDir, MergedPath);
+    }
+
+    int32 ShardIndex = 0;
+    int32 ShardCount = 1;
+    FParse::Value(Cmd, TEXT("Shard="), ShardIndex);
+    FParse::Value(Cmd, TEXT("ShardCount="), ShardCount);
+    if (ShardCount <= 0 || ShardIndex < 0 || ShardIndex >= ShardCount)
+    {
+        UE_LOG(LogSurfaceNets, Error, TEXT("BakePlanet: -Shard=%d is outside -ShardCount=%d"), ShardIndex, ShardCount);
+        return 1;
+    }
+
+    FPlanetWorkerSettings WorkerSettings = FPlanetWorkerSettings::FromCommandLine(Cmd);
+    if (WorkerSettings.Groups.Num() == 0)
+    {
+        WorkerSettings.Groups.AddDefaulted_GetRef().NumWorkers = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+    }
+
+    IFileManager::Get().MakeDirectory(*OutputDir, true);
+
+    // Round-robin over the grid spreads the surface regions, which hold all the work, evenly across shards
+    const int32 RegionsPerAxis = Parameters.GetRegionsPerAxis();
+    const int32 NumRegions = RegionsPerAxis * RegionsPerAxis * RegionsPerAxis;
+    const double StartTime = FPlatformTime::Seconds();
+    int32 NumBaked = 0;
+    uint64 NumTriangles = 0;
+    bool bFailed = false;
+
+    FEvent* AllDone = FPlatformProcess::GetSynchEventFromPool(true);
+    {
+        FPlanetWorkerPool Workers(WorkerSettings);
+        for (int32 RegionIndex = ShardIndex; RegionIndex < NumRegions; RegionIndex += ShardCount)
+        {
+            uint64 RegionTriangles = 0;
+            if (!BakeRegion(Parameters, Parameters.GetRegionCoordinates(RegionIndex), OutputDir, Workers, AllDone, RegionTriangles))
+            {
+                bFailed = true;
+                break;
+            }
+            NumBaked++;
+            NumTriangles += RegionTriangles;
+        }
+    }
+    FPlatformProcess::ReturnSynchEventToPool(AllDone);
+
+    UE_LOG(LogSurfaceNets, Display, TEXT("BakePlanet: shard %d/%d baked %d of %d regions, %llu triangles in %.1f s"),
+           ShardIndex, ShardCount, NumBaked, NumRegions, NumTriangles, FPlatformTime::Seconds() - StartTime);
+    return bFailed ? 1 : 0;
+}
@@ -0,0 +1,160 @@
+#include "BuildPlanetClustersCommandlet.h"
+#include "NoiseGenerator.h"
+#include "PlanetChunk.h"
+#include "PlanetWorkerPool.h"
+#include "SurfaceNetsUE.h"
+#include "SurfaceNetsCoreBridge.h"
+#include "SurfaceNetsCore/ClusterBuilder.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#include <atomic>
+
+UBuildPlanetClustersCommandlet::UBuildPlanetClustersCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UBuildPlanetClustersCommandlet::Main(const FString& Params)
+{
+    const TCHAR* Cmd = *Params;
+
+    FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Planet.clusters"));
+    FParse::Value(Cmd, TEXT("Output="), OutputPath);
+
+    float PlanetRadius = 1000.0f;
+    float ChunkSize = 128.0f;
+    int32 ChunksPerAxis = 16;
+    FParse::Value(Cmd, TEXT("PlanetRadius="), PlanetRadius);
+    FParse::Value(Cmd, TEXT("ChunkSize="), ChunkSize);
+    FParse::Value(Cmd, TEXT("ChunksPerAxis="), ChunksPerAxis);
+    if (ChunkSize <= 0.0f || ChunksPerAxis <= 0)
+    {
+        UE_LOG(LogSurfaceNets, Error, TEXT("BuildPlanetClusters: ChunkSize and ChunksPerAxis must be positive"));
+        return 1;
+    }
+
+    UNoiseGenerator* NoiseGenerator = NewObject<UNoiseGenerator>();
+    NoiseGenerator->PlanetRadius = PlanetRadius;
+    NoiseGenerator->PlanetCenter = FVector::ZeroVector;
+    FParse::Value(Cmd, TEXT("Seed="), NoiseGenerator->Seed);
+    FParse::Value(Cmd, TEXT("NoiseScale="), NoiseGenerator->NoiseScale);
+    FParse::Value(Cmd, TEXT("NoiseAmplitude="), NoiseGenerator->NoiseAmplitude);
+    FParse::Value(Cmd, TEXT("Octaves="), NoiseGenerator->Octaves);
+
+    // Same grid as APlanetActor::GetChunkGridOrigin; chunk meshes repeat the vertices on shared faces, welded here
+    const float HalfExtent = (ChunksPerAxis / 2) * ChunkSize;
+    const FVector StartPosition(-HalfExtent);
+
+    // Chunks are meshed in parallel and welded in grid order, so the output does not depend on the worker count
+    FPlanetWorkerSettings WorkerSettings = FPlanetWorkerSettings::FromCommandLine(Cmd);
+    if (WorkerSettings.Groups.Num() == 0)
+    {
+        WorkerSettings.Groups.AddDefaulted_GetRef().NumWorkers = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+    }
+
+    const SurfaceNetsCore::FNoiseSettings NoiseSettings = NoiseGenerator->GetNoiseSettings();
+    const int32 NumChunks = ChunksPerAxis * ChunksPerAxis * ChunksPerAxis;
+    TArray<TUniquePtr<FPlanetChunk>> Chunks;
+    Chunks.SetNum(NumChunks);
+    FEvent* AllDone = FPlatformProcess::GetSynchEventFromPool(true);
+    std::atomic<int32> NumRemaining{ NumChunks };
+    {
+        FPlanetWorkerPool Workers(WorkerSettings);
+
+        for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ChunkIndex++)
+        {
+            Workers.Launch([&, ChunkIndex]()
+            {
+                const int32 X = ChunkIndex / (ChunksPerAxis * ChunksPerAxis);
+                const int32 Y = (ChunkIndex / ChunksPerAxis) % ChunksPerAxis;
+                const int32 Z = ChunkIndex % ChunksPerAxis;
+                const FVector ChunkCenter = StartPosition + (FVector(X, Y, Z) + FVector(0.5f)) * ChunkSize;
+
+                TUniquePtr<FPlanetChunk> Chunk = MakeUnique<FPlanetChunk>(ChunkCenter, 0, ChunkSize);
+                Chunk->ChunkCoordinates = FIntVector(X, Y, Z);
+                if (Chunk->GenerateMesh(NoiseSettings))
+                {
+                    Chunks[ChunkIndex] = MoveTemp(Chunk);
+                }
+                if (NumRemaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    AllDone->Trigger();
+                }
+            });
+        }
+
+        AllDone->Wait();
+    }
+    FPlatformProcess::ReturnSynchEventToPool(AllDone);
+
+    TArray<SurfaceNetsCore::FVec3> Positions;
+    TArray<SurfaceNetsCore::FVec3> Normals;
+    TArray<int32> Indices;
+    TMap<FVector, int32> WeldedVertices;
+    TArray<int32> Remap;
+    int32 NumSurfaceChunks = 0;
+
+    for (TUniquePtr<FPlanetChunk>& Chunk : Chunks)
+    {
+        if (!Chunk.IsValid())
+        {
+            continue;
+        }
+        NumSurfaceChunks++;
+
+        Remap.SetNumUninitialized(Chunk->Vertices.Num());
+        for (int32 Vertex = 0; Vertex < Chunk->Vertices.Num(); Vertex++)
+        {
+            if (const int32* Existing = WeldedVertices.Find(Chunk->Vertices[Vertex]))
+            {
+                Remap[Vertex] = *Existing;
+                continue;
+            }
+
+            Remap[Vertex] = Positions.Add(SurfaceNetsBridge::ToCore(Chunk->Vertices[Vertex]));
+            Normals.Add(SurfaceNetsBridge::ToCore(Chunk->Normals[Vertex]));
+            WeldedVertices.Add(Chunk->Vertices[Vertex], Remap[Vertex]);
+        }
+        for (const int32 Index : Chunk->Triangles)
+        {
+            Indices.Add(Remap[Index]);
+        }
+        Chunk.Reset();
+    }
+
+    UE_LOG(LogSurfaceNets, Display, TEXT("BuildPlanetClusters: %d surface chunks, %d vertices, %d triangles"),
+           NumSurfaceChunks, Positions.Num(), Indices.Num() / 3);
+
+    SurfaceNetsCore::FClusterBuildSettings Settings;
+    Settings.BaseCellSize = ChunkSize / FPlanetChunk::UNPADDED_CHUNK_SIZE;
+
+    SurfaceNetsCore::FClusterHierarchy Hierarchy;
+    SurfaceNetsCore::FClusterBuilder::Build(Positions.GetData(), Normals.GetData(), Positions.Num(), Indices.GetData(), Indices.Num(), Settings, Hierarchy);
+
+    for (int32 Level = 0; Level < Hierarchy.NumLevels(); Level++)
+    {
+        const int32 FirstCluster = Hierarchy.LevelOffsets[Level];
+        UE_LOG(LogSurfaceNets, Display, TEXT("  Level %d: %d clusters, %llu triangles, error %.2f"),
+               Level, Hierarchy.LevelOffsets[Level + 1] - FirstCluster, static_cast<uint64>(Hierarchy.NumTriangles(Level)),
+               FirstCluster < static_cast<int32>(Hierarchy.Clusters.size()) ? Hierarchy.Clusters[FirstCluster].Error : 0.0f);
+    }
+
+    std::vector<uint8_t> Blob;
+    Hierarchy.Serialize(Blob);
+    if (!FFileHelper::SaveArrayToFile(TArrayView<const uint8>(Blob.data(), static_cast<int32>(Blob.size())), *OutputPath))
+    {
+        UE_LOG(LogSurfaceNets, Error, TEXT("BuildPlanetClusters: failed to write %s"), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogSurfaceNets, Display, TEXT("BuildPlanetClusters: wrote %d clusters (%d KB) to %s"),
+           static_cast<int32>(Hierarchy.Clusters.size()), static_cast<int32>(Blob.size() / 1024), *OutputPath);
+    return 0;
+}
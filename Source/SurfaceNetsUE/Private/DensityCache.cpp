@@ -0,0 +1,161 @@
+#include "DensityCache.h"
+#include "SurfaceNetsUE.h"
+#include "SurfaceNetsCoreBridge.h"
+#include "Misc/ScopeLock.h"
+
+FDensityCache::FDensityCache(int64 InBudgetBytes)
+    : BudgetBytes(InBudgetBytes)
+{
+}
+
+void FDensityCache::SetSource(const SurfaceNetsCore::FNoiseSettings& InNoiseSettings, const FVector& InGridOrigin, float InChunkSize)
+{
+    FScopeLock Lock(&Mutex);
+    if (NoiseSettings == InNoiseSettings && GridOrigin.Equals(InGridOrigin, 0.0) && ChunkSize == InChunkSize)
+    {
+        return;
+    }
+
+    if (Entries.Num() > 0)
+    {
+        UE_LOG(LogSurfaceNets, Log, TEXT("Density function or chunk grid changed, dropping %d cached density grids"), Entries.Num());
+    }
+
+    NoiseSettings = InNoiseSettings;
+    GridOrigin = InGridOrigin;
+    ChunkSize = InChunkSize;
+    Entries.Empty();
+    AllocatedBytes = 0;
+}
+
+bool FDensityCache::HasSource(const SurfaceNetsCore::FNoiseSettings& InNoiseSettings, const FVector& InGridOrigin, float InChunkSize) const
+{
+    FScopeLock Lock(&Mutex);
+    return NoiseSettings == InNoiseSettings && GridOrigin.Equals(InGridOrigin, 0.0) && ChunkSize == InChunkSize;
+}
+
+TSharedPtr<const FCachedDensity> FDensityCache::Find(const FDensityCacheKey& Key)
+{
+    FScopeLock Lock(&Mutex);
+    FEntry* Entry = Entries.Find(Key);
+    if (!Entry)
+    {
+        NumMisses++;
+        return nullptr;
+    }
+
+    NumHits++;
+    Entry->LastUsed = ++UseCounter;
+    return Entry->Density;
+}
+
+TSharedPtr<const FCachedDensity> FDensityCache::FindAt(const FVector& Position, FBox& OutChunkBounds)
+{
+    FDensityCacheKey Key;
+    {
+        FScopeLock Lock(&Mutex);
+        if (ChunkSize <= 0.0f)
+        {
+            OutChunkBounds = FBox(ForceInit);
+            return nullptr;
+        }
+
+        const FVector Coordinates = (Position - GridOrigin) / ChunkSize;
+        Key.ChunkCoordinates = FIntVector(FMath::FloorToInt(Coordinates.X), FMath::FloorToInt(Coordinates.Y), FMath::FloorToInt(Coordinates.Z));
+
+        const FVector ChunkMin = GridOrigin + FVector(Key.ChunkCoordinates) * ChunkSize;
+        OutChunkBounds = FBox(ChunkMin, ChunkMin + FVector(ChunkSize));
+    }
+    return Find(Key);
+}
+
+TSharedRef<const FCachedDensity> FDensityCache::Add(const FDensityCacheKey& Key, const SurfaceNetsCore::FChunkLayout& Layout, const float* Density)
+{
+    // Encode outside the lock, it is the expensive part
+    TSharedRef<FCachedDensity> Cached = MakeShared<FCachedDensity>();
+    Cached->Layout = Layout;
+    Cached->Density.Encode(Density, Layout.NumSamples(), Layout.VoxelSize * ClampVoxels);
+
+    FScopeLock Lock(&Mutex);
+    if (FEntry* Existing = Entries.Find(Key))
+    {
+        AllocatedBytes -= Existing->AllocatedBytes;
+    }
+
+    FEntry& Entry = Entries.Add(Key);
+    Entry.Density = Cached;
+    Entry.AllocatedBytes = static_cast<int64>(Cached->Density.GetAllocatedSize() + sizeof(FCachedDensity));
+    Entry.LastUsed = ++UseCounter;
+    AllocatedBytes += Entry.AllocatedBytes;
+
+    EvictToBudget();
+    return Cached;
+}
+
+void FDensityCache::Remove(const FDensityCacheKey& Key)
+{
+    FScopeLock Lock(&Mutex);
+    FEntry Removed;
+    if (Entries.RemoveAndCopyValue(Key, Removed))
+    {
+        AllocatedBytes -= Removed.AllocatedBytes;
+    }
+}
+
+void FDensityCache::Empty()
+{
+    FScopeLock Lock(&Mutex);
+    Entries.Empty();
+    AllocatedBytes = 0;
+    NumHits = 0;
+    NumMisses = 0;
+}
+
+void FDensityCache::SetBudget(int64 InBudgetBytes)
+{
+    FScopeLock Lock(&Mutex);
+    BudgetBytes = InBudgetBytes;
+    EvictToBudget();
+}
+
+int64 FDensityCache::GetAllocatedBytes() const
+{
+    FScopeLock Lock(&Mutex);
+    return AllocatedBytes;
+}
+
+int32 FDensityCache::Num() const
+{
+    FScopeLock Lock(&Mutex);
+    return Entries.Num();
+}
+
+void FDensityCache::EvictToBudget()
+{
+    if (AllocatedBytes <= BudgetBytes)
+    {
+        return;
+    }
+
+    // Evict a batch down to 90% of the budget so a full cache does not sort on every add
+    TArray<TPair<uint64, FDensityCacheKey>> ByAge;
+    ByAge.Reserve(Entries.Num());
+    for (const TPair<FDensityCacheKey, FEntry>& Pair : Entries)
+    {
+        ByAge.Emplace(Pair.Value.LastUsed, Pair.Key);
+    }
+    ByAge.Sort([](const TPair<uint64, FDensityCacheKey>& A, const TPair<uint64, FDensityCacheKey>& B) { return A.Key < B.Key; });
+
+    const int64 TargetBytes = BudgetBytes - BudgetBytes / 10;
+    for (const TPair<uint64, FDensityCacheKey>& Oldest : ByAge)
+    {
+        if (AllocatedBytes <= TargetBytes)
+        {
+            break;
+        }
+
+        FEntry Removed;
+        Entries.RemoveAndCopyValue(Oldest.Value, Removed);
+        AllocatedBytes -= Removed.AllocatedBytes;
+    }
+}
@@ -0,0 +1,58 @@
+#include "MarchingCubes.h"
+#include "SurfaceNetsUE.h"
+#include "SurfaceNetsCoreBridge.h"
+#include "PlanetChunkRenderData.h"
+#include "SurfaceNetsCore/MarchingCubesMesher.h"
+
+void FMarchingCubes::GenerateMesh(
+    TConstArrayView<float> DensityField,
+    int32 GridSize,
+    float VoxelSize,
+    const FVector& Origin,
+    TChunkArray<FVector>& OutVertices,
+    TChunkArray<int32>& OutTriangles,
+    TChunkArray<FVector>& OutNormals,
+    const FIntVector& MinBounds,
+    const FIntVector& MaxBounds,
+    FPlanetChunkRenderData* OutRenderData)
+{
+    OutVertices.Reset();
+    OutTriangles.Reset();
+    OutNormals.Reset();
+
+    FIntVector ActualMinBounds;
+    FIntVector ActualMaxBounds;
+    ResolveBounds(GridSize, MinBounds, MaxBounds, ActualMinBounds, ActualMaxBounds);
+
+    SurfaceNetsCore::FDensityGridView Grid;
+    Grid.Data = DensityField.GetData();
+    Grid.GridSize = GridSize;
+    Grid.VoxelSize = VoxelSize;
+    Grid.Origin = SurfaceNetsBridge::ToCore(Origin);
+
+    const auto Mesh = [&](auto& Sink)
+    {
+        SurfaceNetsCore::FMarchingCubesMesher::GenerateMesh(
+            Grid,
+            SurfaceNetsBridge::ToCore(ActualMinBounds),
+            SurfaceNetsBridge::ToCore(ActualMaxBounds),
+            Scratch,
+            Sink);
+    };
+
+    SurfaceNetsBridge::FTArrayMeshSink Sink{ OutVertices, OutTriangles, OutNormals };
+    if (OutRenderData)
+    {
+        FPlanetChunkRenderSink RenderSink{ Sink, *OutRenderData };
+        Mesh(RenderSink);
+        check(RenderSink.IsComplete());
+    }
+    else
+    {
+        Mesh(Sink);
+        check(Sink.IsComplete());
+    }
+
+    UE_LOG(LogSurfaceNets, Verbose, TEXT("Marching Cubes generated %d vertices, %d triangles"),
+           OutVertices.Num(), OutTriangles.Num() / 3);
+}
@@ -0,0 +1,28 @@
+#include "Mesher.h"
+#include "MarchingCubes.h"
+#include "PlanetMeshingSettings.h"
+#include "SurfaceNets.h"
+
+TUniquePtr<IMesher> IMesher::Create(const FPlanetMeshingSettings& MeshingSettings)
+{
+    switch (MeshingSettings.Algorithm)
+    {
+    case EPlanetMeshingAlgorithm::MarchingCubes:
+        return MakeUnique<FMarchingCubes>();
+
+    case EPlanetMeshingAlgorithm::SurfaceNets:
+    default:
+        {
+            TUniquePtr<FSurfaceNets> SurfaceNets = MakeUnique<FSurfaceNets>();
+            SurfaceNets->Settings = MeshingSettings.ToCore();
+            return SurfaceNets;
+        }
+    }
+}
+
+void IMesher::ResolveBounds(int32 GridSize, const FIntVector& MinBounds, const FIntVector& MaxBounds, FIntVector& OutMinBounds, FIntVector& OutMaxBounds)
+{
+    const bool bUseFullGrid = (MinBounds == FIntVector(0, 0, 0) && MaxBounds == FIntVector(0, 0, 0));
+    OutMinBounds = bUseFullGrid ? FIntVector(0, 0, 0) : MinBounds;
+    OutMaxBounds = bUseFullGrid ? FIntVector(GridSize - 1, GridSize - 1, GridSize - 1) : MaxBounds;
+}
@@ -1,5 +1,6 @@
 #include "NoiseGenerator.h"
 #include "SurfaceNetsUE.h"
+#include "SurfaceNetsCoreBridge.h"
 #include "Engine/Engine.h"
 
 UNoiseGenerator::UNoiseGenerator()
@@ -17,118 +18,80 @@ UNoiseGenerator::UNoiseGenerator()
 
 float UNoiseGenerator::SampleDensity(const FVector& WorldPosition) const
 {
-    // Calculate distance from planet center
-    float DistanceFromCenter = (WorldPosition - PlanetCenter).Size();
-    
-    // Base sphere (negative inside, positive outside for Surface Nets)
-    float SphereDensity = DistanceFromCenter - PlanetRadius;
-    
-    // Add terrain noise
-    float TerrainNoise = FractalNoise(WorldPosition);
-    float TerrainHeight = TerrainNoise * NoiseAmplitude;
-    
-    // Combine sphere with terrain - negative values are "inside" the surface
-    float FinalDensity = SphereDensity - TerrainHeight;
-    
-    // Debug sampling for some positions
-    static int32 SampleCount = 0;
-    if (SampleCount < 10)
-    {
-        UE_LOG(LogSurfaceNets, VeryVerbose, TEXT("Sample at %s: Distance=%f, Sphere=%f, Noise=%f, Final=%f"), 
-               *WorldPosition.ToString(), DistanceFromCenter, SphereDensity, TerrainHeight, FinalDensity);
-        SampleCount++;
-    }
-    
-    return FinalDensity;
+    // The reference noise needs no per-settings setup, so single samples skip the fast path's octave tables and lock
+    return SurfaceNetsCore::FFractalNoise::SampleDensity(MakeReferenceSettings(), SurfaceNetsBridge::ToCore(WorldPosition));
 }
 
 float UNoiseGenerator::SampleHeight(const FVector& SurfacePosition) const
 {
-    return FractalNoise(SurfacePosition) * NoiseAmplitude;
+    return SurfaceNetsCore::FFractalNoise::SampleHeight(MakeReferenceSettings(), SurfaceNetsBridge::ToCore(SurfacePosition));
 }
 
-float UNoiseGenerator::FractalNoise(const FVector& Position) const
+SurfaceNetsCore::FNoiseSettings UNoiseGenerator::GetNoiseSettings() const
 {
-    float Value = 0.0f;
-    float Amplitude = 1.0f;
-    float Frequency = NoiseScale;
-    
-    for (int32 i = 0; i < Octaves; i++)
-    {
-        Value += SimplexNoise(Position * Frequency) * Amplitude;
-        Frequency *= Lacunarity;
-        Amplitude *= Persistence;
-    }
-    
-    return Value;
+    SurfaceNetsCore::FNoiseSettings Settings = MakeReferenceSettings();
+    Settings.bFastNoise = bFastNoise && IsFastNoiseWithinTolerance(Settings);
+    return Settings;
 }
 
-float UNoiseGenerator::SimplexNoise(const FVector& Position) const
+SurfaceNetsCore::FNoiseSettings UNoiseGenerator::MakeReferenceSettings() const
 {
-    // Simple 3D noise implementation
-    FVector P = Position;
-    P.X += Seed * 0.1f;
-    P.Y += Seed * 0.2f;
-    P.Z += Seed * 0.3f;
-    
-    // Grid coordinates
-    int32 X0 = FMath::FloorToInt(P.X);
-    int32 Y0 = FMath::FloorToInt(P.Y);
-    int32 Z0 = FMath::FloorToInt(P.Z);
-    int32 X1 = X0 + 1;
-    int32 Y1 = Y0 + 1;
-    int32 Z1 = Z0 + 1;
-    
-    // Interpolation weights
-    float Sx = SmoothStep(P.X - X0);
-    float Sy = SmoothStep(P.Y - Y0);
-    float Sz = SmoothStep(P.Z - Z0);
-    
-    // Hash values at cube corners
-    float N000 = Hash(X0, Y0, Z0);
-    float N001 = Hash(X0, Y0, Z1);
-    float N010 = Hash(X0, Y1, Z0);
-    float N011 = Hash(X0, Y1, Z1);
-    float N100 = Hash(X1, Y0, Z0);
-    float N101 = Hash(X1, Y0, Z1);
-    float N110 = Hash(X1, Y1, Z0);
-    float N111 = Hash(X1, Y1, Z1);
-    
-    // Trilinear interpolation
-    float Ix00 = Lerp(N000, N100, Sx);
-    float Ix01 = Lerp(N001, N101, Sx);
-    float Ix10 = Lerp(N010, N110, Sx);
-    float Ix11 = Lerp(N011, N111, Sx);
-    
-    float Iy0 = Lerp(Ix00, Ix10, Sy);
-    float Iy1 = Lerp(Ix01, Ix11, Sy);
-    
-    return Lerp(Iy0, Iy1, Sz);
+    SurfaceNetsCore::FNoiseSettings Settings;
+    Settings.PlanetRadius = PlanetRadius;
+    Settings.PlanetCenter = SurfaceNetsBridge::ToCore(PlanetCenter);
+    Settings.NoiseScale = NoiseScale;
+    Settings.NoiseAmplitude = NoiseAmplitude;
+    Settings.Octaves = Octaves;
+    Settings.Lacunarity = Lacunarity;
+    Settings.Persistence = Persistence;
+    Settings.Seed = Seed;
+    Settings.bDecorrelateOctaves = bDecorrelateOctaves;
+    Settings.FractalType = ToCore(NoiseType);
+    Settings.WarpStrength = WarpStrength;
+    Settings.WarpScale = WarpScale;
+    Settings.CoarseOctaveError = CoarseOctaveError;
+    Settings.bHeightfield = UsesHeightfield(SamplingMode, Settings);
+    return Settings;
 }
 
-float UNoiseGenerator::Hash(float x, float y, float z) const
+SurfaceNetsCore::ENoiseFractalType UNoiseGenerator::ToCore(EPlanetNoiseType NoiseType)
 {
-    // Simple hash function for noise generation
-    int32 ix = static_cast<int32>(x);
-    int32 iy = static_cast<int32>(y);
-    int32 iz = static_cast<int32>(z);
-    
-    uint32 hash = ix * 374761393U + iy * 668265263U + iz * 2147483647U;
-    hash ^= hash >> 16;
-    hash *= 0x7feb352dU;
-    hash ^= hash >> 15;
-    hash *= 0x846ca68bU;
-    hash ^= hash >> 16;
-    
-    return (hash / 4294967295.0f) * 2.0f - 1.0f;
+    switch (NoiseType)
+    {
+    case EPlanetNoiseType::Billow:
+        return SurfaceNetsCore::ENoiseFractalType::Billow;
+    case EPlanetNoiseType::Ridged:
+        return SurfaceNetsCore::ENoiseFractalType::Ridged;
+    default:
+        return SurfaceNetsCore::ENoiseFractalType::Fbm;
+    }
 }
 
-float UNoiseGenerator::SmoothStep(float t) const
+bool UNoiseGenerator::UsesHeightfield(EPlanetSamplingMode SamplingMode, const SurfaceNetsCore::FNoiseSettings& Settings)
 {
-    return t * t * (3.0f - 2.0f * t);
+    switch (SamplingMode)
+    {
+    case EPlanetSamplingMode::Volumetric:
+        return false;
+    case EPlanetSamplingMode::Heightfield:
+        return true;
+    default:
+        return !SurfaceNetsCore::FFractalNoise::CanFormOverhangs(Settings);
+    }
 }
 
-float UNoiseGenerator::Lerp(float a, float b, float t) const
+bool UNoiseGenerator::IsFastNoiseWithinTolerance(const SurfaceNetsCore::FNoiseSettings& Settings) const
 {
-    return a + t * (b - a);
-}
\ No newline at end of file
+    FScopeLock Lock(&FastNoiseLock);
+    if (!MeasuredSettings.IsSet() || MeasuredSettings.GetValue() != Settings)
+    {
+        MeasuredSettings = Settings;
+        MeasuredError = SurfaceNetsCore::FFastFractalNoise::MeasureError(Settings);
+        if (MeasuredError > FastNoiseTolerance)
+        {
+            UE_LOG(LogSurfaceNets, Warning, TEXT("Fast noise differs by up to %f from the reference (tolerance %f), sampling in double precision"),
+                   MeasuredError, FastNoiseTolerance);
+        }
+    }
+    return MeasuredError <= FastNoiseTolerance;
+}
@@ -1,13 +1,47 @@
 #include "PlanetActor.h"
 #include "NoiseGenerator.h"
 #include "PlanetChunk.h"
+#include "PlanetPreset.h"
 #include "SurfaceNetsUE.h"
+#include "SurfaceNetsCoreBridge.h"
 #include "Components/StaticMeshComponent.h"
 #include "Engine/Engine.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+
+DECLARE_CYCLE_STAT(TEXT("Drain Chunk Queue"), STAT_DrainChunkQueue, STATGROUP_SurfaceNets);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Chunk Queue Depth"), STAT_ChunkQueueDepth, STATGROUP_SurfaceNets);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Chunks In Flight"), STAT_ChunksInFlight, STATGROUP_SurfaceNets);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Chunk Queue Latency (ms)"), STAT_ChunkQueueLatency, STATGROUP_SurfaceNets);
+DECLARE_MEMORY_STAT(TEXT("Chunk Slab Reserved"), STAT_ChunkSlabReserved, STATGROUP_SurfaceNets);
+DECLARE_MEMORY_STAT(TEXT("Chunk Slab In Use"), STAT_ChunkSlabInUse, STATGROUP_SurfaceNets);
+DECLARE_MEMORY_STAT(TEXT("Chunk Slab Peak In Use"), STAT_ChunkSlabPeakInUse, STATGROUP_SurfaceNets);
+
+namespace
+{
+    /** Planet-wide nav node id: chunk index in the high half, node in the chunk's graph in the low half */
+    uint64 MakeNavNodeId(int32 ChunkIndex, int32 Node)
+    {
+        return (static_cast<uint64>(static_cast<uint32>(ChunkIndex)) << 32) | static_cast<uint32>(Node);
+    }
+
+    int32 GetNavChunk(uint64 NodeId)
+    {
+        return static_cast<int32>(NodeId >> 32);
+    }
+
+    int32 GetNavNode(uint64 NodeId)
+    {
+        return static_cast<int32>(static_cast<uint32>(NodeId));
+    }
+}
 
 APlanetActor::APlanetActor()
 {
-    PrimaryActorTick.bCanEverTick = false;
+    // Ticks only while chunk batches or crossfades run
+    PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
     
     // Create root component
     RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent"));
@@ -36,13 +70,29 @@ void APlanetActor::BeginPlay()
         NoiseGenerator = NewObject<UNoiseGenerator>(this);
     }
     
+    PresetChangedHandle = UPlanetPreset::OnPresetChanged.AddUObject(this, &APlanetActor::HandlePresetChanged);
+
     // Initialize planet on begin play
     InitializePlanet();
 }
 
-UProceduralMeshComponent* APlanetActor::CreateMeshComponent()
+void APlanetActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    UProceduralMeshComponent* MeshComponent = NewObject<UProceduralMeshComponent>(this);
+    // Pool workers finish their current chunk and drop the rest; task graph workers still running keep the queue
+    // alive and push into it. Nothing reads it after this
+    UPlanetPreset::OnPresetChanged.Remove(PresetChangedHandle);
+    CancelChunkBatches();
+    BuiltInputs.Reset();
+    WorkerPool.Reset();
+    ChunkQueue.Reset();
+    NumChunksInFlight = 0;
+
+    Super::EndPlay(EndPlayReason);
+}
+
+UPlanetChunkMeshComponent* APlanetActor::CreateMeshComponent()
+{
+    UPlanetChunkMeshComponent* MeshComponent = NewObject<UPlanetChunkMeshComponent>(this);
     MeshComponent->AttachToComponent(RootComponent, FAttachmentTransformRules::KeepWorldTransform);
     MeshComponent->RegisterComponent();
     return MeshComponent;
@@ -58,46 +108,65 @@ void APlanetActor::InitializePlanet()
     
     // Set up noise generator with actor's world position as planet center
     FVector ActorPosition = GetActorLocation();
+    if (Preset)
+    {
+        Preset->ApplyTo(NoiseGenerator);
+        PlanetRadius = Preset->PlanetRadius;
+    }
     NoiseGenerator->PlanetRadius = PlanetRadius;
     NoiseGenerator->PlanetCenter = ActorPosition;
     
-    // Generate all chunks immediately
-    GenerateAllChunks();
+    // Keep what the changed settings do not reach, otherwise generate all chunks, now or over the next frames
+    const FPlanetBuildInputs Inputs = GatherBuildInputs();
+    if (!UpdateChunksInPlace(Inputs))
+    {
+        GenerateAllChunks();
+    }
+    BuiltInputs = Inputs;
     
-    UE_LOG(LogSurfaceNets, Log, TEXT("Planet initialized at %s with radius %f and %d chunks"), 
-           *ActorPosition.ToString(), PlanetRadius, PlanetChunks.Num());
+    UE_LOG(LogSurfaceNets, Log, TEXT("Planet initialized at %s with radius %f and %d chunks (%d pending)"), 
+           *ActorPosition.ToString(), PlanetRadius, PlanetChunks.Num(), PendingChunks.Num());
 }
 
 void APlanetActor::GenerateAllChunks()
 {
-    // Clear existing chunks and mesh components
-    PlanetChunks.Empty();
-    
-    // Destroy existing mesh components
-    for (UProceduralMeshComponent* MeshComp : MeshComponents)
-    {
-        if (MeshComp && IsValid(MeshComp))
-        {
-            MeshComp->DestroyComponent();
-        }
-    }
-    MeshComponents.Empty();
-    
     // Calculate chunk bounds exactly like Rust implementation
     // Rust uses: chunks_extent = Extent3i::from_min_and_lub(IVec3::from([-5; 3]), IVec3::from([5; 3]))
     // Which creates a 10x10x10 grid centered around origin
-    float HalfExtent = (ChunksPerAxis / 2) * ChunkSize;
     FVector PlanetCenter = GetActorLocation();
-    FVector StartPosition = PlanetCenter - FVector(HalfExtent, HalfExtent, HalfExtent);
+    FVector StartPosition = GetChunkGridOrigin();
+
+    const SurfaceNetsCore::FNoiseSettings NoiseSettings = NoiseGenerator->GetNoiseSettings();
+    ConfigureDensityCache(NoiseSettings, StartPosition);
+
+    // A few noise samples per chunk bound its density, ruling out the chunks entirely inside or outside the terrain
+    NoiseBounds = Preset ? Preset->GetNoiseBounds() : SurfaceNetsCore::FNoiseBounds::Build(NoiseSettings);
+    OccupancyPyramid.Build(NoiseSettings, NoiseBounds, SurfaceNetsBridge::ToCore(StartPosition), ChunkSize,
+                           ChunkSize / FPlanetChunk::UNPADDED_CHUNK_SIZE, ChunksPerAxis);
     
     UE_LOG(LogSurfaceNets, Log, TEXT("Generating chunks from %s to %s (ChunkSize: %f)"), 
            *StartPosition.ToString(), 
            *(StartPosition + FVector(ChunksPerAxis * ChunkSize)).ToString(),
            ChunkSize);
     
+    // Whatever is still generating belongs to the planet being replaced
+    CancelChunkBatches();
+    const bool bAsync = bAsyncGeneration && GetWorld() && GetWorld()->IsGameWorld();
+
     // Generate chunks in a grid pattern (equivalent to Rust chunks_extent.iter3())
     int32 GeneratedChunks = 0;
     int32 ProcessedChunks = 0;
+    int32 SkippedChunks = 0;
+    TArray<FPlanetChunkBuild> Builds;
+    TArray<FPlanetChunkRequest> Requests;
+    if (bAsync)
+    {
+        Requests.Reserve(ChunksPerAxis * ChunksPerAxis * ChunksPerAxis);
+    }
+    else
+    {
+        Builds.Reserve(ChunksPerAxis * ChunksPerAxis * ChunksPerAxis);
+    }
     
     for (int32 X = 0; X < ChunksPerAxis; X++)
     {
@@ -121,83 +190,925 @@ void APlanetActor::GenerateAllChunks()
                     UE_LOG(LogSurfaceNets, Log, TEXT("Chunk (%d,%d,%d) at %s, distance from center: %f (radius: %f)"), 
                            X, Y, Z, *ChunkCenter.ToString(), DistanceFromCenter, PlanetRadius);
                 }
+
+                // Solid and empty chunks have no mesh, collision or navigation; they are not even sampled
+                if (OccupancyPyramid.ClassifyCell(SurfaceNetsCore::FIntVec3(X, Y, Z)) != SurfaceNetsCore::EOccupancy::Surface)
+                {
+                    SkippedChunks++;
+                    continue;
+                }
+
+                if (bAsync)
+                {
+                    FPlanetChunkRequest& Request = Requests.AddDefaulted_GetRef();
+                    Request.Coordinates = FIntVector(X, Y, Z);
+                    Request.Center = ChunkCenter;
+                    continue;
+                }
                 
                 // Generate chunk - let the chunk itself determine if it has surface intersection
-                if (GenerateChunk(X, Y, Z, ChunkCenter))
+                if (BuildChunk(X, Y, Z, ChunkCenter, Builds.AddDefaulted_GetRef()))
                 {
                     GeneratedChunks++;
                 }
             }
         }
     }
+
+    if (bAsync)
+    {
+        QueueChunkBatch(Requests, true);
+        UE_LOG(LogSurfaceNets, Log, TEXT("Queued %d chunks for generation on worker threads (%d solid or empty)"), Requests.Num(), SkippedChunks);
+        return;
+    }
+
+    // The old planet stays visible until here; the new one replaces it within this frame
+    ReplaceAllChunks(Builds);
     
-    UE_LOG(LogSurfaceNets, Log, TEXT("Generated %d chunks for sphere (out of %d total grid positions)"), 
-           GeneratedChunks, ProcessedChunks);
+    UE_LOG(LogSurfaceNets, Log, TEXT("Generated %d chunks for sphere (out of %d total grid positions, %d solid or empty)"), 
+           GeneratedChunks, ProcessedChunks, SkippedChunks);
+}
+
+void APlanetActor::ReplaceAllChunks(TArray<FPlanetChunkBuild>& Builds)
+{
+    PlanetChunks.Empty();
+    ChunkIndices.Empty();
+    NavPortals.Empty();
+    SwapInChunks(Builds);
+
+    // Grid positions that no longer exist, e.g. after ChunksPerAxis shrank
+    for (auto It = ChunkComponents.CreateIterator(); It; ++It)
+    {
+        if (!ChunkIndices.Contains(It.Key()))
+        {
+            RetireMeshComponent(It.Value());
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void APlanetActor::HandlePresetChanged(UPlanetPreset* ChangedPreset)
+{
+    if (ChangedPreset == Preset && NoiseGenerator)
+    {
+        InitializePlanet();
+    }
+}
+
+SurfaceNetsCore::EOccupancy APlanetActor::ClassifyChunks(const FIntVector& Min, const FIntVector& Max) const
+{
+    return OccupancyPyramid.ClassifyRange(SurfaceNetsBridge::ToCore(Min), SurfaceNetsBridge::ToCore(Max));
+}
+
+FPlanetBuildInputs APlanetActor::GatherBuildInputs() const
+{
+    FPlanetBuildInputs Inputs;
+    Inputs.NoiseSettings = NoiseGenerator->GetNoiseSettings();
+    Inputs.GridOrigin = GetChunkGridOrigin();
+    Inputs.ChunkSize = ChunkSize;
+    Inputs.ChunksPerAxis = ChunksPerAxis;
+    Inputs.MeshingSettings = MeshingSettings;
+    Inputs.bEnableCollision = bEnableCollision;
+    Inputs.PlanetMaterial = PlanetMaterial;
+    Inputs.bBuildNavigation = bBuildNavigation;
+    Inputs.NavMaxSlopeDegrees = NavMaxSlopeDegrees;
+    return Inputs;
+}
+
+bool APlanetActor::UpdateChunksInPlace(const FPlanetBuildInputs& Inputs)
+{
+    // Batches in flight were launched with the old settings and would swap in over anything updated here
+    if (!BuiltInputs.IsSet() || ChunkBatches.Num() > 0 || PendingChunks.Num() > 0)
+    {
+        return false;
+    }
+
+    const FPlanetBuildInputs& Built = BuiltInputs.GetValue();
+    if (!(Built.NoiseSettings == Inputs.NoiseSettings) || !Built.GridOrigin.Equals(Inputs.GridOrigin, 0.0)
+        || Built.ChunkSize != Inputs.ChunkSize || Built.ChunksPerAxis != Inputs.ChunksPerAxis)
+    {
+        return false;
+    }
+
+    ConfigureDensityCache(Inputs.NoiseSettings, Inputs.GridOrigin);
+
+    // Remeshed chunks get new components, which pick up the current material, collision and navigation anyway
+    if (!(Built.MeshingSettings == Inputs.MeshingSettings))
+    {
+        RemeshSurfaceChunks();
+        return true;
+    }
+
+    const bool bMaterialChanged = Built.PlanetMaterial.Get() != Inputs.PlanetMaterial.Get();
+    const bool bCollisionChanged = Built.bEnableCollision != Inputs.bEnableCollision;
+    const bool bNavigationChanged = Built.bBuildNavigation != Inputs.bBuildNavigation || Built.NavMaxSlopeDegrees != Inputs.NavMaxSlopeDegrees;
+
+    if (bMaterialChanged || bCollisionChanged)
+    {
+        for (const TPair<FIntVector, UPlanetChunkMeshComponent*>& Pair : ChunkComponents)
+        {
+            UPlanetChunkMeshComponent* MeshComponent = Pair.Value;
+            if (!IsValid(MeshComponent))
+            {
+                continue;
+            }
+
+            if (bMaterialChanged)
+            {
+                ApplyChunkMaterial(MeshComponent);
+            }
+
+            if (bCollisionChanged)
+            {
+                const int32* ChunkIndex = ChunkIndices.Find(Pair.Key);
+                if (bEnableCollision && ChunkIndex)
+                {
+                    const FPlanetChunk& Chunk = *PlanetChunks[*ChunkIndex];
+                    MeshComponent->SetCollisionMesh(Chunk.Vertices, Chunk.Triangles);
+                    MeshComponent->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+                }
+                else
+                {
+                    MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+                    MeshComponent->ClearCollisionMesh();
+                }
+            }
+        }
+    }
+
+    if (bNavigationChanged)
+    {
+        for (int32 ChunkIndex = 0; ChunkIndex < PlanetChunks.Num(); ChunkIndex++)
+        {
+            UpdateChunkNavigation(ChunkIndex);
+        }
+    }
+
+    UE_LOG(LogSurfaceNets, Log, TEXT("Kept %d chunks (material %s, collision %s, navigation %s)"), PlanetChunks.Num(),
+           bMaterialChanged ? TEXT("updated") : TEXT("unchanged"),
+           bCollisionChanged ? TEXT("updated") : TEXT("unchanged"),
+           bNavigationChanged ? TEXT("rebuilt") : TEXT("unchanged"));
+    return true;
+}
+
+void APlanetActor::RemeshSurfaceChunks()
+{
+    const FVector GridOrigin = GetChunkGridOrigin();
+    const bool bAsync = bAsyncGeneration && GetWorld() && GetWorld()->IsGameWorld();
+
+    TArray<FPlanetChunkBuild> Builds;
+    TArray<FPlanetChunkRequest> Requests;
+    for (const TPair<FIntVector, int32>& Pair : ChunkIndices)
+    {
+        if (!PlanetChunks[Pair.Value]->bHasSurface)
+        {
+            continue;
+        }
+
+        const FIntVector& Coordinates = Pair.Key;
+        const FVector ChunkCenter = GridOrigin + (FVector(Coordinates) + FVector(0.5f)) * ChunkSize;
+        if (bAsync)
+        {
+            FPlanetChunkRequest& Request = Requests.AddDefaulted_GetRef();
+            Request.Coordinates = Coordinates;
+            Request.Center = ChunkCenter;
+        }
+        else
+        {
+            BuildChunk(Coordinates.X, Coordinates.Y, Coordinates.Z, ChunkCenter, Builds.AddDefaulted_GetRef());
+        }
+    }
+
+    UE_LOG(LogSurfaceNets, Log, TEXT("Remeshing %d of %d chunks with new mesher settings"), FMath::Max(Builds.Num(), Requests.Num()), PlanetChunks.Num());
+    if (bAsync)
+    {
+        if (Requests.Num() > 0)
+        {
+            QueueChunkBatch(Requests, false);
+        }
+        return;
+    }
+    SwapInChunks(Builds);
 }
 
-bool APlanetActor::GenerateChunk(int32 X, int32 Y, int32 Z, const FVector& ChunkCenter)
+void APlanetActor::ConfigureDensityCache(const SurfaceNetsCore::FNoiseSettings& NoiseSettings, const FVector& GridOrigin)
 {
+    // Cached densities stay valid as long as the noise and chunk grid match
+    if (bCacheDensity)
+    {
+        const int64 BudgetBytes = static_cast<int64>(FMath::Max(DensityCacheBudgetMB, 1)) * 1024 * 1024;
+
+        // Workers of a cancelled batch may still add grids of the old function; they keep the old cache to themselves
+        if (DensityCache.IsValid() && NumChunksInFlight > 0 && !DensityCache->HasSource(NoiseSettings, GridOrigin, ChunkSize))
+        {
+            DensityCache.Reset();
+        }
+        if (!DensityCache.IsValid())
+        {
+            DensityCache = MakeShared<FDensityCache>(BudgetBytes);
+        }
+        DensityCache->SetBudget(BudgetBytes);
+        DensityCache->SetSource(NoiseSettings, GridOrigin, ChunkSize);
+    }
+    else
+    {
+        DensityCache.Reset();
+    }
+}
+
+FVector APlanetActor::GetChunkGridOrigin() const
+{
+    const float HalfExtent = (ChunksPerAxis / 2) * ChunkSize;
+    return GetActorLocation() - FVector(HalfExtent, HalfExtent, HalfExtent);
+}
+
+bool APlanetActor::BuildChunk(int32 X, int32 Y, int32 Z, const FVector& ChunkCenter, FPlanetChunkBuild& OutBuild)
+{
+    OutBuild.Coordinates = FIntVector(X, Y, Z);
+
     // CRITICAL FIX: Null check before passing NoiseGenerator
     if (!NoiseGenerator)
     {
-        UE_LOG(LogSurfaceNets, Error, TEXT("NoiseGenerator is null in GenerateChunk"));
+        UE_LOG(LogSurfaceNets, Error, TEXT("NoiseGenerator is null in BuildChunk"));
         return false;
     }
     
     // Create chunk with proper LOD level
     TUniquePtr<FPlanetChunk> NewChunk = MakeUnique<FPlanetChunk>(ChunkCenter, 0, ChunkSize);
+    NewChunk->ChunkCoordinates = OutBuild.Coordinates;
     
     // Generate mesh using the chunk's GenerateMesh method (equivalent to Rust generate_and_process_chunk)
-    bool bMeshGenerated = NewChunk->GenerateMesh(NoiseGenerator);
+    bool bMeshGenerated = NewChunk->GenerateMesh(NoiseGenerator, MeshingSettings, DensityCache.Get(), true);
+    OutBuild.MeshComponent = CreateChunkMeshComponent(*NewChunk);
     
+    // Always keep the chunk (even if it has no mesh) for consistency
+    OutBuild.Chunk = MoveTemp(NewChunk);
+    return bMeshGenerated;
+}
+
+UPlanetChunkMeshComponent* APlanetActor::CreateChunkMeshComponent(FPlanetChunk& Chunk)
+{
     // Only create mesh component if chunk has valid mesh data (like Rust early return)
-    if (bMeshGenerated && NewChunk->Vertices.Num() > 0 && NewChunk->Triangles.Num() > 0)
-    {
-        // Create mesh component
-        UProceduralMeshComponent* MeshComponent = CreateMeshComponent();
-        
-        // Create mesh section using the chunk's mesh data
-        TArray<FColor> VertexColors;
-        TArray<FProcMeshTangent> Tangents;
-        
-        MeshComponent->CreateMeshSection(
-            0,
-            NewChunk->Vertices,
-            NewChunk->Triangles,
-            NewChunk->Normals,
-            NewChunk->UVs,
-            VertexColors,
-            Tangents,
-            bEnableCollision
-        );
-        
-        // Apply material
-        if (PlanetMaterial)
-        {
-            MeshComponent->SetMaterial(0, PlanetMaterial);
-        }
-        
-        // Store mesh component reference
-        MeshComponents.Add(MeshComponent);
-        
-        UE_LOG(LogSurfaceNets, Log, TEXT("Generated chunk at (%d,%d,%d) with %d vertices, %d triangles"), 
-               X, Y, Z, NewChunk->Vertices.Num(), NewChunk->Triangles.Num() / 3);
-    }
-    else
+    if (Chunk.Vertices.Num() == 0 || Chunk.Triangles.Num() == 0)
     {
         // Debug logging for first few failed chunks
         static int32 LoggedFailures = 0;
         if (LoggedFailures < 5)
         {
-            UE_LOG(LogSurfaceNets, Warning, TEXT("Chunk at (%d,%d,%d) center %s skipped - no surface intersection"), 
-                   X, Y, Z, *ChunkCenter.ToString());
+            UE_LOG(LogSurfaceNets, Warning, TEXT("Chunk at %s center %s skipped - no surface intersection"), 
+                   *Chunk.ChunkCoordinates.ToString(), *Chunk.Position.ToString());
             LoggedFailures++;
         }
+        return nullptr;
     }
+
+    // Hidden and without collision until the batch is swapped in
+    UPlanetChunkMeshComponent* MeshComponent = CreateMeshComponent();
+    MeshComponent->SetVisibility(false);
+    MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
     
-    // Always store the chunk (even if it has no mesh) for consistency
-    PlanetChunks.Add(MoveTemp(NewChunk));
-    return bMeshGenerated;
+    // The render buffers were written by the mesher; only collision is built from the game-side arrays
+    MeshComponent->SetRenderData(MoveTemp(Chunk.RenderData));
+    if (bEnableCollision)
+    {
+        MeshComponent->SetCollisionMesh(Chunk.Vertices, Chunk.Triangles);
+    }
+    
+    // Apply material
+    if (PlanetMaterial)
+    {
+        MeshComponent->SetMaterial(0, PlanetMaterial);
+    }
+    
+    UE_LOG(LogSurfaceNets, Log, TEXT("Generated chunk at %s with %d vertices, %d triangles"), 
+           *Chunk.ChunkCoordinates.ToString(), Chunk.Vertices.Num(), Chunk.Triangles.Num() / 3);
+    return MeshComponent;
+}
+
+void APlanetActor::QueueChunkBatch(TArray<FPlanetChunkRequest>& Requests, bool bReplaceAll)
+{
+    // A resize waits until nothing is in flight, the workers hold on to the queue they were launched with
+    const int32 Capacity = FMath::Max(MaxChunksInFlight, 1);
+    if (!ChunkQueue.IsValid() || (NumChunksInFlight == 0 && ChunkQueue->GetCapacity() != FMath::RoundUpToPowerOfTwo(static_cast<uint32>(Capacity))))
+    {
+        ChunkQueue = MakeShared<FPlanetChunkQueue>(Capacity);
+    }
+
+    // Same for the workers, destroying the pool drops the chunks still queued on it
+    if (NumChunksInFlight == 0 && (WorkerPool.IsValid() ? !(WorkerPool->GetSettings() == GenerationWorkers) : GenerationWorkers.Groups.Num() > 0))
+    {
+        WorkerPool.Reset();
+        if (GenerationWorkers.Groups.Num() > 0)
+        {
+            WorkerPool = MakeUnique<FPlanetWorkerPool>(GenerationWorkers);
+        }
+    }
+
+    FPlanetChunkBatch& Batch = ChunkBatches.AddDefaulted_GetRef();
+    Batch.BatchId = ++NextBatchId;
+    Batch.bReplaceAll = bReplaceAll;
+    Batch.NumRemaining = Requests.Num();
+    Batch.Builds.Reserve(Requests.Num());
+
+    for (FPlanetChunkRequest& Request : Requests)
+    {
+        Request.BatchId = Batch.BatchId;
+    }
+    PendingChunks.Append(MoveTemp(Requests));
+
+    LaunchPendingChunks();
+    SetActorTickEnabled(true);
+}
+
+void APlanetActor::LaunchPendingChunks()
+{
+    if (!ChunkQueue.IsValid() || PendingChunks.Num() == 0 || !NoiseGenerator)
+    {
+        return;
+    }
+
+    // Workers only see copies, the noise generator and settings may change while they run
+    const SurfaceNetsCore::FNoiseSettings NoiseSettings = NoiseGenerator->GetNoiseSettings();
+    const int32 MaxInFlight = FMath::Min(FMath::Max(MaxChunksInFlight, 1), static_cast<int32>(ChunkQueue->GetCapacity()));
+
+    int32 NumLaunched = 0;
+    while (NumLaunched < PendingChunks.Num() && NumChunksInFlight < MaxInFlight)
+    {
+        const FPlanetChunkRequest Request = PendingChunks[NumLaunched++];
+        NumChunksInFlight++;
+
+        auto GenerateChunk =
+            [Queue = ChunkQueue,
+             Cache = DensityCache,
+             NoiseSettings,
+             Settings = MeshingSettings,
+             Size = ChunkSize,
+             Request]()
+            {
+                FPlanetChunkResult Result;
+                Result.BatchId = Request.BatchId;
+                Result.Coordinates = Request.Coordinates;
+                Result.Chunk = MakeUnique<FPlanetChunk>(Request.Center, 0, Size);
+                Result.Chunk->ChunkCoordinates = Request.Coordinates;
+                Result.Chunk->GenerateMesh(NoiseSettings, Settings, Cache.Get(), true);
+
+                // In-flight chunks never outnumber the slots, so this only spins if that accounting is broken
+                while (!Queue->TryPush(MoveTemp(Result)))
+                {
+                    FPlatformProcess::Yield();
+                }
+            };
+
+        if (WorkerPool.IsValid())
+        {
+            WorkerPool->Launch(MoveTemp(GenerateChunk));
+        }
+        else
+        {
+            UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(GenerateChunk));
+        }
+    }
+    PendingChunks.RemoveAt(0, NumLaunched, EAllowShrinking::No);
+}
+
+void APlanetActor::DrainChunkQueue()
+{
+    SCOPE_CYCLE_COUNTER(STAT_DrainChunkQueue);
+    if (!ChunkQueue.IsValid())
+    {
+        return;
+    }
+
+    SET_DWORD_STAT(STAT_ChunkQueueDepth, ChunkQueue->Num());
+    const SurfaceNetsCore::FCompletionQueueStats StatsBefore = ChunkQueue->GetStats();
+
+    // Mesh component creation is the game thread's share of the work; one chunk always goes through so a tiny
+    // budget still makes progress
+    const double StartTime = FPlatformTime::Seconds();
+    const double BudgetSeconds = ChunkUploadBudgetMs / 1000.0;
+    FPlanetChunkResult Result;
+    while (ChunkQueue->TryPop(Result))
+    {
+        NumChunksInFlight--;
+
+        FPlanetChunkBatch* Batch = ChunkBatches.FindByPredicate([&Result](const FPlanetChunkBatch& Candidate)
+        {
+            return Candidate.BatchId == Result.BatchId;
+        });
+        if (Batch && Result.Chunk.IsValid())
+        {
+            FPlanetChunkBuild& Build = Batch->Builds.AddDefaulted_GetRef();
+            Build.Coordinates = Result.Coordinates;
+            Build.MeshComponent = CreateChunkMeshComponent(*Result.Chunk);
+            Build.Chunk = MoveTemp(Result.Chunk);
+            Batch->NumRemaining--;
+        }
+        Result.Chunk.Reset(); // From a cancelled batch
+
+        if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+        {
+            break;
+        }
+    }
+
+    // Popped slots go straight back to the workers
+    LaunchPendingChunks();
+
+    // Batches swap in order, so an edit queued during a full regeneration lands on top of it
+    while (ChunkBatches.Num() > 0 && ChunkBatches[0].NumRemaining == 0)
+    {
+        FPlanetChunkBatch Batch = MoveTemp(ChunkBatches[0]);
+        ChunkBatches.RemoveAt(0);
+
+        if (Batch.bReplaceAll)
+        {
+            ReplaceAllChunks(Batch.Builds);
+        }
+        else
+        {
+            SwapInChunks(Batch.Builds);
+        }
+        UE_LOG(LogSurfaceNets, Log, TEXT("Swapped in chunk batch %d (%d chunks)"), Batch.BatchId, PlanetChunks.Num());
+    }
+
+    const SurfaceNetsCore::FCompletionQueueStats& StatsAfter = ChunkQueue->GetStats();
+    const uint64 NumPopped = StatsAfter.NumPopped - StatsBefore.NumPopped;
+    SET_DWORD_STAT(STAT_ChunksInFlight, NumChunksInFlight);
+    SET_FLOAT_STAT(STAT_ChunkQueueLatency, NumPopped > 0 ? (StatsAfter.TotalLatencySeconds - StatsBefore.TotalLatencySeconds) * 1000.0 / NumPopped : 0.0);
+
+    const SurfaceNetsCore::FSlabAllocatorStats SlabStats = SurfaceNetsCore::FSlabAllocator::Get().GetStats();
+    SET_MEMORY_STAT(STAT_ChunkSlabReserved, SlabStats.ReservedBytes);
+    SET_MEMORY_STAT(STAT_ChunkSlabInUse, SlabStats.InUseBytes);
+    SET_MEMORY_STAT(STAT_ChunkSlabPeakInUse, SlabStats.PeakInUseBytes);
+}
+
+void APlanetActor::CancelChunkBatches()
+{
+    for (FPlanetChunkBatch& Batch : ChunkBatches)
+    {
+        for (const FPlanetChunkBuild& Build : Batch.Builds)
+        {
+            if (IsValid(Build.MeshComponent))
+            {
+                Build.MeshComponent->DestroyComponent();
+            }
+        }
+    }
+    ChunkBatches.Empty();
+    PendingChunks.Empty();
+}
+
+void APlanetActor::SwapInChunks(TArray<FPlanetChunkBuild>& Builds)
+{
+    for (FPlanetChunkBuild& Build : Builds)
+    {
+        if (!Build.Chunk.IsValid())
+        {
+            continue;
+        }
+
+        if (UPlanetChunkMeshComponent* OldComponent = ChunkComponents.FindRef(Build.Coordinates))
+        {
+            RetireMeshComponent(OldComponent);
+            ChunkComponents.Remove(Build.Coordinates);
+        }
+        if (Build.MeshComponent)
+        {
+            ShowMeshComponent(Build.MeshComponent);
+            ChunkComponents.Add(Build.Coordinates, Build.MeshComponent);
+        }
+
+        int32 ChunkIndex = INDEX_NONE;
+        if (const int32* ExistingIndex = ChunkIndices.Find(Build.Coordinates))
+        {
+            // Carry the old graph over so its portals are unlinked when the new one is installed
+            ChunkIndex = *ExistingIndex;
+            Build.Chunk->NavGraph = PlanetChunks[ChunkIndex]->NavGraph;
+            Build.Chunk->NavRevision = PlanetChunks[ChunkIndex]->NavRevision;
+            PlanetChunks[ChunkIndex] = MoveTemp(Build.Chunk);
+        }
+        else
+        {
+            ChunkIndex = PlanetChunks.Add(MoveTemp(Build.Chunk));
+            ChunkIndices.Add(Build.Coordinates, ChunkIndex);
+        }
+
+        UpdateChunkNavigation(ChunkIndex);
+    }
+    Builds.Reset();
+}
+
+void APlanetActor::ShowMeshComponent(UPlanetChunkMeshComponent* MeshComponent)
+{
+    MeshComponent->SetVisibility(true);
+    MeshComponent->SetCollisionEnabled(bEnableCollision ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+
+    if (bCrossfadeChunkSwaps && ChunkCrossfadeSeconds > 0.0f)
+    {
+        StartChunkFade(MeshComponent, true);
+    }
+}
+
+void APlanetActor::RetireMeshComponent(UPlanetChunkMeshComponent* MeshComponent)
+{
+    if (!IsValid(MeshComponent))
+    {
+        return;
+    }
+
+    MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    if (bCrossfadeChunkSwaps && ChunkCrossfadeSeconds > 0.0f)
+    {
+        StartChunkFade(MeshComponent, false);
+    }
+    else
+    {
+        MeshComponent->DestroyComponent();
+    }
+}
+
+void APlanetActor::ApplyChunkMaterial(UPlanetChunkMeshComponent* MeshComponent)
+{
+    // A fading-in component keeps fading from its current opacity on an instance of the new material
+    for (int32 Index = 0; Index < ChunkFades.Num(); Index++)
+    {
+        FPlanetChunkFade& Fade = ChunkFades[Index];
+        if (Fade.Component != MeshComponent)
+        {
+            continue;
+        }
+
+        if (PlanetMaterial)
+        {
+            Fade.Material = UMaterialInstanceDynamic::Create(PlanetMaterial, this);
+            Fade.Material->SetScalarParameterValue(ChunkFadeParameterName, Fade.Opacity);
+            MeshComponent->SetMaterial(0, Fade.Material);
+            return;
+        }
+        ChunkFades.RemoveAtSwap(Index);
+        break;
+    }
+
+    MeshComponent->SetMaterial(0, PlanetMaterial);
+}
+
+void APlanetActor::StartChunkFade(UPlanetChunkMeshComponent* MeshComponent, bool bFadeIn)
+{
+    // A component replaced while still fading in turns around from its current opacity
+    for (FPlanetChunkFade& Fade : ChunkFades)
+    {
+        if (Fade.Component == MeshComponent)
+        {
+            Fade.bFadeIn = bFadeIn;
+            return;
+        }
+    }
+
+    UMaterialInterface* Material = MeshComponent->GetMaterial(0);
+    if (!Material)
+    {
+        if (!bFadeIn)
+        {
+            MeshComponent->DestroyComponent();
+        }
+        return;
+    }
+
+    FPlanetChunkFade& Fade = ChunkFades.AddDefaulted_GetRef();
+    Fade.Component = MeshComponent;
+    Fade.Material = UMaterialInstanceDynamic::Create(Material, this);
+    Fade.Opacity = bFadeIn ? 0.0f : 1.0f;
+    Fade.bFadeIn = bFadeIn;
+    Fade.Material->SetScalarParameterValue(ChunkFadeParameterName, Fade.Opacity);
+    MeshComponent->SetMaterial(0, Fade.Material);
+
+    SetActorTickEnabled(true);
+}
+
+void APlanetActor::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    if (ChunkBatches.Num() > 0 || NumChunksInFlight > 0)
+    {
+        DrainChunkQueue();
+    }
+
+    const float Step = ChunkCrossfadeSeconds > 0.0f ? DeltaSeconds / ChunkCrossfadeSeconds : 1.0f;
+    for (int32 Index = ChunkFades.Num() - 1; Index >= 0; Index--)
+    {
+        FPlanetChunkFade& Fade = ChunkFades[Index];
+        if (!IsValid(Fade.Component))
+        {
+            ChunkFades.RemoveAtSwap(Index);
+            continue;
+        }
+
+        Fade.Opacity = FMath::Clamp(Fade.Opacity + (Fade.bFadeIn ? Step : -Step), 0.0f, 1.0f);
+        Fade.Material->SetScalarParameterValue(ChunkFadeParameterName, Fade.Opacity);
+
+        if (Fade.bFadeIn && Fade.Opacity >= 1.0f)
+        {
+            // Back on the shared material so finished chunks batch again
+            Fade.Component->SetMaterial(0, Fade.Material->Parent);
+            ChunkFades.RemoveAtSwap(Index);
+        }
+        else if (!Fade.bFadeIn && Fade.Opacity <= 0.0f)
+        {
+            Fade.Component->DestroyComponent();
+            ChunkFades.RemoveAtSwap(Index);
+        }
+    }
+
+    // Keep draining chunks of cancelled batches too, they hold their mesh memory until popped
+    if (ChunkFades.Num() == 0 && ChunkBatches.Num() == 0 && NumChunksInFlight == 0)
+    {
+        SetActorTickEnabled(false);
+    }
+}
+
+void APlanetActor::RegenerateChunksInBounds(const FBox& Bounds)
+{
+    if (!NoiseGenerator || ChunkSize <= 0.0f)
+    {
+        return;
+    }
+
+    // Neighbours whose padding samples reach into Bounds change along their shared face too
+    const FVector GridOrigin = GetChunkGridOrigin();
+    const FBox Expanded = Bounds.ExpandBy(ChunkSize / FPlanetChunk::UNPADDED_CHUNK_SIZE);
+    const FIntVector Min(
+        FMath::Max(FMath::FloorToInt((Expanded.Min.X - GridOrigin.X) / ChunkSize), 0),
+        FMath::Max(FMath::FloorToInt((Expanded.Min.Y - GridOrigin.Y) / ChunkSize), 0),
+        FMath::Max(FMath::FloorToInt((Expanded.Min.Z - GridOrigin.Z) / ChunkSize), 0));
+    const FIntVector Max(
+        FMath::Min(FMath::FloorToInt((Expanded.Max.X - GridOrigin.X) / ChunkSize), ChunksPerAxis - 1),
+        FMath::Min(FMath::FloorToInt((Expanded.Max.Y - GridOrigin.Y) / ChunkSize), ChunksPerAxis - 1),
+        FMath::Min(FMath::FloorToInt((Expanded.Max.Z - GridOrigin.Z) / ChunkSize), ChunksPerAxis - 1));
+
+    // Batches already in flight swap in first, an edit must not be overwritten by one of them
+    const bool bAsync = (bAsyncGeneration && GetWorld() && GetWorld()->IsGameWorld()) || ChunkBatches.Num() > 0;
+
+    TArray<FPlanetChunkBuild> Builds;
+    TArray<FPlanetChunkRequest> Requests;
+    for (int32 X = Min.X; X <= Max.X; X++)
+    {
+        for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+        {
+            for (int32 Z = Min.Z; Z <= Max.Z; Z++)
+            {
+                if (DensityCache.IsValid())
+                {
+                    DensityCache->Remove(FDensityCacheKey{ FIntVector(X, Y, Z), 0 });
+                }
+
+                // Solid and empty chunks are neither sampled nor built, as in GenerateAllChunks; the density only
+                // depends on the noise settings, so the pyramid built from them still classifies these cells
+                if (OccupancyPyramid.ClassifyCell(SurfaceNetsCore::FIntVec3(X, Y, Z)) != SurfaceNetsCore::EOccupancy::Surface)
+                {
+                    continue;
+                }
+
+                const FVector ChunkCenter = GridOrigin + (FVector(X, Y, Z) + FVector(0.5f)) * ChunkSize;
+                if (bAsync)
+                {
+                    FPlanetChunkRequest& Request = Requests.AddDefaulted_GetRef();
+                    Request.Coordinates = FIntVector(X, Y, Z);
+                    Request.Center = ChunkCenter;
+                }
+                else
+                {
+                    BuildChunk(X, Y, Z, ChunkCenter, Builds.AddDefaulted_GetRef());
+                }
+            }
+        }
+    }
+
+    if (bAsync)
+    {
+        UE_LOG(LogSurfaceNets, Verbose, TEXT("Queued %d chunks for regeneration in %s"), Requests.Num(), *Bounds.ToString());
+        if (Requests.Num() > 0)
+        {
+            QueueChunkBatch(Requests, false);
+        }
+        return;
+    }
+
+    UE_LOG(LogSurfaceNets, Verbose, TEXT("Regenerated %d chunks in %s"), Builds.Num(), *Bounds.ToString());
+    SwapInChunks(Builds);
+}
+
+void APlanetActor::RebuildNavigationInBounds(const FBox& Bounds)
+{
+    for (int32 ChunkIndex = 0; ChunkIndex < PlanetChunks.Num(); ChunkIndex++)
+    {
+        if (PlanetChunks[ChunkIndex].IsValid() && PlanetChunks[ChunkIndex]->GetBounds().Intersect(Bounds))
+        {
+            RebuildChunkNavigation(ChunkIndex);
+        }
+    }
+}
+
+void APlanetActor::UpdateChunkNavigation(int32 ChunkIndex)
+{
+    if (bBuildNavigation)
+    {
+        RebuildChunkNavigation(ChunkIndex);
+    }
+    else if (PlanetChunks[ChunkIndex]->NavGraph.IsValid())
+    {
+        const int32 Revision = ++NextNavRevision;
+        PlanetChunks[ChunkIndex]->NavRevision = Revision;
+        SetChunkNavGraph(ChunkIndex, Revision, nullptr);
+    }
+}
+
+void APlanetActor::RebuildChunkNavigation(int32 ChunkIndex)
+{
+    FPlanetChunk& Chunk = *PlanetChunks[ChunkIndex];
+    const int32 Revision = ++NextNavRevision;
+    Chunk.NavRevision = Revision;
+
+    if (Chunk.Vertices.Num() == 0 || Chunk.Triangles.Num() == 0)
+    {
+        SetChunkNavGraph(ChunkIndex, Revision, nullptr);
+        return;
+    }
+
+    // The worker gets its own copy of the mesh, the chunk may be regenerated or destroyed before it finishes
+    UE::Tasks::Launch(UE_SOURCE_LOCATION,
+        [WeakThis = TWeakObjectPtr<APlanetActor>(this),
+         ChunkIndex,
+         Revision,
+         NavSettings = Chunk.MakeNavSettings(GetActorLocation(), NavMaxSlopeDegrees),
+         Vertices = Chunk.Vertices,
+         Triangles = Chunk.Triangles,
+         Normals = Chunk.Normals]()
+        {
+            TSharedPtr<const SurfaceNetsCore::FSurfaceNavGraph> NavGraph = FPlanetChunk::BuildNavGraph(Vertices, Triangles, Normals, NavSettings);
+
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, ChunkIndex, Revision, NavGraph = MoveTemp(NavGraph)]()
+            {
+                if (APlanetActor* Planet = WeakThis.Get())
+                {
+                    Planet->SetChunkNavGraph(ChunkIndex, Revision, NavGraph);
+                }
+            });
+        });
+}
+
+void APlanetActor::SetChunkNavGraph(int32 ChunkIndex, int32 Revision, TSharedPtr<const SurfaceNetsCore::FSurfaceNavGraph> NavGraph)
+{
+    if (!PlanetChunks.IsValidIndex(ChunkIndex) || !PlanetChunks[ChunkIndex].IsValid() || PlanetChunks[ChunkIndex]->NavRevision != Revision)
+    {
+        return; // Superseded by a newer build or a regenerated planet
+    }
+
+    FPlanetChunk& Chunk = *PlanetChunks[ChunkIndex];
+
+    // Unlink the previous graph's portals before its node ids go stale
+    if (Chunk.NavGraph.IsValid())
+    {
+        for (size_t Portal = 0; Portal < Chunk.NavGraph->PortalNodes.size(); Portal++)
+        {
+            const uint64 Key = Chunk.NavGraph->PortalKeys[Portal];
+            if (TArray<uint64>* Nodes = NavPortals.Find(Key))
+            {
+                Nodes->Remove(MakeNavNodeId(ChunkIndex, Chunk.NavGraph->PortalNodes[Portal]));
+                if (Nodes->Num() == 0)
+                {
+                    NavPortals.Remove(Key);
+                }
+            }
+        }
+    }
+
+    Chunk.NavGraph = MoveTemp(NavGraph);
+
+    if (Chunk.NavGraph.IsValid())
+    {
+        for (size_t Portal = 0; Portal < Chunk.NavGraph->PortalNodes.size(); Portal++)
+        {
+            NavPortals.FindOrAdd(Chunk.NavGraph->PortalKeys[Portal]).Add(MakeNavNodeId(ChunkIndex, Chunk.NavGraph->PortalNodes[Portal]));
+        }
+
+        UE_LOG(LogSurfaceNets, Verbose, TEXT("Navigation for chunk at %s: %d nodes, %d portals"),
+               *Chunk.Position.ToString(), Chunk.NavGraph->NumNodes(), static_cast<int32>(Chunk.NavGraph->PortalNodes.size()));
+    }
+}
+
+bool APlanetActor::FindNearestNavNode(const FVector& Point, uint64& OutNodeId) const
+{
+    const SurfaceNetsCore::FVec3 CorePoint = SurfaceNetsBridge::ToCore(Point);
+    double NearestDistanceSquared = TNumericLimits<double>::Max();
+
+    for (int32 ChunkIndex = 0; ChunkIndex < PlanetChunks.Num(); ChunkIndex++)
+    {
+        const FPlanetChunk* Chunk = PlanetChunks[ChunkIndex].Get();
+        if (!Chunk || !Chunk->NavGraph.IsValid() || !Chunk->GetBounds().ExpandBy(Chunk->Size * 0.5f).IsInside(Point))
+        {
+            continue;
+        }
+
+        const int32 Node = Chunk->NavGraph->FindNearestNode(CorePoint, Chunk->Size * 0.5f);
+        if (Node < 0)
+        {
+            continue;
+        }
+
+        const double DistanceSquared = (Chunk->NavGraph->NodePositions[Node] - CorePoint).SizeSquared();
+        if (DistanceSquared < NearestDistanceSquared)
+        {
+            NearestDistanceSquared = DistanceSquared;
+            OutNodeId = MakeNavNodeId(ChunkIndex, Node);
+        }
+    }
+
+    return NearestDistanceSquared < TNumericLimits<double>::Max();
+}
+
+bool APlanetActor::FindSurfacePath(const FVector& Start, const FVector& End, TArray<FVector>& OutPath) const
+{
+    OutPath.Reset();
+
+    uint64 StartNode = 0;
+    uint64 GoalNode = 0;
+    if (!FindNearestNavNode(Start, StartNode) || !FindNearestNavNode(End, GoalNode))
+    {
+        return false;
+    }
+
+    auto NodePosition = [this](uint64 NodeId) -> const SurfaceNetsCore::FVec3&
+    {
+        return PlanetChunks[GetNavChunk(NodeId)]->NavGraph->NodePositions[GetNavNode(NodeId)];
+    };
+    const SurfaceNetsCore::FVec3 GoalPosition = NodePosition(GoalNode);
+
+    std::vector<uint64_t> Path;
+    const bool bFound = SurfaceNetsCore::FindPath(
+        StartNode,
+        GoalNode,
+        [this](uint64_t NodeId, auto&& Visit)
+        {
+            const int32 ChunkIndex = GetNavChunk(NodeId);
+            const int32 Node = GetNavNode(NodeId);
+            const SurfaceNetsCore::FSurfaceNavGraph& NavGraph = *PlanetChunks[ChunkIndex]->NavGraph;
+
+            for (int32 Link = NavGraph.LinkOffsets[Node]; Link < NavGraph.LinkOffsets[Node + 1]; Link++)
+            {
+                Visit(MakeNavNodeId(ChunkIndex, NavGraph.Links[Link]), NavGraph.LinkCosts[Link]);
+            }
+
+            // Boundary nodes continue into the neighbouring chunk's copy of the same vertex at no cost
+            if (const TArray<uint64>* Portal = NavPortals.Find(NavGraph.PortalKeyOf(Node)))
+            {
+                for (const uint64 Other : *Portal)
+                {
+                    if (Other != NodeId)
+                    {
+                        Visit(Other, 0.0);
+                    }
+                }
+            }
+        },
+        [&NodePosition, &GoalPosition](uint64_t NodeId)
+        {
+            return (NodePosition(NodeId) - GoalPosition).Size();
+        },
+        Path);
+
+    if (!bFound)
+    {
+        return false;
+    }
+
+    OutPath.Reserve(static_cast<int32>(Path.size()));
+    for (const uint64_t NodeId : Path)
+    {
+        OutPath.Add(SurfaceNetsBridge::ToUnreal(NodePosition(NodeId)));
+    }
+    return true;
+}
+
+FPlanetSurfaceQuery APlanetActor::MakeSurfaceQuery() const
+{
+    return NoiseGenerator ? FPlanetSurfaceQuery(NoiseGenerator->GetNoiseSettings(), DensityCache) : FPlanetSurfaceQuery();
+}
+
+bool APlanetActor::RaycastSurface(const FVector& Start, const FVector& End, FVector& OutHitLocation, FVector& OutHitNormal) const
+{
+    return NoiseGenerator && MakeSurfaceQuery().Raycast(Start, End, OutHitLocation, OutHitNormal);
+}
+
+bool APlanetActor::FindClosestSurfacePoint(const FVector& Point, FVector& OutSurfacePoint) const
+{
+    return NoiseGenerator && MakeSurfaceQuery().FindClosestSurfacePoint(Point, OutSurfacePoint);
+}
+
+bool APlanetActor::GetSurfaceHeights(const TArray<FVector>& Locations, TArray<float>& OutHeights) const
+{
+    OutHeights.SetNumZeroed(Locations.Num());
+    return NoiseGenerator && MakeSurfaceQuery().GetSurfaceHeights(Locations, OutHeights);
 }
 
 void APlanetActor::LogPlanetStats()
@@ -216,9 +1127,33 @@ void APlanetActor::LogPlanetStats()
     
     UE_LOG(LogSurfaceNets, Warning, TEXT("Planet Stats:"));
     UE_LOG(LogSurfaceNets, Warning, TEXT("  Generated Chunks: %d"), PlanetChunks.Num());
-    UE_LOG(LogSurfaceNets, Warning, TEXT("  Active Mesh Components: %d"), MeshComponents.Num());
+    UE_LOG(LogSurfaceNets, Warning, TEXT("  Active Mesh Components: %d"), ChunkComponents.Num());
     UE_LOG(LogSurfaceNets, Warning, TEXT("  Total Vertices: %d"), TotalVertices);
     UE_LOG(LogSurfaceNets, Warning, TEXT("  Total Triangles: %d"), TotalTriangles);
     UE_LOG(LogSurfaceNets, Warning, TEXT("  Planet Radius: %f"), PlanetRadius);
     UE_LOG(LogSurfaceNets, Warning, TEXT("  Chunk Size: %f"), ChunkSize);
+
+    if (DensityCache.IsValid())
+    {
+        UE_LOG(LogSurfaceNets, Warning, TEXT("  Density Cache: %d chunks, %.1f MB, %lld hits, %lld misses"),
+               DensityCache->Num(), DensityCache->GetAllocatedBytes() / (1024.0 * 1024.0), DensityCache->GetNumHits(), DensityCache->GetNumMisses());
+    }
+
+    if (ChunkQueue.IsValid())
+    {
+        const SurfaceNetsCore::FCompletionQueueStats& QueueStats = ChunkQueue->GetStats();
+        UE_LOG(LogSurfaceNets, Warning, TEXT("  Chunk Queue: %d batches, %d pending, %d in flight, depth %d (max %d of %d)"),
+               ChunkBatches.Num(), PendingChunks.Num(), NumChunksInFlight, static_cast<int32>(ChunkQueue->Num()),
+               static_cast<int32>(QueueStats.MaxDepth), static_cast<int32>(ChunkQueue->GetCapacity()));
+        UE_LOG(LogSurfaceNets, Warning, TEXT("  Chunk Queue Latency: %.2f ms mean, %.2f ms max over %llu chunks"),
+               QueueStats.AverageLatencySeconds() * 1000.0, QueueStats.MaxLatencySeconds * 1000.0, static_cast<uint64>(QueueStats.NumPopped));
+    }
+
+    const SurfaceNetsCore::FSlabAllocatorStats SlabStats = SurfaceNetsCore::FSlabAllocator::Get().GetStats();
+    UE_LOG(LogSurfaceNets, Warning, TEXT("  Chunk Memory: %.1f MB in use (peak %.1f MB), %.1f MB reserved (peak %.1f MB)"),
+           SlabStats.InUseBytes / (1024.0 * 1024.0), SlabStats.PeakInUseBytes / (1024.0 * 1024.0),
+           SlabStats.ReservedBytes / (1024.0 * 1024.0), SlabStats.PeakReservedBytes / (1024.0 * 1024.0));
+    UE_LOG(LogSurfaceNets, Warning, TEXT("  Chunk Memory Fragmentation: %.1f%% size class rounding, %.1f%% idle in free lists and slabs; %llu allocations, %llu from the system, %llu freed across threads"),
+           SlabStats.InternalFragmentation() * 100.0, SlabStats.ExternalFragmentation() * 100.0,
+           static_cast<uint64>(SlabStats.NumAllocations), static_cast<uint64>(SlabStats.NumSystemAllocations), static_cast<uint64>(SlabStats.NumRemoteFrees));
 }
\ No newline at end of file
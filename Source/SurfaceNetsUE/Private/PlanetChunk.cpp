@@ -1,7 +1,20 @@
 #include "PlanetChunk.h"
+#include "DensityCache.h"
+#include "Mesher.h"
 #include "NoiseGenerator.h"
 #include "SurfaceNets.h"
 #include "SurfaceNetsUE.h"
+#include "SurfaceNetsCoreBridge.h"
+#include "SurfaceNetsCore/DensityField.h"
+#include "HAL/IConsoleManager.h"
+
+#if !UE_BUILD_SHIPPING
+static TAutoConsoleVariable<bool> CVarValidateChunkMeshes(
+    TEXT("SurfaceNets.ValidateChunkMeshes"),
+    false,
+    TEXT("Validate every generated chunk mesh (index range, NaNs, degenerate triangles, edge topology)."),
+    ECVF_Default);
+#endif
 
 FPlanetChunk::FPlanetChunk()
     : Position(FVector::ZeroVector)
@@ -25,9 +38,19 @@ FPlanetChunk::FPlanetChunk(const FVector& InPosition, int32 InLODLevel, float In
 {
 }
 
-bool FPlanetChunk::GenerateMesh(const UNoiseGenerator* NoiseGenerator)
+bool FPlanetChunk::GenerateMesh(const UNoiseGenerator* NoiseGenerator, const FPlanetMeshingSettings& MeshingSettings, FDensityCache* DensityCache, bool bBuildRenderData)
 {
-    if (!NoiseGenerator || bIsGenerating)
+    if (!NoiseGenerator)
+    {
+        return false;
+    }
+
+    return GenerateMesh(NoiseGenerator->GetNoiseSettings(), MeshingSettings, DensityCache, bBuildRenderData);
+}
+
+bool FPlanetChunk::GenerateMesh(const SurfaceNetsCore::FNoiseSettings& NoiseSettings, const FPlanetMeshingSettings& MeshingSettings, FDensityCache* DensityCache, bool bBuildRenderData)
+{
+    if (bIsGenerating)
     {
         return false;
     }
@@ -35,13 +58,13 @@ bool FPlanetChunk::GenerateMesh(const UNoiseGenerator* NoiseGenerator)
     bIsGenerating = true;
     ClearMesh();
 
-    TArray<float> DensityField;
+    TChunkArray<float> DensityField;
     int32 PaddedSize;
     FVector PaddedOrigin;
     float VoxelSize;
 
     // Generate density field with padding (like Rust implementation)
-    if (!GeneratePaddedDensityField(NoiseGenerator, DensityField, PaddedSize, PaddedOrigin, VoxelSize))
+    if (!GeneratePaddedDensityField(NoiseSettings, DensityCache, DensityField, PaddedSize, PaddedOrigin, VoxelSize))
     {
         bIsGenerating = false;
         bIsEmpty = true;
@@ -59,10 +82,16 @@ bool FPlanetChunk::GenerateMesh(const UNoiseGenerator* NoiseGenerator)
         UE_LOG(LogSurfaceNets, Verbose, TEXT("Chunk at %s has no surface"), *Position.ToString());
         return false;
     }
+    bHasSurface = true;
 
-    // Generate mesh using Surface Nets with Rust-like bounds
-    FSurfaceNets SurfaceNets;
-    SurfaceNets.GenerateMesh(
+    if (bBuildRenderData)
+    {
+        RenderData = MakeUnique<FPlanetChunkRenderData>(Position, Size);
+    }
+
+    // Generate mesh with the configured algorithm and Rust-like bounds
+    const TUniquePtr<IMesher> Mesher = IMesher::Create(MeshingSettings);
+    Mesher->GenerateMesh(
         DensityField,
         PaddedSize,
         VoxelSize,
@@ -71,24 +100,24 @@ bool FPlanetChunk::GenerateMesh(const UNoiseGenerator* NoiseGenerator)
         Triangles,
         Normals,
         FIntVector(0, 0, 0),                    // Min bounds
-        FIntVector(UNPADDED_CHUNK_SIZE + 1)     // Max bounds (17,17,17) like Rust [0;3], [17;3]
+        FIntVector(UNPADDED_CHUNK_SIZE + 1),    // Max bounds (17,17,17) like Rust [0;3], [17;3]
+        RenderData.Get()
     );
 
-    // Generate UVs
-    UVs.SetNum(Vertices.Num());
-    for (int32 i = 0; i < Vertices.Num(); i++)
+#if !UE_BUILD_SHIPPING
+    if (CVarValidateChunkMeshes.GetValueOnAnyThread())
     {
-        // Simple planar UV mapping
-        FVector LocalPos = Vertices[i] - Position;
-        UVs[i] = FVector2D(
-            (LocalPos.X / Size) + 0.5f,
-            (LocalPos.Y / Size) + 0.5f
-        );
+        FSurfaceNets::ValidateMesh(Vertices, Triangles, Normals);
     }
+#endif
 
     bIsGenerating = false;
     bIsGenerated = true;
     bIsEmpty = (Vertices.Num() == 0);
+    if (bIsEmpty)
+    {
+        RenderData.Reset();
+    }
 
     UE_LOG(LogSurfaceNets, Verbose, TEXT("Generated chunk at %s with %d vertices, %d triangles"), 
            *Position.ToString(), Vertices.Num(), Triangles.Num() / 3);
@@ -101,9 +130,10 @@ void FPlanetChunk::ClearMesh()
     Vertices.Empty();
     Triangles.Empty();
     Normals.Empty();
-    UVs.Empty();
+    RenderData.Reset();
     bIsGenerated = false;
     bIsEmpty = false;
+    bHasSurface = false;
 }
 
 int32 FPlanetChunk::GetVoxelResolution() const
@@ -112,69 +142,82 @@ int32 FPlanetChunk::GetVoxelResolution() const
     return FMath::Max(8, UNPADDED_CHUNK_SIZE >> LODLevel);
 }
 
+FBox FPlanetChunk::GetBounds() const
+{
+    return FBox(Position - FVector(Size * 0.5f), Position + FVector(Size * 0.5f));
+}
+
+SurfaceNetsCore::FSurfaceNavSettings FPlanetChunk::MakeNavSettings(const FVector& PlanetCenter, float MaxSlopeDegrees) const
+{
+    const FBox Bounds = GetBounds();
+    const float VoxelSize = Size / UNPADDED_CHUNK_SIZE;
+
+    SurfaceNetsCore::FSurfaceNavSettings NavSettings;
+    NavSettings.PlanetCenter = SurfaceNetsBridge::ToCore(PlanetCenter);
+    NavSettings.MaxSlopeDegrees = MaxSlopeDegrees;
+    NavSettings.BoundsMin = SurfaceNetsBridge::ToCore(Bounds.Min);
+    NavSettings.BoundsMax = SurfaceNetsBridge::ToCore(Bounds.Max);
+    NavSettings.BoundaryMargin = VoxelSize;
+    NavSettings.PortalQuantization = VoxelSize * 0.01;
+    return NavSettings;
+}
+
+TSharedRef<SurfaceNetsCore::FSurfaceNavGraph> FPlanetChunk::BuildNavGraph(
+    TConstArrayView<FVector> InVertices,
+    TConstArrayView<int32> InTriangles,
+    TConstArrayView<FVector> InNormals,
+    const SurfaceNetsCore::FSurfaceNavSettings& NavSettings)
+{
+    TSharedRef<SurfaceNetsCore::FSurfaceNavGraph> NavGraph = MakeShared<SurfaceNetsCore::FSurfaceNavGraph>();
+
+    // Mesh normals are the negated density gradient; walkability needs the side facing out of the ground
+    NavGraph->Build(
+        FMath::Min(InVertices.Num(), InNormals.Num()),
+        InTriangles.GetData(),
+        InTriangles.Num(),
+        [&InVertices](int32 Index) { return SurfaceNetsBridge::ToCore(InVertices[Index]); },
+        [&InNormals](int32 Index) { return -SurfaceNetsBridge::ToCore(InNormals[Index]); },
+        NavSettings);
+
+    return NavGraph;
+}
+
 bool FPlanetChunk::GeneratePaddedDensityField(
-    const UNoiseGenerator* NoiseGenerator,
-    TArray<float>& OutDensityField,
+    const SurfaceNetsCore::FNoiseSettings& NoiseSettings,
+    FDensityCache* DensityCache,
+    TChunkArray<float>& OutDensityField,
     int32& OutPaddedSize,
     FVector& OutPaddedOrigin,
     float& OutVoxelSize)
 {
-    if (!NoiseGenerator)
-    {
-        return false;
-    }
-
-    // Use padded size (18x18x18) like Rust implementation
-    OutPaddedSize = PADDED_CHUNK_SIZE;
-    OutVoxelSize = Size / UNPADDED_CHUNK_SIZE;
-    
-    // Calculate padded origin (offset by -1 voxel for padding)
-    OutPaddedOrigin = Position - FVector(Size * 0.5f) - FVector(OutVoxelSize);
+    // Use padded size (18x18x18) like Rust implementation, origin offset by -1 voxel for padding
+    const SurfaceNetsCore::FChunkLayout Layout = SurfaceNetsCore::FChunkLayout::ForChunk(SurfaceNetsBridge::ToCore(Position), Size);
+    OutPaddedSize = Layout.GridSize;
+    OutVoxelSize = Layout.VoxelSize;
+    OutPaddedOrigin = SurfaceNetsBridge::ToUnreal(Layout.PaddedOrigin);
 
     // Allocate density field
-    OutDensityField.SetNum(OutPaddedSize * OutPaddedSize * OutPaddedSize);
+    OutDensityField.SetNumUninitialized(static_cast<int32>(Layout.NumSamples()));
 
-    // Generate density values with padding (matching Rust approach)
-    bool HasSurface = false;
-    bool HasPositive = false;
-    bool HasNegativeOrZero = false;
-
-    for (int32 z = 0; z < OutPaddedSize; z++)
+    const FDensityCacheKey CacheKey{ ChunkCoordinates, LODLevel };
+    if (DensityCache)
     {
-        for (int32 y = 0; y < OutPaddedSize; y++)
+        if (const TSharedPtr<const FCachedDensity> Cached = DensityCache->Find(CacheKey))
         {
-            for (int32 x = 0; x < OutPaddedSize; x++)
-            {
-                // Convert to world coordinates
-                FVector WorldPos = OutPaddedOrigin + FVector(
-                    x * OutVoxelSize,
-                    y * OutVoxelSize,
-                    z * OutVoxelSize
-                );
-
-                // Sample density
-                float Density = NoiseGenerator->SampleDensity(WorldPos);
-
-                int32 Index = x + y * OutPaddedSize + z * OutPaddedSize * OutPaddedSize;
-                OutDensityField[Index] = Density;
-
-                // Track if surface exists (like Rust early detection)
-                if (Density > 0.0f)
-                {
-                    HasPositive = true;
-                }
-                else
-                {
-                    HasNegativeOrZero = true;
-                }
-
-                if (HasPositive && HasNegativeOrZero)
-                {
-                    HasSurface = true;
-                }
-            }
+            Cached->Density.Decode(OutDensityField.GetData(), Layout.NumSamples());
+            return SurfaceNetsCore::HasSurface(OutDensityField.GetData(), Layout.NumSamples());
         }
     }
 
-    return HasSurface;
-}
\ No newline at end of file
+    // Generate density values with padding, tracking if surface exists (like Rust early detection)
+    const SurfaceNetsCore::FNoiseSampler Noise(NoiseSettings);
+    const bool bHasSurface = SurfaceNetsCore::FillNoiseDensityGrid(Layout, Noise, OutDensityField.GetData());
+
+    // Mesh the quantized samples a later cache hit would return; quantization keeps every sample's sign
+    if (DensityCache)
+    {
+        DensityCache->Add(CacheKey, Layout, OutDensityField.GetData())->Density.Decode(OutDensityField.GetData(), Layout.NumSamples());
+    }
+
+    return bHasSurface;
+}
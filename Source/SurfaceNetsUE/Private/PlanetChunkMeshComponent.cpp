@@ -0,0 +1,213 @@
+#include "PlanetChunkMeshComponent.h"
+#include "PlanetChunkRenderData.h"
+#include "SurfaceNetsUE.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialRelevance.h"
+#include "Materials/MaterialRenderProxy.h"
+#include "MaterialDomain.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "PrimitiveSceneProxy.h"
+#include "PrimitiveViewRelevance.h"
+#include "RenderingThread.h"
+#include "SceneInterface.h"
+
+DECLARE_MEMORY_STAT(TEXT("Chunk Render Data"), STAT_ChunkRenderData, STATGROUP_SurfaceNets);
+
+/** Static draw of a chunk's render data; the buffers never change after upload */
+class FPlanetChunkSceneProxy final : public FPrimitiveSceneProxy
+{
+public:
+    FPlanetChunkSceneProxy(UPlanetChunkMeshComponent* Component)
+        : FPrimitiveSceneProxy(Component)
+        , RenderData(Component->RenderData)
+        , MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetShaderPlatform()))
+    {
+        Material = Component->GetMaterial(0);
+        if (!Material)
+        {
+            Material = UMaterial::GetDefaultMaterial(MD_Surface);
+        }
+    }
+
+    virtual SIZE_T GetTypeHash() const override
+    {
+        static size_t UniquePointer;
+        return reinterpret_cast<size_t>(&UniquePointer);
+    }
+
+    virtual void DrawStaticElements(FStaticPrimitiveDrawInterface* PDI) override
+    {
+        FMeshBatch Mesh;
+        Mesh.VertexFactory = RenderData->GetVertexFactory();
+        Mesh.MaterialRenderProxy = Material->GetRenderProxy();
+        Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
+        Mesh.Type = PT_TriangleList;
+        Mesh.DepthPriorityGroup = SDPG_World;
+        Mesh.LODIndex = 0;
+        Mesh.CastShadow = true;
+
+        FMeshBatchElement& Element = Mesh.Elements[0];
+        Element.IndexBuffer = &RenderData->GetIndexBuffer();
+        Element.FirstIndex = 0;
+        Element.NumPrimitives = RenderData->GetNumTriangles();
+        Element.MinVertexIndex = 0;
+        Element.MaxVertexIndex = RenderData->GetNumVertices() - 1;
+
+        PDI->DrawMesh(Mesh, FLT_MAX);
+    }
+
+    virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const override
+    {
+        FPrimitiveViewRelevance Result;
+        Result.bDrawRelevance = IsShown(View);
+        Result.bShadowRelevance = IsShadowCast(View);
+        Result.bStaticRelevance = true;
+        Result.bRenderInMainPass = ShouldRenderInMainPass();
+        Result.bUsesLightingChannels = GetLightingChannelMask() != GetDefaultLightingChannelMask();
+        Result.bRenderCustomDepth = ShouldRenderCustomDepth();
+        Result.bTranslucentSelfShadow = bCastVolumetricTranslucentShadow;
+        MaterialRelevance.SetPrimitiveViewRelevance(Result);
+        Result.bVelocityRelevance = DrawsVelocity() && Result.bOpaque && Result.bRenderInMainPass;
+        return Result;
+    }
+
+    virtual bool CanBeOccluded() const override
+    {
+        return !MaterialRelevance.bDisableDepthTest;
+    }
+
+    virtual uint32 GetMemoryFootprint() const override
+    {
+        return sizeof(*this) + GetAllocatedSize();
+    }
+
+private:
+    TSharedPtr<FPlanetChunkRenderData, ESPMode::ThreadSafe> RenderData;
+    UMaterialInterface* Material = nullptr;
+    FMaterialRelevance MaterialRelevance;
+};
+
+UPlanetChunkMeshComponent::UPlanetChunkMeshComponent(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+    , LocalBounds(FVector::ZeroVector, FVector::ZeroVector, 0.0)
+{
+    PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UPlanetChunkMeshComponent::SetRenderData(TUniquePtr<FPlanetChunkRenderData>&& InRenderData)
+{
+    RenderData.Reset();
+    LocalBounds = FBoxSphereBounds(FVector::ZeroVector, FVector::ZeroVector, 0.0);
+
+    if (InRenderData.IsValid())
+    {
+        LocalBounds = InRenderData->GetLocalBounds();
+        INC_MEMORY_STAT_BY(STAT_ChunkRenderData, InRenderData->GetAllocatedSize());
+
+        // Resources are released where they live, whichever owner (component or proxy) lets go last
+        RenderData = TSharedPtr<FPlanetChunkRenderData, ESPMode::ThreadSafe>(InRenderData.Release(), [](FPlanetChunkRenderData* Data)
+        {
+            DEC_MEMORY_STAT_BY(STAT_ChunkRenderData, Data->GetAllocatedSize());
+            ENQUEUE_RENDER_COMMAND(ReleasePlanetChunkRenderData)([Data](FRHICommandListImmediate&)
+            {
+                Data->ReleaseResources();
+                delete Data;
+            });
+        });
+
+        const ERHIFeatureLevel::Type FeatureLevel = GetWorld() ? GetWorld()->GetFeatureLevel() : GMaxRHIFeatureLevel;
+        ENQUEUE_RENDER_COMMAND(InitPlanetChunkRenderData)([Data = RenderData, FeatureLevel](FRHICommandListImmediate& RHICmdList)
+        {
+            Data->InitResources(RHICmdList, FeatureLevel);
+        });
+    }
+
+    UpdateBounds();
+    MarkRenderStateDirty();
+}
+
+void UPlanetChunkMeshComponent::SetCollisionMesh(TConstArrayView<FVector> Vertices, TConstArrayView<int32> Triangles)
+{
+    CollisionVertices.SetNumUninitialized(Vertices.Num());
+    for (int32 Index = 0; Index < Vertices.Num(); Index++)
+    {
+        CollisionVertices[Index] = FVector3f(Vertices[Index]);
+    }
+
+    CollisionTriangles.SetNumUninitialized(Triangles.Num() / 3);
+    for (int32 Index = 0; Index < CollisionTriangles.Num(); Index++)
+    {
+        CollisionTriangles[Index].v0 = Triangles[Index * 3 + 0];
+        CollisionTriangles[Index].v1 = Triangles[Index * 3 + 1];
+        CollisionTriangles[Index].v2 = Triangles[Index * 3 + 2];
+    }
+
+    if (!BodySetup)
+    {
+        BodySetup = NewObject<UBodySetup>(this, NAME_None, RF_Transient);
+        BodySetup->BodySetupGuid = FGuid::NewGuid();
+        BodySetup->bGenerateMirroredCollision = false;
+        BodySetup->bDoubleSidedGeometry = true;
+        BodySetup->CollisionTraceFlag = CTF_UseComplexAsSimple;
+    }
+
+    // Cooks synchronously, reading the arrays above through GetPhysicsTriMeshData
+    BodySetup->InvalidatePhysicsData();
+    BodySetup->CreatePhysicsMeshes();
+    RecreatePhysicsState();
+
+    CollisionVertices.Empty();
+    CollisionTriangles.Empty();
+}
+
+void UPlanetChunkMeshComponent::ClearCollisionMesh()
+{
+    if (!BodySetup)
+    {
+        return;
+    }
+
+    BodySetup->InvalidatePhysicsData();
+    BodySetup = nullptr;
+    RecreatePhysicsState();
+}
+
+FPrimitiveSceneProxy* UPlanetChunkMeshComponent::CreateSceneProxy()
+{
+    if (!RenderData.IsValid() || RenderData->GetNumTriangles() == 0)
+    {
+        return nullptr;
+    }
+    return new FPlanetChunkSceneProxy(this);
+}
+
+UBodySetup* UPlanetChunkMeshComponent::GetBodySetup()
+{
+    return BodySetup;
+}
+
+int32 UPlanetChunkMeshComponent::GetNumMaterials() const
+{
+    return 1;
+}
+
+bool UPlanetChunkMeshComponent::GetPhysicsTriMeshData(FTriMeshCollisionData* CollisionData, bool InUseAllTriData)
+{
+    CollisionData->Vertices = CollisionVertices;
+    CollisionData->Indices = CollisionTriangles;
+    CollisionData->MaterialIndices.Init(0, CollisionTriangles.Num());
+    CollisionData->bFlipNormals = true;
+    CollisionData->bDeformableMesh = false;
+    CollisionData->bFastCook = true;
+    return CollisionTriangles.Num() > 0;
+}
+
+bool UPlanetChunkMeshComponent::ContainsPhysicsTriMeshData(bool InUseAllTriData) const
+{
+    return CollisionTriangles.Num() > 0;
+}
+
+FBoxSphereBounds UPlanetChunkMeshComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+    return LocalBounds.TransformBy(LocalToWorld);
+}
@@ -0,0 +1,78 @@
+#include "PlanetChunkRenderData.h"
+
+FPlanetChunkRenderData::FPlanetChunkRenderData(const FVector& InUVOrigin, float InUVSize)
+    : UVOrigin(InUVOrigin)
+    , UVSize(InUVSize)
+{
+    // Planar UVs span more than half precision covers across a chunk; tangents keep the default 8-bit basis
+    VertexBuffers.StaticMeshVertexBuffer.SetUseFullPrecisionUVs(true);
+}
+
+FPlanetChunkRenderData::~FPlanetChunkRenderData()
+{
+    check(!VertexFactory.IsSet());
+}
+
+void FPlanetChunkRenderData::Allocate(int32 InNumVertices, int32 InNumTriangles)
+{
+    NumVertices = InNumVertices;
+    NumTriangles = InNumTriangles;
+    LocalBox = FBox3f(ForceInit);
+
+    // No CPU access: the resource arrays are discarded once the RHI buffers are created
+    VertexBuffers.PositionVertexBuffer.Init(NumVertices, false);
+    VertexBuffers.StaticMeshVertexBuffer.Init(NumVertices, 1, false);
+    IndexBuffer.Indices.SetNumUninitialized(NumTriangles * 3);
+}
+
+void FPlanetChunkRenderData::InitResources(FRHICommandListBase& RHICmdList, ERHIFeatureLevel::Type FeatureLevel)
+{
+    check(IsInRenderingThread());
+    check(!VertexFactory.IsSet());
+
+    VertexBuffers.PositionVertexBuffer.InitResource(RHICmdList);
+    VertexBuffers.StaticMeshVertexBuffer.InitResource(RHICmdList);
+    VertexBuffers.ColorVertexBuffer.InitResource(RHICmdList);
+    IndexBuffer.InitResource(RHICmdList);
+    IndexBuffer.Indices.Empty();
+
+    FLocalVertexFactory& Factory = VertexFactory.Emplace(FeatureLevel, "FPlanetChunkRenderData");
+    FLocalVertexFactory::FDataType Data;
+    VertexBuffers.PositionVertexBuffer.BindPositionVertexBuffer(&Factory, Data);
+    VertexBuffers.StaticMeshVertexBuffer.BindTangentVertexBuffer(&Factory, Data);
+    VertexBuffers.StaticMeshVertexBuffer.BindPackedTexCoordVertexBuffer(&Factory, Data);
+    VertexBuffers.StaticMeshVertexBuffer.BindLightMapVertexBuffer(&Factory, Data, 0);
+
+    // No vertex colors; an empty buffer binds the global white one
+    VertexBuffers.ColorVertexBuffer.BindColorVertexBuffer(&Factory, Data);
+    Factory.SetData(RHICmdList, Data);
+    Factory.InitResource(RHICmdList);
+}
+
+void FPlanetChunkRenderData::ReleaseResources()
+{
+    check(IsInRenderingThread());
+    if (!VertexFactory.IsSet())
+    {
+        return;
+    }
+
+    VertexFactory->ReleaseResource();
+    VertexFactory.Reset();
+    IndexBuffer.ReleaseResource();
+    VertexBuffers.ColorVertexBuffer.ReleaseResource();
+    VertexBuffers.StaticMeshVertexBuffer.ReleaseResource();
+    VertexBuffers.PositionVertexBuffer.ReleaseResource();
+}
+
+FBoxSphereBounds FPlanetChunkRenderData::GetLocalBounds() const
+{
+    return LocalBox.IsValid ? FBoxSphereBounds(FBox(LocalBox)) : FBoxSphereBounds(FVector::ZeroVector, FVector::ZeroVector, 0.0);
+}
+
+SIZE_T FPlanetChunkRenderData::GetAllocatedSize() const
+{
+    return static_cast<SIZE_T>(NumVertices) * VertexBuffers.PositionVertexBuffer.GetStride()
+        + VertexBuffers.StaticMeshVertexBuffer.GetResourceSize()
+        + static_cast<SIZE_T>(NumTriangles) * 3 * sizeof(uint32);
+}
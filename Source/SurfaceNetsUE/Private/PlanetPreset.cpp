@@ -0,0 +1,101 @@
+#include "PlanetPreset.h"
+#include "NoiseGenerator.h"
+#include "SurfaceNetsUE.h"
+#include "SurfaceNetsCoreBridge.h"
+#include "Misc/Crc.h"
+
+FOnPlanetPresetChanged UPlanetPreset::OnPresetChanged;
+
+void UPlanetPreset::ApplyTo(UNoiseGenerator* NoiseGenerator) const
+{
+    NoiseGenerator->PlanetRadius = PlanetRadius;
+    NoiseGenerator->NoiseScale = NoiseScale;
+    NoiseGenerator->NoiseAmplitude = NoiseAmplitude;
+    NoiseGenerator->Octaves = Octaves;
+    NoiseGenerator->Lacunarity = Lacunarity;
+    NoiseGenerator->Persistence = Persistence;
+    NoiseGenerator->Seed = Seed;
+    NoiseGenerator->bDecorrelateOctaves = bDecorrelateOctaves;
+    NoiseGenerator->NoiseType = NoiseType;
+    NoiseGenerator->WarpStrength = WarpStrength;
+    NoiseGenerator->WarpScale = WarpScale;
+    NoiseGenerator->SamplingMode = SamplingMode;
+}
+
+SurfaceNetsCore::FNoiseSettings UPlanetPreset::MakeNoiseSettings(const FVector& PlanetCenter) const
+{
+    SurfaceNetsCore::FNoiseSettings Settings;
+    Settings.PlanetRadius = PlanetRadius;
+    Settings.PlanetCenter = SurfaceNetsBridge::ToCore(PlanetCenter);
+    Settings.NoiseScale = NoiseScale;
+    Settings.NoiseAmplitude = NoiseAmplitude;
+    Settings.Octaves = Octaves;
+    Settings.Lacunarity = Lacunarity;
+    Settings.Persistence = Persistence;
+    Settings.Seed = Seed;
+    Settings.bDecorrelateOctaves = bDecorrelateOctaves;
+    Settings.FractalType = UNoiseGenerator::ToCore(NoiseType);
+    Settings.WarpStrength = WarpStrength;
+    Settings.WarpScale = WarpScale;
+    Settings.bHeightfield = UNoiseGenerator::UsesHeightfield(SamplingMode, Settings);
+    return Settings;
+}
+
+void UPlanetPreset::RebuildAcceleration()
+{
+    const SurfaceNetsCore::FNoiseSettings Settings = MakeNoiseSettings(FVector::ZeroVector);
+    NoiseBounds = SurfaceNetsCore::FNoiseBounds::Build(Settings);
+    OctaveFrequencies = TArray<float>(NoiseBounds.OctaveFrequencies.data(), static_cast<int32>(NoiseBounds.OctaveFrequencies.size()));
+    OctaveAmplitudes = TArray<float>(NoiseBounds.OctaveAmplitudes.data(), static_cast<int32>(NoiseBounds.OctaveAmplitudes.size()));
+    OctaveTailHeights = TArray<float>(NoiseBounds.TailHeights.data(), static_cast<int32>(NoiseBounds.TailHeights.size()));
+    MaxHeight = NoiseBounds.MaxHeight;
+    LipschitzBound = NoiseBounds.LipschitzBound;
+
+    AccelerationKey = ComputeSettingsKey();
+}
+
+void UPlanetPreset::PostLoad()
+{
+    Super::PostLoad();
+
+    // Saved data from other settings (an older asset, or edited outside the editor) is rebuilt rather than trusted
+    if (AccelerationKey != ComputeSettingsKey()
+        || OctaveFrequencies.Num() != Octaves || OctaveAmplitudes.Num() != Octaves || OctaveTailHeights.Num() != Octaves + 1)
+    {
+        UE_LOG(LogSurfaceNets, Log, TEXT("Rebuilding stale acceleration data of planet preset %s"), *GetName());
+        RebuildAcceleration();
+        return;
+    }
+    RestoreAcceleration();
+}
+
+#if WITH_EDITOR
+void UPlanetPreset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    // Only the final value of a slider drag regenerates the planets using the preset
+    RebuildAcceleration();
+    if (PropertyChangedEvent.ChangeType != EPropertyChangeType::Interactive)
+    {
+        OnPresetChanged.Broadcast(this);
+    }
+}
+#endif
+
+uint32 UPlanetPreset::ComputeSettingsKey() const
+{
+    const FString Description = FString::Printf(TEXT("r%.9g s%.9g a%.9g o%d l%.9g p%.9g seed%d type%d warp%.9g,%.9g mode%d"),
+        PlanetRadius, NoiseScale, NoiseAmplitude, Octaves, Lacunarity, Persistence, Seed, static_cast<int32>(NoiseType),
+        WarpStrength, WarpScale, static_cast<int32>(SamplingMode));
+    return FCrc::StrCrc32(*Description);
+}
+
+void UPlanetPreset::RestoreAcceleration()
+{
+    NoiseBounds.OctaveFrequencies.assign(OctaveFrequencies.GetData(), OctaveFrequencies.GetData() + OctaveFrequencies.Num());
+    NoiseBounds.OctaveAmplitudes.assign(OctaveAmplitudes.GetData(), OctaveAmplitudes.GetData() + OctaveAmplitudes.Num());
+    NoiseBounds.TailHeights.assign(OctaveTailHeights.GetData(), OctaveTailHeights.GetData() + OctaveTailHeights.Num());
+    NoiseBounds.MaxHeight = MaxHeight;
+    NoiseBounds.LipschitzBound = LipschitzBound;
+}
@@ -0,0 +1,140 @@
+#include "PlanetSurfaceQuery.h"
+#include "SurfaceNetsCoreBridge.h"
+#include "Async/ParallelFor.h"
+
+#include <atomic>
+
+using SurfaceNetsCore::FSdfQueries;
+using SurfaceNetsCore::FVec3;
+
+FPlanetSurfaceQuery::FPlanetSurfaceQuery(const SurfaceNetsCore::FNoiseSettings& InNoiseSettings, TSharedPtr<FDensityCache> InDensityCache)
+    : NoiseSettings(InNoiseSettings)
+    , Noise(InNoiseSettings)
+    , DensityCache(MoveTemp(InDensityCache))
+{
+    QuerySettings.LipschitzBound = SurfaceNetsCore::FFractalNoise::LipschitzBound(NoiseSettings);
+    MaxHeight = SurfaceNetsCore::FFractalNoise::MaxHeight(NoiseSettings);
+
+    // Trilinear interpolation of the cached samples can be up to sqrt(3) steeper than the noise itself
+    if (DensityCache.IsValid())
+    {
+        QuerySettings.LipschitzBound *= UE_SQRT_3;
+    }
+}
+
+float FPlanetSurfaceQuery::FDensitySampler::operator()(const FVec3& Position)
+{
+    if (Query.DensityCache.IsValid())
+    {
+        const FVector UnrealPosition = SurfaceNetsBridge::ToUnreal(Position);
+        if (!ChunkBounds.IsValid || !ChunkBounds.IsInsideOrOn(UnrealPosition))
+        {
+            Chunk = Query.DensityCache->FindAt(UnrealPosition, ChunkBounds);
+        }
+
+        if (Chunk.IsValid())
+        {
+            return Chunk->Density.Sample(Chunk->Layout, Position);
+        }
+    }
+
+    return Query.Noise(Position);
+}
+
+bool FPlanetSurfaceQuery::Raycast(const FVector& Start, const FVector& End, FVector& OutHitLocation, FVector& OutHitNormal) const
+{
+    FVec3 Direction = SurfaceNetsBridge::ToCore(End - Start);
+    const double Length = Direction.Size();
+    if (!Direction.Normalize())
+    {
+        return false;
+    }
+
+    FDensitySampler Density{ *this };
+    const SurfaceNetsCore::FSdfHit Hit = FSdfQueries::SphereTrace(Density, SurfaceNetsBridge::ToCore(Start), Direction, Length, QuerySettings);
+    if (!Hit.bHit)
+    {
+        return false;
+    }
+
+    OutHitLocation = SurfaceNetsBridge::ToUnreal(Hit.Position);
+    OutHitNormal = CalculateNormal(OutHitLocation);
+    return true;
+}
+
+bool FPlanetSurfaceQuery::FindClosestSurfacePoint(const FVector& Point, FVector& OutSurfacePoint) const
+{
+    FDensitySampler Density{ *this };
+
+    FVec3 SurfacePoint;
+    if (FSdfQueries::ProjectToSurface(Density, SurfaceNetsBridge::ToCore(Point), QuerySettings, SurfacePoint))
+    {
+        OutSurfacePoint = SurfaceNetsBridge::ToUnreal(SurfacePoint);
+        return true;
+    }
+
+    // Newton stalled in a dip of the noise; the radial surface always exists inside the terrain shell
+    float Height = 0.0f;
+    if (!GetSurfaceHeight(Point, Height))
+    {
+        return false;
+    }
+
+    const FVector Center = SurfaceNetsBridge::ToUnreal(NoiseSettings.PlanetCenter);
+    OutSurfacePoint = Center + (Point - Center).GetSafeNormal() * (NoiseSettings.PlanetRadius + Height);
+    return true;
+}
+
+bool FPlanetSurfaceQuery::GetSurfaceHeight(const FVector& Location, float& OutHeight) const
+{
+    FVec3 Direction = SurfaceNetsBridge::ToCore(Location) - NoiseSettings.PlanetCenter;
+    if (!Direction.Normalize())
+    {
+        return false;
+    }
+
+    // A heightfield's surface is its height on the base sphere, unless cached grids carry edits
+    if (NoiseSettings.bHeightfield && !DensityCache.IsValid())
+    {
+        OutHeight = Noise.SampleHeight(NoiseSettings.PlanetCenter + Direction * NoiseSettings.PlanetRadius);
+        return true;
+    }
+
+    // Widened by the hit tolerance so surfaces right at the bound are still found
+    const double MinRadius = FMath::Max(0.0, static_cast<double>(NoiseSettings.PlanetRadius - MaxHeight) - 1.0);
+    const double MaxRadius = static_cast<double>(NoiseSettings.PlanetRadius + MaxHeight) + 1.0;
+
+    FDensitySampler Density{ *this };
+    double Radius = 0.0;
+    if (!FSdfQueries::FindSurfaceRadius(Density, NoiseSettings.PlanetCenter, Direction, MinRadius, MaxRadius, QuerySettings, Radius))
+    {
+        return false;
+    }
+
+    OutHeight = static_cast<float>(Radius - NoiseSettings.PlanetRadius);
+    return true;
+}
+
+bool FPlanetSurfaceQuery::GetSurfaceHeights(TArrayView<const FVector> Locations, TArrayView<float> OutHeights) const
+{
+    check(Locations.Num() == OutHeights.Num());
+
+    std::atomic<bool> bAllFound(true);
+    ParallelFor(Locations.Num(), [this, Locations, OutHeights, &bAllFound](int32 Index)
+    {
+        float& Height = OutHeights[Index];
+        if (!GetSurfaceHeight(Locations[Index], Height))
+        {
+            Height = 0.0f;
+            bAllFound = false;
+        }
+    });
+    return bAllFound;
+}
+
+FVector FPlanetSurfaceQuery::CalculateNormal(const FVector& Point) const
+{
+    FDensitySampler Density{ *this };
+    FVec3 Normal = FSdfQueries::CalculateGradient(Density, SurfaceNetsBridge::ToCore(Point), QuerySettings.GradientStep);
+    return Normal.Normalize() ? SurfaceNetsBridge::ToUnreal(Normal) : FVector::ZeroVector;
+}
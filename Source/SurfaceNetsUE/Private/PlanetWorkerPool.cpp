@@ -0,0 +1,199 @@
+#include "PlanetWorkerPool.h"
+#include "SurfaceNetsUE.h"
+#include "SurfaceNetsCore/SlabAllocator.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformAffinity.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Parse.h"
+
+FPlanetWorkerSettings FPlanetWorkerSettings::FromCommandLine(const TCHAR* Cmd)
+{
+    FPlanetWorkerSettings Settings;
+
+    FString GroupList;
+    if (FParse::Value(Cmd, TEXT("WorkerGroups="), GroupList, false))
+    {
+        TArray<FString> GroupSpecs;
+        GroupList.ParseIntoArray(GroupSpecs, TEXT(","));
+        for (const FString& GroupSpec : GroupSpecs)
+        {
+            FString Count;
+            FString Mask;
+            FPlanetWorkerGroup Group;
+            if (GroupSpec.Split(TEXT(":"), &Count, &Mask))
+            {
+                Group.NumWorkers = FCString::Atoi(*Count);
+                Group.AffinityMask = static_cast<int64>(FCString::Strtoui64(*Mask, nullptr, 0));
+            }
+            else
+            {
+                Group.NumWorkers = FCString::Atoi(*GroupSpec);
+            }
+
+            if (Group.NumWorkers > 0)
+            {
+                Settings.Groups.Add(Group);
+            }
+            else
+            {
+                UE_LOG(LogSurfaceNets, Warning, TEXT("Ignoring worker group '%s', expected Count[:AffinityMask]"), *GroupSpec);
+            }
+        }
+        return Settings;
+    }
+
+    int32 NumWorkers = 0;
+    if (FParse::Value(Cmd, TEXT("Workers="), NumWorkers) && NumWorkers > 0)
+    {
+        FPlanetWorkerGroup& Group = Settings.Groups.AddDefaulted_GetRef();
+        Group.NumWorkers = NumWorkers;
+    }
+    return Settings;
+}
+
+class FPlanetWorkerPool::FWorker final : public FRunnable
+{
+public:
+    FWorker(FPlanetWorkerPool& InPool, int32 InNode)
+        : Pool(InPool)
+        , Node(InNode)
+        , WakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+    {
+    }
+
+    virtual ~FWorker() override
+    {
+        delete Thread;
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+    }
+
+    void Start(const TCHAR* Name, uint64 AffinityMask)
+    {
+        Thread = FRunnableThread::Create(this, Name, 0, TPri_BelowNormal, AffinityMask != 0 ? AffinityMask : FPlatformAffinity::GetNoAffinityMask());
+    }
+
+    void Join()
+    {
+        if (Thread)
+        {
+            Thread->WaitForCompletion();
+        }
+    }
+
+    virtual uint32 Run() override
+    {
+        // The thread is pinned by now, so the slabs this cache carves get first touched on the group's node
+        SurfaceNetsCore::FSlabAllocator::Get().BindCurrentThreadToNode(Node);
+
+        TUniqueFunction<void()> Task;
+        while (Pool.WaitForTask(*this, Task))
+        {
+            Task();
+            Task.Reset();
+        }
+        return 0;
+    }
+
+    FPlanetWorkerPool& Pool;
+    const int32 Node;
+    FEvent* WakeEvent;
+    FRunnableThread* Thread = nullptr;
+};
+
+FPlanetWorkerPool::FPlanetWorkerPool(const FPlanetWorkerSettings& InSettings)
+    : Settings(InSettings)
+{
+    for (int32 GroupIndex = 0; GroupIndex < Settings.Groups.Num(); GroupIndex++)
+    {
+        const FPlanetWorkerGroup& Group = Settings.Groups[GroupIndex];
+        for (int32 Index = 0; Index < Group.NumWorkers; Index++)
+        {
+            Workers.Add(MakeUnique<FWorker>(*this, GroupIndex));
+        }
+    }
+
+    // Created only once every worker exists, Launch never sees a partial array
+    int32 WorkerIndex = 0;
+    for (int32 GroupIndex = 0; GroupIndex < Settings.Groups.Num(); GroupIndex++)
+    {
+        const FPlanetWorkerGroup& Group = Settings.Groups[GroupIndex];
+        for (int32 Index = 0; Index < Group.NumWorkers; Index++)
+        {
+            const FString Name = FString::Printf(TEXT("PlanetWorker %d.%d"), GroupIndex, Index);
+            Workers[WorkerIndex++]->Start(*Name, static_cast<uint64>(Group.AffinityMask));
+        }
+    }
+
+    UE_LOG(LogSurfaceNets, Log, TEXT("Started %d planet generation workers in %d groups"), Workers.Num(), Settings.Groups.Num());
+}
+
+FPlanetWorkerPool::~FPlanetWorkerPool()
+{
+    {
+        FScopeLock Lock(&QueueLock);
+        bStopping = true;
+    }
+    for (const TUniquePtr<FWorker>& Worker : Workers)
+    {
+        Worker->WakeEvent->Trigger();
+    }
+    for (const TUniquePtr<FWorker>& Worker : Workers)
+    {
+        Worker->Join();
+    }
+}
+
+void FPlanetWorkerPool::Launch(TUniqueFunction<void()>&& Task)
+{
+    FWorker* WorkerToWake = nullptr;
+    {
+        FScopeLock Lock(&QueueLock);
+        Tasks.Add(MoveTemp(Task));
+        if (IdleWorkers.Num() > 0)
+        {
+            WorkerToWake = IdleWorkers.Pop(EAllowShrinking::No);
+        }
+    }
+
+    if (WorkerToWake)
+    {
+        WorkerToWake->WakeEvent->Trigger();
+    }
+}
+
+bool FPlanetWorkerPool::WaitForTask(FWorker& Worker, TUniqueFunction<void()>& OutTask)
+{
+    for (;;)
+    {
+        {
+            FScopeLock Lock(&QueueLock);
+            if (bStopping)
+            {
+                return false;
+            }
+
+            if (FirstTask < Tasks.Num())
+            {
+                OutTask = MoveTemp(Tasks[FirstTask++]);
+                if (FirstTask == Tasks.Num())
+                {
+                    Tasks.Reset();
+                    FirstTask = 0;
+                }
+                else if (FirstTask > 64 && FirstTask * 2 > Tasks.Num())
+                {
+                    Tasks.RemoveAt(0, FirstTask, EAllowShrinking::No);
+                    FirstTask = 0;
+                }
+                return true;
+            }
+
+            // A Launch between here and the wait triggers the event first, so the wait returns at once
+            IdleWorkers.Add(&Worker);
+        }
+        Worker.WakeEvent->Wait();
+    }
+}
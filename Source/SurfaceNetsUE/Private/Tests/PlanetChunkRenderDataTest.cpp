@@ -0,0 +1,73 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "PlanetChunk.h"
+#include "PlanetChunkMeshComponent.h"
+#include "PlanetChunkRenderData.h"
+#include "RenderingThread.h"
+#include "UObject/Package.h"
+
+/**
+ * The render data of a chunk must go from the mesher to the GPU without a copy: it is written in place while the
+ * chunk is meshed, moves (as the same object) into the component, and its CPU buffers are freed by the upload.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FPlanetChunkRenderDataHandoffTest,
+    "SurfaceNets.RenderData.HandoffWithoutCopies",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPlanetChunkRenderDataHandoffTest::RunTest(const FString& Parameters)
+{
+    // A chunk straddling the default planet's surface, which the noise displaces by at most NoiseAmplitude
+    const SurfaceNetsCore::FNoiseSettings NoiseSettings;
+    FPlanetChunk Chunk(FVector(NoiseSettings.PlanetRadius, 0.0, 0.0), 0, NoiseSettings.NoiseAmplitude * 4.0f);
+
+    if (!TestTrue(TEXT("Chunk has a mesh"), Chunk.GenerateMesh(NoiseSettings, FPlanetMeshingSettings(), nullptr, true)))
+    {
+        return false;
+    }
+    if (!TestTrue(TEXT("Mesher built render data"), Chunk.RenderData.IsValid()))
+    {
+        return false;
+    }
+
+    // Written in the same pass as the game-side arrays, at their exact counts
+    FPlanetChunkRenderData* const RenderData = Chunk.RenderData.Get();
+    TestEqual(TEXT("Render vertex count"), RenderData->GetNumVertices(), Chunk.Vertices.Num());
+    TestEqual(TEXT("Render triangle count"), RenderData->GetNumTriangles() * 3, Chunk.Triangles.Num());
+
+    const uint32* const Indices = RenderData->GetIndexData();
+    int32 NumMismatchedIndices = 0;
+    for (int32 Index = 0; Index < Chunk.Triangles.Num(); ++Index)
+    {
+        NumMismatchedIndices += Indices[Index] != static_cast<uint32>(Chunk.Triangles[Index]) ? 1 : 0;
+    }
+    TestEqual(TEXT("Render indices match the chunk's triangles"), NumMismatchedIndices, 0);
+
+    FBox VertexBox(ForceInit);
+    for (const FVector& Vertex : Chunk.Vertices)
+    {
+        VertexBox += Vertex;
+    }
+    TestTrue(TEXT("Render bounds match the chunk's vertices"), RenderData->GetLocalBounds().GetBox().Equals(VertexBox, 1.0e-3));
+
+    // The component takes the object itself; only the owning pointer moves
+    UPlanetChunkMeshComponent* Component = NewObject<UPlanetChunkMeshComponent>(GetTransientPackage());
+    Component->SetRenderData(MoveTemp(Chunk.RenderData));
+    TestFalse(TEXT("Chunk gave up its render data"), Chunk.RenderData.IsValid());
+    TestTrue(TEXT("Component holds the mesher's render data"), Component->GetRenderData() == RenderData);
+
+    // The upload reads the buffers the mesher wrote and frees them; no CPU copy outlives it
+    FlushRenderingCommands();
+    TestNull(TEXT("CPU indices freed after upload"), RenderData->GetIndexData());
+    TestNotNull(TEXT("Vertex factory created"), RenderData->GetVertexFactory());
+    TestTrue(TEXT("Index buffer created"), RenderData->GetIndexBuffer().IsInitialized());
+
+    Component->SetRenderData(TUniquePtr<FPlanetChunkRenderData>());
+    FlushRenderingCommands();
+    Component->MarkAsGarbage();
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
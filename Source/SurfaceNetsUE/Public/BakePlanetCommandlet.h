@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BakePlanetCommandlet.generated.h"
+
+/**
+ * Bakes a whole planet's chunk meshes headless, split into region files (SurfaceNetsCore::FBakedRegion) of
+ * RegionSize^3 chunks so several processes or machines can share the work:
+ *
+ *   UnrealEditor-Cmd SurfaceNetsUE.uproject -run=BakePlanet -nullrhi -Output=Saved/PlanetBake -Shard=0 -ShardCount=4
+ *       [-RegionSize=8] [-PlanetRadius=1000] [-ChunkSize=128] [-ChunksPerAxis=16] [-Seed=1337] [-NoiseScale=]
+ *       [-NoiseAmplitude=] [-Octaves=] [-Workers=N | -WorkerGroups=16:0xFFFF,16:0xFFFF0000]
+ *
+ * Shard i bakes the regions whose grid index is i modulo ShardCount, each file only depending on the parameters,
+ * so reruns and other shard counts write identical regions. Once every shard is done, the same command with -Merge
+ * (and optionally -MergedOutput=) checks that all regions exist and belong to this bake and concatenates them
+ * behind a SurfaceNetsCore::FBakedPlanetIndex into one Planet.bake.
+ */
+UCLASS()
+class SURFACENETSUE_API UBakePlanetCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UBakePlanetCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BuildPlanetClustersCommandlet.generated.h"
+
+/**
+ * Bakes a static planet into a cluster LOD hierarchy (SurfaceNetsCore::FClusterHierarchy) on the CPU, so the
+ * runtime can stream and select clusters instead of whole chunks. Runs headless:
+ *
+ *   UnrealEditor-Cmd SurfaceNetsUE.uproject -run=BuildPlanetClusters -Output=Saved/Planet.clusters
+ *       [-PlanetRadius=1000] [-ChunkSize=128] [-ChunksPerAxis=16] [-Seed=1337] [-NoiseScale=] [-NoiseAmplitude=] [-Octaves=]
+ *       [-Workers=N | -WorkerGroups=16:0xFFFF,16:0xFFFF0000]
+ *
+ * The planet is meshed with the same chunk grid and defaults as APlanetActor, centred at the origin. Chunks mesh on
+ * a FPlanetWorkerPool, one thread per logical core unless the worker options pin groups to each socket.
+ */
+UCLASS()
+class SURFACENETSUE_API UBuildPlanetClustersCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UBuildPlanetClustersCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SurfaceNetsCore/SlabAllocator.h"
+
+/**
+ * TArray allocator policy over SurfaceNetsCore::FSlabAllocator, for per-chunk buffers (mesh output, density grids).
+ * Chunks are built and freed on many threads at a high rate; the slab allocator recycles their buffers per thread
+ * instead of going through the global allocator each time. Growth rounds up to the size class, so the slack is free.
+ */
+class FChunkSlabAllocator
+{
+public:
+    using SizeType = int32;
+
+    enum { NeedsElementType = false };
+    enum { RequireRangeCheck = true };
+
+    class ForAnyElementType
+    {
+    public:
+        ForAnyElementType() = default;
+        ForAnyElementType(const ForAnyElementType&) = delete;
+        ForAnyElementType& operator=(const ForAnyElementType&) = delete;
+
+        ~ForAnyElementType()
+        {
+            SurfaceNetsCore::FSlabAllocator::Get().Free(Data);
+        }
+
+        FORCEINLINE void MoveToEmpty(ForAnyElementType& Other)
+        {
+            checkSlow(this != &Other);
+            SurfaceNetsCore::FSlabAllocator::Get().Free(Data);
+            Data = Other.Data;
+            Other.Data = nullptr;
+        }
+
+        FORCEINLINE FScriptContainerElement* GetAllocation() const
+        {
+            return Data;
+        }
+
+        void ResizeAllocation(SizeType CurrentNum, SizeType NewMax, SIZE_T NumBytesPerElement)
+        {
+            SurfaceNetsCore::FSlabAllocator& Allocator = SurfaceNetsCore::FSlabAllocator::Get();
+            if (NewMax == 0)
+            {
+                Allocator.Free(Data);
+                Data = nullptr;
+                return;
+            }
+
+            // Stay in the current block unless it is too small or more than twice too big
+            const SIZE_T NewBytes = static_cast<SIZE_T>(NewMax) * NumBytesPerElement;
+            if (Data && NewBytes <= Allocator.GetUsableSize(Data) && NewBytes * 2 >= Allocator.GetUsableSize(Data))
+            {
+                return;
+            }
+
+            FScriptContainerElement* NewData = static_cast<FScriptContainerElement*>(Allocator.Allocate(NewBytes));
+            if (Data)
+            {
+                FMemory::Memcpy(NewData, Data, static_cast<SIZE_T>(FMath::Min(CurrentNum, NewMax)) * NumBytesPerElement);
+                Allocator.Free(Data);
+            }
+            Data = NewData;
+        }
+
+        SizeType CalculateSlackReserve(SizeType NewMax, SIZE_T NumBytesPerElement) const
+        {
+            return RoundUpToBlock(NewMax, NumBytesPerElement);
+        }
+
+        SizeType CalculateSlackShrink(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+        {
+            return DefaultCalculateSlackShrink(NewMax, CurrentMax, NumBytesPerElement, false);
+        }
+
+        SizeType CalculateSlackGrow(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+        {
+            return RoundUpToBlock(DefaultCalculateSlackGrow(NewMax, CurrentMax, NumBytesPerElement, false), NumBytesPerElement);
+        }
+
+        SIZE_T GetAllocatedSize(SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+        {
+            return static_cast<SIZE_T>(CurrentMax) * NumBytesPerElement;
+        }
+
+        bool HasAllocation() const
+        {
+            return Data != nullptr;
+        }
+
+        SizeType GetInitialCapacity() const
+        {
+            return 0;
+        }
+
+    private:
+        /** Elements fitting in the size class a request for Num elements lands in */
+        static SizeType RoundUpToBlock(SizeType Num, SIZE_T NumBytesPerElement)
+        {
+            if (Num <= 0 || NumBytesPerElement == 0)
+            {
+                return Num;
+            }
+            const SIZE_T GoodSize = SurfaceNetsCore::FSlabAllocator::Get().GetGoodSize(static_cast<SIZE_T>(Num) * NumBytesPerElement);
+            return static_cast<SizeType>(FMath::Min<SIZE_T>(GoodSize / NumBytesPerElement, MAX_int32));
+        }
+
+        FScriptContainerElement* Data = nullptr;
+    };
+
+    template <typename ElementType>
+    class ForElementType : public ForAnyElementType
+    {
+    public:
+        static_assert(alignof(ElementType) <= SurfaceNetsCore::FSlabAllocator::Alignment, "Chunk arrays do not support over-aligned elements");
+
+        ForElementType() = default;
+
+        FORCEINLINE ElementType* GetAllocation() const
+        {
+            return static_cast<ElementType*>(static_cast<void*>(ForAnyElementType::GetAllocation()));
+        }
+    };
+};
+
+template <>
+struct TAllocatorTraits<FChunkSlabAllocator> : TAllocatorTraitsBase<FChunkSlabAllocator>
+{
+    static constexpr bool SupportsMove = true;
+    static constexpr bool IsZeroConstruct = true;
+};
+
+/** Per-chunk array recycled through the slab allocator */
+template <typename T>
+using TChunkArray = TArray<T, FChunkSlabAllocator>;
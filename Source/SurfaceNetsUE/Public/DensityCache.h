@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "SurfaceNetsCore/ChunkLayout.h"
+#include "SurfaceNetsCore/DensityCodec.h"
+#include "SurfaceNetsCore/FractalNoise.h"
+
+#include <atomic>
+
+/** Chunk grid coordinates and LOD of a cached density grid */
+struct FDensityCacheKey
+{
+    FIntVector ChunkCoordinates = FIntVector::ZeroValue;
+    int32 LODLevel = 0;
+
+    bool operator==(const FDensityCacheKey& Other) const
+    {
+        return ChunkCoordinates == Other.ChunkCoordinates && LODLevel == Other.LODLevel;
+    }
+
+    friend uint32 GetTypeHash(const FDensityCacheKey& Key)
+    {
+        return HashCombine(GetTypeHash(Key.ChunkCoordinates), GetTypeHash(Key.LODLevel));
+    }
+};
+
+/** A chunk's padded density grid, immutable once cached so readers on any thread can share it */
+struct FCachedDensity
+{
+    SurfaceNetsCore::FChunkLayout Layout;
+    SurfaceNetsCore::FQuantizedDensityGrid Density;
+};
+
+/**
+ * Quantized density grids of recently generated chunks, so remeshing, navigation and surface queries reuse
+ * samples instead of evaluating the noise again. Least recently used grids are evicted past the byte budget.
+ * All methods are thread-safe.
+ */
+class SURFACENETSUE_API FDensityCache
+{
+public:
+    explicit FDensityCache(int64 InBudgetBytes);
+
+    /**
+     * Bind the cache to a density function and chunk grid (chunk (0, 0, 0) starts at GridOrigin).
+     * Anything cached for a different function or grid is dropped.
+     */
+    void SetSource(const SurfaceNetsCore::FNoiseSettings& InNoiseSettings, const FVector& InGridOrigin, float InChunkSize);
+
+    /** Whether the cache is bound to exactly this density function and chunk grid */
+    bool HasSource(const SurfaceNetsCore::FNoiseSettings& InNoiseSettings, const FVector& InGridOrigin, float InChunkSize) const;
+
+    /** Cached grid for a chunk, marked as recently used; null on a miss */
+    TSharedPtr<const FCachedDensity> Find(const FDensityCacheKey& Key);
+
+    /** Cached grid of the LOD 0 chunk containing a world position, whose bounds are returned even on a miss */
+    TSharedPtr<const FCachedDensity> FindAt(const FVector& Position, FBox& OutChunkBounds);
+
+    /** Quantize and store a chunk's float grid, returning the cached copy */
+    TSharedRef<const FCachedDensity> Add(const FDensityCacheKey& Key, const SurfaceNetsCore::FChunkLayout& Layout, const float* Density);
+
+    void Remove(const FDensityCacheKey& Key);
+    void Empty();
+
+    void SetBudget(int64 InBudgetBytes);
+
+    int64 GetAllocatedBytes() const;
+    int32 Num() const;
+
+    /** Lookups since the last Empty */
+    int64 GetNumHits() const { return NumHits; }
+    int64 GetNumMisses() const { return NumMisses; }
+
+    /** Samples are clamped to this many voxels from the surface; far samples only matter for their sign */
+    static constexpr float ClampVoxels = 8.0f;
+
+private:
+    struct FEntry
+    {
+        TSharedPtr<const FCachedDensity> Density;
+        int64 AllocatedBytes = 0;
+        uint64 LastUsed = 0;
+    };
+
+    /** Drop least recently used entries until the budget holds; caller holds the lock */
+    void EvictToBudget();
+
+    mutable FCriticalSection Mutex;
+    TMap<FDensityCacheKey, FEntry> Entries;
+
+    SurfaceNetsCore::FNoiseSettings NoiseSettings;
+    FVector GridOrigin = FVector::ZeroVector;
+    float ChunkSize = 0.0f;
+
+    int64 BudgetBytes = 0;
+    int64 AllocatedBytes = 0;
+    uint64 UseCounter = 0;
+
+    std::atomic<int64> NumHits{ 0 };
+    std::atomic<int64> NumMisses{ 0 };
+};
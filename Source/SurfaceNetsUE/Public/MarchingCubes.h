@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Mesher.h"
+#include "SurfaceNetsCore/SurfaceNetsMesher.h"
+
+/**
+ * Marching Cubes mesh generation, for content that needs watertight manifold topology (caves, overhangs
+ * used by navigation). Thin Unreal adapter over SurfaceNetsCore::FMarchingCubesMesher.
+ */
+class SURFACENETSUE_API FMarchingCubes : public IMesher
+{
+public:
+    /** Generate mesh from density field; the cells on the min faces of the bounds are treated as padding */
+    virtual void GenerateMesh(
+        TConstArrayView<float> DensityField,
+        int32 GridSize,
+        float VoxelSize,
+        const FVector& Origin,
+        TChunkArray<FVector>& OutVertices,
+        TChunkArray<int32>& OutTriangles,
+        TChunkArray<FVector>& OutNormals,
+        const FIntVector& MinBounds = FIntVector(0, 0, 0),
+        const FIntVector& MaxBounds = FIntVector(0, 0, 0),
+        FPlanetChunkRenderData* OutRenderData = nullptr
+    ) override;
+
+private:
+    /** Edge vertex map and other working memory, reused while this instance is kept alive */
+    SurfaceNetsCore::FSurfaceNetsScratch Scratch;
+};
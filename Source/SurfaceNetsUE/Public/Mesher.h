@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChunkAllocator.h"
+
+class FPlanetChunkRenderData;
+struct FPlanetMeshingSettings;
+
+/**
+ * Common interface of the density field meshers, so chunks can switch algorithm per planet.
+ * Every implementation reads the same padded density grid and writes the same vertex, index and normal arrays.
+ */
+class SURFACENETSUE_API IMesher
+{
+public:
+    virtual ~IMesher() = default;
+
+    /**
+     * Mesh the density field between the given cell bounds.
+     * Zero bounds mesh the whole grid; chunks pass [0, UnpaddedSize + 1) so neighbours tile seamlessly.
+     * With OutRenderData the same pass also writes the GPU vertex and index buffers.
+     */
+    virtual void GenerateMesh(
+        TConstArrayView<float> DensityField,
+        int32 GridSize,
+        float VoxelSize,
+        const FVector& Origin,
+        TChunkArray<FVector>& OutVertices,
+        TChunkArray<int32>& OutTriangles,
+        TChunkArray<FVector>& OutNormals,
+        const FIntVector& MinBounds = FIntVector(0, 0, 0),
+        const FIntVector& MaxBounds = FIntVector(0, 0, 0),
+        FPlanetChunkRenderData* OutRenderData = nullptr
+    ) = 0;
+
+    /** Create the mesher selected by the settings, configured from them */
+    static TUniquePtr<IMesher> Create(const FPlanetMeshingSettings& MeshingSettings);
+
+protected:
+    /** Resolve the zero-bounds default to the whole grid */
+    static void ResolveBounds(int32 GridSize, const FIntVector& MinBounds, const FIntVector& MaxBounds, FIntVector& OutMinBounds, FIntVector& OutMaxBounds);
+};
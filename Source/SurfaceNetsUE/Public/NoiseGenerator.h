@@ -2,8 +2,37 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "SurfaceNetsCore/FractalNoise.h"
 #include "NoiseGenerator.generated.h"
 
+/** Shaping of every noise octave */
+UENUM(BlueprintType)
+enum class EPlanetNoiseType : uint8
+{
+    /** Plain fractal noise; rolling hills */
+    Fbm UMETA(DisplayName = "fBm"),
+
+    /** Absolute noise; rounded, puffy hills with creases between them */
+    Billow,
+
+    /** Inverted absolute noise, squared; sharp mountain ridges */
+    Ridged
+};
+
+/** How the height enters the density, see UNoiseGenerator::SamplingMode */
+UENUM(BlueprintType)
+enum class EPlanetSamplingMode : uint8
+{
+    /** Heightfield whenever the volumetric noise cannot form overhangs anyway, volumetric otherwise */
+    Auto,
+
+    /** Height read at every sample's own position; allows overhangs and caves */
+    Volumetric,
+
+    /** Height read on the base sphere below every sample; no overhangs, chunks sample a 2D height grid */
+    Heightfield
+};
+
 /**
  * Noise generator for procedural planet terrain
  */
@@ -47,27 +76,71 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise")
     int32 Seed = 1337;
 
-    /** Sample density at world position for Surface Nets */
+    /** Give every octave its own seed so their lattices do not line up; changes the terrain */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise")
+    bool bDecorrelateOctaves = false;
+
+    /** Shaping of every octave: hills, billows or ridged mountains */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise")
+    EPlanetNoiseType NoiseType = EPlanetNoiseType::Fbm;
+
+    /** Largest distance the domain warp moves terrain along each axis, bending features into continents; 0 disables it */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise|Warp", meta = (ClampMin = "0.0"))
+    float WarpStrength = 0.0f;
+
+    /** Frequency of the warp field, usually well below NoiseScale */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise|Warp", meta = (ClampMin = "0.0"))
+    float WarpScale = 0.0002f;
+
+    /**
+     * Heightfields read the terrain on the base sphere, so chunks evaluate the noise once per column instead of
+     * once per voxel. The terrain shifts slightly against volumetric sampling, which reads it at each voxel, so
+     * existing planets keep Volumetric and presets or actors opt in to Heightfield or Auto. Only the fast path
+     * samples columns: without bFastNoise every voxel is still evaluated and the mode saves nothing. The saving
+     * shrinks with the octave count, since fine octaves are read per sample either way (BM_FillHeightfieldGrid:
+     * about 1.5x at 3 octaves and 2x with warp, 1.1-1.2x at 8), so it pays for few-octave or warped terrain
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise|Performance")
+    EPlanetSamplingMode SamplingMode = EPlanetSamplingMode::Volumetric;
+
+    /** Sample the noise in float32 with precomputed octaves instead of double precision */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise|Performance")
+    bool bFastNoise = true;
+
+    /** Largest density difference to the double precision noise the fast path may show; beyond it sampling falls back */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise|Performance", meta = (ClampMin = "0.0", EditCondition = "bFastNoise"))
+    float FastNoiseTolerance = 0.01f;
+
+    /** Height error, in voxels, chunk generation may add by interpolating low octaves and the warp from coarse lattices; 0 samples both at every voxel */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Noise|Performance", meta = (ClampMin = "0.0", EditCondition = "bFastNoise"))
+    float CoarseOctaveError = 0.05f;
+
+    /** Sample density at world position with the double precision noise; chunk generation may use the fast path, within FastNoiseTolerance of it */
     UFUNCTION(BlueprintCallable, Category = "Noise")
     float SampleDensity(const FVector& WorldPosition) const;
     
-    /** Sample height at surface position */
+    /** Sample height at surface position, like SampleDensity */
     UFUNCTION(BlueprintCallable, Category = "Noise")
     float SampleHeight(const FVector& SurfacePosition) const;
 
+    /** Snapshot of the density parameters for the engine-independent core sampler */
+    SurfaceNetsCore::FNoiseSettings GetNoiseSettings() const;
+
+    /** Core fractal type of a noise type */
+    static SurfaceNetsCore::ENoiseFractalType ToCore(EPlanetNoiseType NoiseType);
+
+    /** Whether settings are sampled as a heightfield in a mode, Auto deciding from whether they can form overhangs */
+    static bool UsesHeightfield(EPlanetSamplingMode SamplingMode, const SurfaceNetsCore::FNoiseSettings& Settings);
+
 private:
-    /** Generate fractal noise */
-    float FractalNoise(const FVector& Position) const;
-    
-    /** Simple 3D Perlin-like noise */
-    float SimplexNoise(const FVector& Position) const;
-    
-    /** Hash function for noise generation */
-    float Hash(float x, float y, float z) const;
-    
-    /** Smooth interpolation function */
-    float SmoothStep(float t) const;
-    
-    /** Linear interpolation */
-    float Lerp(float a, float b, float t) const;
+    /** GetNoiseSettings without the fast path, built without taking FastNoiseLock */
+    SurfaceNetsCore::FNoiseSettings MakeReferenceSettings() const;
+
+    /** Whether the fast path stays within FastNoiseTolerance for these settings, measured once per settings */
+    bool IsFastNoiseWithinTolerance(const SurfaceNetsCore::FNoiseSettings& Settings) const;
+
+    /** Last settings the fast path was measured for and the result; GetNoiseSettings may run on any thread */
+    mutable FCriticalSection FastNoiseLock;
+    mutable TOptional<SurfaceNetsCore::FNoiseSettings> MeasuredSettings;
+    mutable float MeasuredError = 0.0f;
 };
\ No newline at end of file
@@ -2,11 +2,97 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
-#include "ProceduralMeshComponent.h"
+#include "PlanetChunkMeshComponent.h"
 #include "PlanetChunk.h"  // Include the complete definition
+#include "DensityCache.h"
+#include "PlanetMeshingSettings.h"
+#include "PlanetSurfaceQuery.h"
+#include "PlanetWorkerPool.h"
+#include "SurfaceNetsCore/CompletionQueue.h"
+#include "SurfaceNetsCore/Occupancy.h"
 #include "PlanetActor.generated.h"
 
 class UNoiseGenerator;
+class UPlanetPreset;
+class UMaterialInstanceDynamic;
+class UMaterialInterface;
+
+/** A chunk mesh component fading in or out after a swap */
+USTRUCT()
+struct FPlanetChunkFade
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    UPlanetChunkMeshComponent* Component = nullptr;
+
+    UPROPERTY()
+    UMaterialInstanceDynamic* Material = nullptr;
+
+    float Opacity = 0.0f;
+    bool bFadeIn = true;
+};
+
+/** A regenerated chunk and its hidden mesh component (null when empty), waiting to be swapped in with its batch */
+struct FPlanetChunkBuild
+{
+    FIntVector Coordinates = FIntVector::ZeroValue;
+    TUniquePtr<FPlanetChunk> Chunk;
+    UPlanetChunkMeshComponent* MeshComponent = nullptr;
+};
+
+/** A chunk generated on a worker thread, handed to the game thread through the completion queue */
+struct FPlanetChunkResult
+{
+    int32 BatchId = 0;
+    FIntVector Coordinates = FIntVector::ZeroValue;
+    TUniquePtr<FPlanetChunk> Chunk;
+};
+
+using FPlanetChunkQueue = SurfaceNetsCore::TCompletionQueue<FPlanetChunkResult>;
+
+/** A full or partial regeneration in progress; it swaps in once every chunk is built and earlier batches are in */
+struct FPlanetChunkBatch
+{
+    int32 BatchId = 0;
+
+    /** Replaces the whole planet, dropping chunks it does not contain */
+    bool bReplaceAll = false;
+
+    /** Chunks not yet back from the workers */
+    int32 NumRemaining = 0;
+
+    TArray<FPlanetChunkBuild> Builds;
+};
+
+/** A chunk waiting for a worker, launched from Tick while the queue has room */
+struct FPlanetChunkRequest
+{
+    int32 BatchId = 0;
+    FIntVector Coordinates = FIntVector::ZeroValue;
+    FVector Center = FVector::ZeroVector;
+};
+
+/** Settings the current chunks were built from, diffed by InitializePlanet to redo only the stages that changed */
+struct FPlanetBuildInputs
+{
+    /** Density function and chunk grid; any change resamples every chunk */
+    SurfaceNetsCore::FNoiseSettings NoiseSettings;
+    FVector GridOrigin = FVector::ZeroVector;
+    float ChunkSize = 0.0f;
+    int32 ChunksPerAxis = 0;
+
+    /** Remeshes the chunks crossing the surface, from cached densities */
+    FPlanetMeshingSettings MeshingSettings;
+
+    /** Applied to the existing components */
+    bool bEnableCollision = false;
+    TWeakObjectPtr<UMaterialInterface> PlanetMaterial;
+
+    /** Rebuilds the nav graphs from the existing meshes */
+    bool bBuildNavigation = false;
+    float NavMaxSlopeDegrees = 0.0f;
+};
 
 UCLASS(BlueprintType, Blueprintable)
 class SURFACENETSUE_API APlanetActor : public AActor
@@ -18,8 +104,19 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
+    virtual void Tick(float DeltaSeconds) override;
+
+public:
+    /**
+     * Shared generator settings; when set they replace PlanetRadius and the NoiseGenerator's noise parameters and
+     * their saved octave bounds feed the chunk occupancy. Editing the asset regenerates the planet.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Planet")
+    UPlanetPreset* Preset = nullptr;
+
     /** Planet radius in world units */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Planet")
     float PlanetRadius = 1000.0f;
@@ -40,18 +137,117 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Planet")
     bool bEnableCollision = false;
     
+    /** Mesher options (vertex placement) for every chunk */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Meshing")
+    FPlanetMeshingSettings MeshingSettings;
+    
+    /** Keep quantized chunk densities so re-initializing with unchanged noise (e.g. after mesher tweaks) and surface queries skip the noise */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance")
+    bool bCacheDensity = true;
+
+    /** Memory for cached densities; least recently used chunks are dropped beyond it */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance", meta = (ClampMin = "1", EditCondition = "bCacheDensity"))
+    int32 DensityCacheBudgetMB = 64;
+
+    /**
+     * Generate chunks on worker threads. Finished chunks come back through a lock-free queue and get their mesh
+     * components on the game thread within ChunkUploadBudgetMs per frame; each batch still swaps in as a whole.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance")
+    bool bAsyncGeneration = true;
+
+    /** Game thread time per frame for turning finished chunks into mesh components; at least one chunk per frame */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance", meta = (ClampMin = "0.0", EditCondition = "bAsyncGeneration"))
+    float ChunkUploadBudgetMs = 2.0f;
+
+    /** Chunks generating or waiting in the completion queue at once; also the queue capacity */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance", meta = (ClampMin = "1", EditCondition = "bAsyncGeneration"))
+    int32 MaxChunksInFlight = 64;
+
+    /**
+     * Dedicated generation threads, e.g. one pinned group per socket so chunk memory stays on the node that builds
+     * it. Empty uses the engine task graph. Changes apply to the next batch started with nothing in flight.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance", meta = (EditCondition = "bAsyncGeneration"))
+    FPlanetWorkerSettings GenerationWorkers;
+
+    /** Build a walkable surface graph per chunk for AI pathfinding, aligned to the planet's up rather than world Z */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation")
+    bool bBuildNavigation = true;
+
+    /** Steepest walkable slope, measured from the local up (away from the planet center) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation", meta = (ClampMin = "0.0", ClampMax = "90.0", EditCondition = "bBuildNavigation"))
+    float NavMaxSlopeDegrees = 45.0f;
+
     /** Material to apply to planet surface */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rendering")
     UMaterialInterface* PlanetMaterial = nullptr;
+
+    /**
+     * Crossfade regenerated chunks instead of swapping them in one frame. Needs PlanetMaterial to drive a dithered
+     * opacity mask from ChunkFadeParameterName (0 hidden, 1 opaque); other materials just swap.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rendering")
+    bool bCrossfadeChunkSwaps = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rendering", meta = (ClampMin = "0.0", EditCondition = "bCrossfadeChunkSwaps"))
+    float ChunkCrossfadeSeconds = 0.25f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rendering", meta = (EditCondition = "bCrossfadeChunkSwaps"))
+    FName ChunkFadeParameterName = TEXT("ChunkFade");
     
     /** Noise generator for terrain */
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Planet")
     UNoiseGenerator* NoiseGenerator = nullptr;
 
-    /** Initialize or reinitialize the planet with current parameters */
+    /**
+     * Initialize or reinitialize the planet with current parameters. Chunks whose inputs did not change are kept:
+     * material and collision changes update the existing components, navigation changes rebuild the nav graphs and
+     * mesher changes remesh only the chunks crossing the surface without resampling them (with bCacheDensity).
+     * Noise, grid changes and batches still in flight regenerate everything.
+     */
     UFUNCTION(BlueprintCallable, Category = "Planet")
     void InitializePlanet();
 
+    /**
+     * Regenerate the chunks overlapping Bounds, e.g. after their terrain was edited, along with the neighbours
+     * sharing their padding. The old meshes stay until every new one is built, then all swap in the same frame.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Planet")
+    void RegenerateChunksInBounds(const FBox& Bounds);
+
+    /** Rebuild the navigation of the chunks overlapping Bounds, e.g. after their terrain was edited */
+    UFUNCTION(BlueprintCallable, Category = "Navigation")
+    void RebuildNavigationInBounds(const FBox& Bounds);
+
+    /**
+     * Find a walkable path over the planet surface, crossing chunk borders through shared boundary nodes.
+     * Fails when either end is not near a walkable chunk surface or the two are not connected.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Navigation")
+    bool FindSurfacePath(const FVector& Start, const FVector& End, TArray<FVector>& OutPath) const;
+
+    /** First terrain hit on the segment from Start to End, traced against the density function rather than collision */
+    UFUNCTION(BlueprintCallable, Category = "Queries")
+    bool RaycastSurface(const FVector& Start, const FVector& End, FVector& OutHitLocation, FVector& OutHitNormal) const;
+
+    /** Nearest point on the terrain surface to Point */
+    UFUNCTION(BlueprintCallable, Category = "Queries")
+    bool FindClosestSurfacePoint(const FVector& Point, FVector& OutSurfacePoint) const;
+
+    /** Terrain height above PlanetRadius below each location, evaluated in parallel; false if any location had no surface */
+    UFUNCTION(BlueprintCallable, Category = "Queries")
+    bool GetSurfaceHeights(const TArray<FVector>& Locations, TArray<float>& OutHeights) const;
+
+    /**
+     * Whether the chunks in [Min, Max] (grid coordinates, inclusive) can hold surface, from the occupancy pyramid
+     * and without sampling noise, e.g. for LOD selection. Inside and Outside are certain, Surface is conservative.
+     */
+    SurfaceNetsCore::EOccupancy ClassifyChunks(const FIntVector& Min, const FIntVector& Max) const;
+
+    /** Copy of the current density function for running surface queries off the game thread */
+    FPlanetSurfaceQuery MakeSurfaceQuery() const;
+
     /** Debug: Log planet generation statistics */
     UFUNCTION(BlueprintCallable, Category = "Debug")
     void LogPlanetStats();
@@ -60,16 +256,122 @@ private:
     /** Generated planet chunks */
     TArray<TUniquePtr<FPlanetChunk>> PlanetChunks;
     
-    /** Mesh components for rendering chunks */
+    /** Index into PlanetChunks of each chunk grid position */
+    TMap<FIntVector, int32> ChunkIndices;
+
+    /** Visible mesh component of each chunk grid position that has a mesh */
     UPROPERTY()
-    TArray<UProceduralMeshComponent*> MeshComponents;
+    TMap<FIntVector, UPlanetChunkMeshComponent*> ChunkComponents;
+
+    /** Components crossfading after a swap; faded-out ones are destroyed at the end */
+    UPROPERTY()
+    TArray<FPlanetChunkFade> ChunkFades;
+
+    /** Finished chunks from the workers; shared so workers still running after the actor is gone have somewhere to push */
+    TSharedPtr<FPlanetChunkQueue> ChunkQueue;
+
+    /** Regenerations in flight, oldest first */
+    TArray<FPlanetChunkBatch> ChunkBatches;
+
+    /** Threads from GenerationWorkers; null while it is empty */
+    TUniquePtr<FPlanetWorkerPool> WorkerPool;
+
+    /** Chunks not yet handed to a worker */
+    TArray<FPlanetChunkRequest> PendingChunks;
+
+    /** Chunks launched and not yet popped from ChunkQueue; kept at most its capacity so pushes never fail */
+    int32 NumChunksInFlight = 0;
+
+    int32 NextBatchId = 0;
+
+    /** What the current chunks, or the full batch replacing them, were built from; unset before the first build */
+    TOptional<FPlanetBuildInputs> BuiltInputs;
     
     /** Create a new mesh component */
-    UProceduralMeshComponent* CreateMeshComponent();
+    UPlanetChunkMeshComponent* CreateMeshComponent();
     
     /** Generate all chunks for the planet */
     void GenerateAllChunks();
+
+    /** Regenerate after the preset was edited */
+    void HandlePresetChanged(UPlanetPreset* ChangedPreset);
+
+    FDelegateHandle PresetChangedHandle;
+
+    /** Snapshot of the current settings for BuiltInputs */
+    FPlanetBuildInputs GatherBuildInputs() const;
+
+    /** Bring the chunks built from BuiltInputs up to Inputs; false when everything has to be regenerated instead */
+    bool UpdateChunksInPlace(const FPlanetBuildInputs& Inputs);
+
+    /** Regenerate the chunks whose density grid crosses the surface; the others stay empty under any mesher */
+    void RemeshSurfaceChunks();
+
+    /** Create, resize or drop the density cache for bCacheDensity and the current density function */
+    void ConfigureDensityCache(const SurfaceNetsCore::FNoiseSettings& NoiseSettings, const FVector& GridOrigin);
+
+    /** Put PlanetMaterial on a visible component, keeping a fade in progress going */
+    void ApplyChunkMaterial(UPlanetChunkMeshComponent* MeshComponent);
+
+    /** World position of chunk (0, 0, 0)'s min corner */
+    FVector GetChunkGridOrigin() const;
     
-    /** Generate a single chunk at the specified grid position */
-    bool GenerateChunk(int32 X, int32 Y, int32 Z, const FVector& ChunkCenter);
+    /** Generate a single chunk at the specified grid position, with a hidden mesh component */
+    bool BuildChunk(int32 X, int32 Y, int32 Z, const FVector& ChunkCenter, FPlanetChunkBuild& OutBuild);
+
+    /** Hidden mesh component for a generated chunk, taking over its render data; null when it has no mesh */
+    UPlanetChunkMeshComponent* CreateChunkMeshComponent(FPlanetChunk& Chunk);
+
+    /** Start an asynchronous batch; a full regeneration drops the batches it supersedes */
+    void QueueChunkBatch(TArray<FPlanetChunkRequest>& Requests, bool bReplaceAll);
+
+    /** Hand pending chunks to workers while the completion queue has room */
+    void LaunchPendingChunks();
+
+    /** Pop finished chunks within the frame budget and swap in completed batches */
+    void DrainChunkQueue();
+
+    /** Drop queued batches and destroy their hidden components; results still in flight are discarded on arrival */
+    void CancelChunkBatches();
+
+    /** Swap in a batch holding the whole planet, retiring chunks it no longer has */
+    void ReplaceAllChunks(TArray<FPlanetChunkBuild>& Builds);
+
+    /** Replace chunks and their components with a finished batch, all in this frame */
+    void SwapInChunks(TArray<FPlanetChunkBuild>& Builds);
+
+    /** Show a swapped-in component, fading it in when crossfading */
+    void ShowMeshComponent(UPlanetChunkMeshComponent* MeshComponent);
+
+    /** Destroy a replaced component, or fade it out first when crossfading */
+    void RetireMeshComponent(UPlanetChunkMeshComponent* MeshComponent);
+
+    void StartChunkFade(UPlanetChunkMeshComponent* MeshComponent, bool bFadeIn);
+
+    /** Density range of every chunk and block of chunks; chunks entirely inside or outside the terrain are never sampled */
+    SurfaceNetsCore::FOccupancyPyramid OccupancyPyramid;
+
+    /** Octave bounds the pyramid was built with, from the preset when there is one */
+    SurfaceNetsCore::FNoiseBounds NoiseBounds;
+
+    /** Density grids shared with chunk generation and surface queries; null while bCacheDensity is off */
+    TSharedPtr<FDensityCache> DensityCache;
+
+    /** Chunk nav nodes at each portal key, linking the graphs of neighbouring chunks (ids from MakeNavNodeId) */
+    TMap<uint64, TArray<uint64>> NavPortals;
+
+    /** Source of FPlanetChunk::NavRevision, never reset so results for replaced chunks are always stale */
+    int32 NextNavRevision = 0;
+
+    /** Build or clear a chunk's nav graph for bBuildNavigation */
+    void UpdateChunkNavigation(int32 ChunkIndex);
+
+    /** Build a chunk's nav graph on a worker thread from its current mesh */
+    void RebuildChunkNavigation(int32 ChunkIndex);
+
+    /** Install a finished nav graph on the game thread, relinking the chunk's portals */
+    void SetChunkNavGraph(int32 ChunkIndex, int32 Revision, TSharedPtr<const SurfaceNetsCore::FSurfaceNavGraph> NavGraph);
+
+    /** Nearest nav node to a world position over the chunks around it */
+    bool FindNearestNavNode(const FVector& Point, uint64& OutNodeId) const;
 };
\ No newline at end of file
@@ -1,8 +1,15 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ChunkAllocator.h"
+#include "PlanetChunkRenderData.h"
+#include "PlanetMeshingSettings.h"
+#include "SurfaceNetsCore/ChunkLayout.h"
+#include "SurfaceNetsCore/FractalNoise.h"
+#include "SurfaceNetsCore/SurfaceNavGraph.h"
 
 class UNoiseGenerator;
+class FDensityCache;
 
 /**
  * Represents a chunk of planet terrain, equivalent to Rust chunk implementation
@@ -17,32 +24,54 @@ public:
     /** Chunk center position in world coordinates */
     FVector Position;
     
+    /** Position in the owning planet's chunk grid, the density cache key with LODLevel */
+    FIntVector ChunkCoordinates = FIntVector::ZeroValue;
+
     /** LOD level (0 = highest detail) */
     int32 LODLevel;
     
     /** Size of the chunk in world units */
     float Size;
     
-    /** Generated mesh data */
-    TArray<FVector> Vertices;
-    TArray<int32> Triangles;
-    TArray<FVector> Normals;
-    TArray<FVector2D> UVs;
+    /** Generated mesh data for navigation, collision and baking, in slab-allocated buffers recycled across chunks */
+    TChunkArray<FVector> Vertices;
+    TChunkArray<int32> Triangles;
+    TChunkArray<FVector> Normals;
+
+    /** Vertex and index buffers for rendering, written by the mesher when requested; moved out to the mesh component */
+    TUniquePtr<FPlanetChunkRenderData> RenderData;
     
     /** Generation state */
     bool bIsGenerated;
     bool bIsGenerating;
     bool bIsEmpty;
+
+    /** Whether the padded density grid crosses the surface; without a crossing no mesher settings give a mesh */
+    bool bHasSurface = false;
     
     /** Distance from camera for LOD calculations */
     float DistanceFromCamera;
 
+    /** Walkable surface graph for AI, built asynchronously from the mesh; owned and linked to neighbours by APlanetActor */
+    TSharedPtr<const SurfaceNetsCore::FSurfaceNavGraph> NavGraph;
+
+    /** Latest navigation build requested for this chunk; results of older builds are discarded */
+    int32 NavRevision = 0;
+
     // Chunk dimensions (matching Rust implementation)
-    static const int32 UNPADDED_CHUNK_SIZE = 16;
-    static const int32 PADDED_CHUNK_SIZE = 18;
+    static const int32 UNPADDED_CHUNK_SIZE = SurfaceNetsCore::FChunkLayout::UnpaddedSize;
+    static const int32 PADDED_CHUNK_SIZE = SurfaceNetsCore::FChunkLayout::PaddedSize;
 
-    /** Generate mesh for this chunk (equivalent to Rust chunk processing) */
-    bool GenerateMesh(const UNoiseGenerator* NoiseGenerator);
+    /**
+     * Generate mesh for this chunk (equivalent to Rust chunk processing). With a DensityCache the density grid
+     * comes from the cache when present and is added to it otherwise; either way the mesh is built from the
+     * cached (quantized) samples, so it does not depend on whether the lookup hit. bBuildRenderData also fills
+     * RenderData in the same mesher pass.
+     */
+    bool GenerateMesh(const UNoiseGenerator* NoiseGenerator, const FPlanetMeshingSettings& MeshingSettings = FPlanetMeshingSettings(), FDensityCache* DensityCache = nullptr, bool bBuildRenderData = false);
+
+    /** Same from a snapshot of the noise settings; touches no UObject, so it can run on worker threads */
+    bool GenerateMesh(const SurfaceNetsCore::FNoiseSettings& NoiseSettings, const FPlanetMeshingSettings& MeshingSettings = FPlanetMeshingSettings(), FDensityCache* DensityCache = nullptr, bool bBuildRenderData = false);
     
     /** Clear all mesh data */
     void ClearMesh();
@@ -50,11 +79,26 @@ public:
     /** Get voxel resolution based on LOD level */
     int32 GetVoxelResolution() const;
 
+    /** World bounds of the unpadded chunk volume */
+    FBox GetBounds() const;
+
+    /** Navigation settings for this chunk: up from PlanetCenter, portals within a voxel of the chunk faces */
+    SurfaceNetsCore::FSurfaceNavSettings MakeNavSettings(const FVector& PlanetCenter, float MaxSlopeDegrees) const;
+
+    /** Build a nav graph from mesh arrays; thread-safe, used off the game thread */
+    static TSharedRef<SurfaceNetsCore::FSurfaceNavGraph> BuildNavGraph(
+        TConstArrayView<FVector> InVertices,
+        TConstArrayView<int32> InTriangles,
+        TConstArrayView<FVector> InNormals,
+        const SurfaceNetsCore::FSurfaceNavSettings& NavSettings
+    );
+
 private:
     /** Generate padded density field exactly like Rust implementation */
     bool GeneratePaddedDensityField(
-        const UNoiseGenerator* NoiseGenerator,
-        TArray<float>& OutDensityField,
+        const SurfaceNetsCore::FNoiseSettings& NoiseSettings,
+        FDensityCache* DensityCache,
+        TChunkArray<float>& OutDensityField,
         int32& OutPaddedSize,
         FVector& OutPaddedOrigin,
         float& OutVoxelSize
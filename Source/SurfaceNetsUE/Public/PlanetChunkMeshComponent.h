@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/MeshComponent.h"
+#include "Interfaces/Interface_CollisionDataProvider.h"
+#include "PlanetChunkMeshComponent.generated.h"
+
+class FPlanetChunkRenderData;
+class UBodySetup;
+
+/**
+ * Renders one planet chunk from the vertex and index buffers its mesher wrote, taking ownership of them instead
+ * of copying sections the way UProceduralMeshComponent does. Collision is cooked from the chunk's game-side mesh.
+ */
+UCLASS(ClassGroup = Rendering, meta = (BlueprintSpawnableComponent))
+class SURFACENETSUE_API UPlanetChunkMeshComponent : public UMeshComponent, public IInterface_CollisionDataProvider
+{
+    GENERATED_BODY()
+
+public:
+    UPlanetChunkMeshComponent(const FObjectInitializer& ObjectInitializer);
+
+    /** Take over a chunk's render data; its buffers are created on the render thread and released there */
+    void SetRenderData(TUniquePtr<FPlanetChunkRenderData>&& InRenderData);
+
+    /** The render data last handed over, null before that or once cleared */
+    const FPlanetChunkRenderData* GetRenderData() const { return RenderData.Get(); }
+
+    /** Cook complex-as-simple collision from the chunk's mesh; the arrays are only read during the call */
+    void SetCollisionMesh(TConstArrayView<FVector> Vertices, TConstArrayView<int32> Triangles);
+
+    /** Drop the cooked collision, e.g. when the planet turns collision off */
+    void ClearCollisionMesh();
+
+    //~ Begin UPrimitiveComponent Interface
+    virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+    virtual UBodySetup* GetBodySetup() override;
+    //~ End UPrimitiveComponent Interface
+
+    //~ Begin UMeshComponent Interface
+    virtual int32 GetNumMaterials() const override;
+    //~ End UMeshComponent Interface
+
+    //~ Begin IInterface_CollisionDataProvider Interface
+    virtual bool GetPhysicsTriMeshData(FTriMeshCollisionData* CollisionData, bool InUseAllTriData) override;
+    virtual bool ContainsPhysicsTriMeshData(bool InUseAllTriData) const override;
+    virtual bool WantsNegXTriMesh() override { return false; }
+    //~ End IInterface_CollisionDataProvider Interface
+
+private:
+    //~ Begin USceneComponent Interface
+    virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+    //~ End USceneComponent Interface
+
+    friend class FPlanetChunkSceneProxy;
+
+    /** Shared with the scene proxies, which are recreated on material changes; the last owner releases it on the render thread */
+    TSharedPtr<FPlanetChunkRenderData, ESPMode::ThreadSafe> RenderData;
+
+    FBoxSphereBounds LocalBounds;
+
+    /** Collision mesh while SetCollisionMesh cooks it, empty otherwise */
+    TArray<FVector3f> CollisionVertices;
+    TArray<FTriIndices> CollisionTriangles;
+
+    UPROPERTY(Transient)
+    TObjectPtr<UBodySetup> BodySetup;
+};
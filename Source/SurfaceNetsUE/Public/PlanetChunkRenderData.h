@@ -0,0 +1,124 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DynamicMeshBuilder.h"
+#include "LocalVertexFactory.h"
+#include "StaticMeshResources.h"
+#include "SurfaceNetsCoreBridge.h"
+
+/**
+ * GPU-ready mesh of one chunk, in the static mesh vertex buffer layout. The mesher writes into it on the worker
+ * that builds the chunk; it then moves, never copies, into a UPlanetChunkMeshComponent, which hands it to the
+ * render thread. The CPU copies are dropped once uploaded.
+ */
+class SURFACENETSUE_API FPlanetChunkRenderData
+{
+public:
+    /** Planar UVs over the XY footprint of the chunk at UVOrigin, UVSize across */
+    FPlanetChunkRenderData(const FVector& InUVOrigin, float InUVSize);
+    ~FPlanetChunkRenderData();
+
+    UE_NONCOPYABLE(FPlanetChunkRenderData);
+
+    /** Size every buffer for the mesher's exact counts; the vertices and indices are then written in place */
+    void Allocate(int32 NumVertices, int32 NumTriangles);
+
+    FORCEINLINE void SetVertex(uint32 Index, const SurfaceNetsCore::FVec3& Position, const SurfaceNetsCore::FVec3& Normal)
+    {
+        const FVector3f VertexPosition(Position.X, Position.Y, Position.Z);
+        const FVector3f TangentZ(Normal.X, Normal.Y, Normal.Z);
+
+        // Tangent along the UVs' U axis (world X) where the surface allows, world Y where it faces along X
+        FVector3f TangentX = FVector3f(1.0f, 0.0f, 0.0f) - TangentZ * TangentZ.X;
+        if (!TangentX.Normalize())
+        {
+            TangentX = (FVector3f(0.0f, 1.0f, 0.0f) - TangentZ * TangentZ.Y).GetSafeNormal();
+        }
+
+        VertexBuffers.PositionVertexBuffer.VertexPosition(Index) = VertexPosition;
+        VertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(Index, TangentX, TangentZ ^ TangentX, TangentZ);
+        VertexBuffers.StaticMeshVertexBuffer.SetVertexUV(Index, 0, FVector2f(
+            (VertexPosition.X - UVOrigin.X) / UVSize + 0.5f,
+            (VertexPosition.Y - UVOrigin.Y) / UVSize + 0.5f));
+        LocalBox += VertexPosition;
+    }
+
+    FORCEINLINE uint32* GetIndexData()
+    {
+        return IndexBuffer.Indices.GetData();
+    }
+
+    /** Create the RHI resources from the CPU buffers, then free those; render thread only */
+    void InitResources(FRHICommandListBase& RHICmdList, ERHIFeatureLevel::Type FeatureLevel);
+
+    /** Release the RHI resources; render thread only */
+    void ReleaseResources();
+
+    int32 GetNumVertices() const { return NumVertices; }
+    int32 GetNumTriangles() const { return NumTriangles; }
+
+    /** Bounds of the vertices as written, in the component's space */
+    FBoxSphereBounds GetLocalBounds() const;
+
+    /** Size of the vertex and index data, held on the CPU until upload and on the GPU after */
+    SIZE_T GetAllocatedSize() const;
+
+    const FLocalVertexFactory* GetVertexFactory() const { return VertexFactory.GetPtrOrNull(); }
+    const FIndexBuffer& GetIndexBuffer() const { return IndexBuffer; }
+
+private:
+    FStaticMeshVertexBuffers VertexBuffers;
+    FDynamicMeshIndexBuffer32 IndexBuffer;
+
+    /** Created with the resources, the feature level is the scene's */
+    TOptional<FLocalVertexFactory> VertexFactory;
+
+    FVector3f UVOrigin;
+    float UVSize;
+    FBox3f LocalBox = FBox3f(ForceInit);
+
+    int32 NumVertices = 0;
+    int32 NumTriangles = 0;
+};
+
+/** Mesher sink filling a chunk's game-side arrays (navigation, collision) and its render data in the same pass */
+struct FPlanetChunkRenderSink
+{
+    SurfaceNetsBridge::FTArrayMeshSink Arrays;
+    FPlanetChunkRenderData& RenderData;
+
+    uint32 NextRenderVertex = 0;
+    uint32* NextRenderIndex = nullptr;
+
+    void Allocate(int32 NumVertices, int32 NumTriangles)
+    {
+        Arrays.Allocate(NumVertices, NumTriangles);
+        RenderData.Allocate(NumVertices, NumTriangles);
+        NextRenderIndex = RenderData.GetIndexData();
+    }
+
+    FORCEINLINE void AddVertex(const SurfaceNetsCore::FVec3& Position, const SurfaceNetsCore::FVec3& Normal)
+    {
+        checkSlow(NextRenderVertex < static_cast<uint32>(RenderData.GetNumVertices()));
+        Arrays.AddVertex(Position, Normal);
+        RenderData.SetVertex(NextRenderVertex++, Position, Normal);
+    }
+
+    FORCEINLINE void AddTriangle(int32 A, int32 B, int32 C)
+    {
+        checkSlow(NextRenderIndex + 3 <= RenderData.GetIndexData() + RenderData.GetNumTriangles() * 3);
+        Arrays.AddTriangle(A, B, C);
+        NextRenderIndex[0] = static_cast<uint32>(A);
+        NextRenderIndex[1] = static_cast<uint32>(B);
+        NextRenderIndex[2] = static_cast<uint32>(C);
+        NextRenderIndex += 3;
+    }
+
+    /** Whether the arrays and the render data have both been filled to the counts Allocate was given */
+    bool IsComplete()
+    {
+        return Arrays.IsComplete()
+            && NextRenderVertex == static_cast<uint32>(RenderData.GetNumVertices())
+            && NextRenderIndex == RenderData.GetIndexData() + RenderData.GetNumTriangles() * 3;
+    }
+};
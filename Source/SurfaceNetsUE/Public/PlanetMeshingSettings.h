@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SurfaceNetsCore/SurfaceNetsMesher.h"
+#include "PlanetMeshingSettings.generated.h"
+
+/** Meshing algorithm used for the planet's chunks */
+UENUM(BlueprintType)
+enum class EPlanetMeshingAlgorithm : uint8
+{
+    /** Dual method, one vertex per surface cell; smooth and compact */
+    SurfaceNets UMETA(DisplayName = "Surface Nets"),
+
+    /** Vertices on the crossed edges; guaranteed watertight manifold topology for caves and navigation */
+    MarchingCubes UMETA(DisplayName = "Marching Cubes")
+};
+
+/** Where the mesher places the vertex of each surface cell */
+UENUM(BlueprintType)
+enum class EPlanetVertexPlacement : uint8
+{
+    /** Average of the edge crossings; smooth, rounds off cliffs and rims */
+    Centroid UMETA(DisplayName = "Smooth (Centroid)"),
+
+    /** Dual contouring QEF solve from crossings and normals; keeps sharp features at lower resolution */
+    SharpFeatures UMETA(DisplayName = "Sharp Features (QEF)")
+};
+
+/**
+ * Mesher options shared by every chunk of a planet
+ */
+USTRUCT(BlueprintType)
+struct SURFACENETSUE_API FPlanetMeshingSettings
+{
+    GENERATED_BODY()
+
+    /** Meshing algorithm; the options below apply to Surface Nets only */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Meshing")
+    EPlanetMeshingAlgorithm Algorithm = EPlanetMeshingAlgorithm::SurfaceNets;
+
+    /** Vertex placement inside surface cells */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Meshing", meta = (EditCondition = "Algorithm == EPlanetMeshingAlgorithm::SurfaceNets"))
+    EPlanetVertexPlacement VertexPlacement = EPlanetVertexPlacement::Centroid;
+
+    /** Pull of sharp-feature vertices towards the cell centroid; higher is more stable but rounder */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Meshing", meta = (ClampMin = "0.001", EditCondition = "Algorithm == EPlanetMeshingAlgorithm::SurfaceNets && VertexPlacement == EPlanetVertexPlacement::SharpFeatures"))
+    float QefMassPointWeight = 0.05f;
+
+    /** Split cell vertices per surface sheet so thin features stay manifold for collision cooking and simplification */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Meshing", meta = (EditCondition = "Algorithm == EPlanetMeshingAlgorithm::SurfaceNets"))
+    bool bManifoldTopology = false;
+
+    bool operator==(const FPlanetMeshingSettings& Other) const
+    {
+        return Algorithm == Other.Algorithm
+            && VertexPlacement == Other.VertexPlacement
+            && QefMassPointWeight == Other.QefMassPointWeight
+            && bManifoldTopology == Other.bManifoldTopology;
+    }
+
+    /** Convert to the engine-independent Surface Nets settings */
+    SurfaceNetsCore::FSurfaceNetsSettings ToCore() const
+    {
+        SurfaceNetsCore::FSurfaceNetsSettings Settings;
+        Settings.VertexPlacement = VertexPlacement == EPlanetVertexPlacement::SharpFeatures
+            ? SurfaceNetsCore::EVertexPlacement::Qef
+            : SurfaceNetsCore::EVertexPlacement::Centroid;
+        Settings.QefMassPointWeight = QefMassPointWeight;
+        Settings.bManifold = bManifoldTopology;
+        return Settings;
+    }
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "NoiseGenerator.h"
+#include "SurfaceNetsCore/FractalNoise.h"
+#include "PlanetPreset.generated.h"
+
+class UPlanetPreset;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPlanetPresetChanged, UPlanetPreset*);
+
+/**
+ * Planet generator settings shared by any number of APlanetActors, with the data derived from them computed when
+ * the asset is edited and saved along with it: the octave series and per-octave height bounds. Loading the asset restores them without recomputing; actors bound their chunks
+ * from the saved octave data instead of deriving it again, and regenerate when the asset is edited.
+ */
+UCLASS(BlueprintType)
+class SURFACENETSUE_API UPlanetPreset : public UPrimaryDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Planet", meta = (ClampMin = "1.0"))
+    float PlanetRadius = 1000.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Noise")
+    float NoiseScale = 0.001f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Noise")
+    float NoiseAmplitude = 50.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Noise", meta = (ClampMin = "0"))
+    int32 Octaves = 3;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Noise")
+    float Lacunarity = 2.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Noise")
+    float Persistence = 0.5f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Noise")
+    int32 Seed = 1337;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Noise")
+    bool bDecorrelateOctaves = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Noise")
+    EPlanetNoiseType NoiseType = EPlanetNoiseType::Fbm;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Noise|Warp", meta = (ClampMin = "0.0"))
+    float WarpStrength = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Noise|Warp", meta = (ClampMin = "0.0"))
+    float WarpScale = 0.0002f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Noise")
+    EPlanetSamplingMode SamplingMode = EPlanetSamplingMode::Volumetric;
+
+    /** Copy the settings to a generator; the planet center stays the actor's */
+    void ApplyTo(UNoiseGenerator* NoiseGenerator) const;
+
+    /** Noise settings of a planet built from this preset at PlanetCenter */
+    SurfaceNetsCore::FNoiseSettings MakeNoiseSettings(const FVector& PlanetCenter) const;
+
+    /** Octave series and height bounds of the settings above */
+    const SurfaceNetsCore::FNoiseBounds& GetNoiseBounds() const { return NoiseBounds; }
+
+    /** Recompute the derived data from the settings above */
+    void RebuildAcceleration();
+
+    /** Fired on the game thread after a preset's settings changed, for the actors using it to regenerate */
+    static FOnPlanetPresetChanged OnPresetChanged;
+
+    //~ Begin UObject Interface
+    virtual void PostLoad() override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+    //~ End UObject Interface
+
+private:
+    /** Hash of the settings the derived data was built from; a mismatch on load rebuilds it */
+    uint32 ComputeSettingsKey() const;
+
+    /** Restore NoiseBounds from the saved properties */
+    void RestoreAcceleration();
+
+    UPROPERTY(VisibleAnywhere, Category = "Acceleration")
+    uint32 AccelerationKey = 0;
+
+    UPROPERTY(VisibleAnywhere, Category = "Acceleration")
+    TArray<float> OctaveFrequencies;
+
+    UPROPERTY(VisibleAnywhere, Category = "Acceleration")
+    TArray<float> OctaveAmplitudes;
+
+    UPROPERTY(VisibleAnywhere, Category = "Acceleration")
+    TArray<float> OctaveTailHeights;
+
+    UPROPERTY(VisibleAnywhere, Category = "Acceleration")
+    float MaxHeight = 0.0f;
+
+    UPROPERTY(VisibleAnywhere, Category = "Acceleration")
+    float LipschitzBound = 1.0f;
+
+    /** Transient copy the queries run on */
+    SurfaceNetsCore::FNoiseBounds NoiseBounds;
+};
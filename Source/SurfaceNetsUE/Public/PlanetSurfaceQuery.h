@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DensityCache.h"
+#include "SurfaceNetsCore/FractalNoise.h"
+#include "SurfaceNetsCore/SdfQueries.h"
+
+/**
+ * Gameplay queries straight against a planet's density function: rays, closest surface points and terrain
+ * heights without meshes or collision, so they also work for chunks that are not generated yet.
+ * The query holds a copy of the noise settings and can be handed to worker threads. With a density cache it
+ * reads the cached grids where chunks have them, matching the meshed surface, and the noise elsewhere.
+ */
+struct SURFACENETSUE_API FPlanetSurfaceQuery
+{
+public:
+    FPlanetSurfaceQuery() = default;
+    explicit FPlanetSurfaceQuery(const SurfaceNetsCore::FNoiseSettings& InNoiseSettings, TSharedPtr<FDensityCache> InDensityCache = nullptr);
+
+    /** First surface hit on the segment from Start to End; a Start inside the terrain hits at Start */
+    bool Raycast(const FVector& Start, const FVector& End, FVector& OutHitLocation, FVector& OutHitNormal) const;
+
+    /** Nearest surface point, falling back to the surface straight above or below Point in rugged terrain */
+    bool FindClosestSurfacePoint(const FVector& Point, FVector& OutSurfacePoint) const;
+
+    /** Terrain height above the base radius along the line from the planet center through Location (topmost for overhangs) */
+    bool GetSurfaceHeight(const FVector& Location, float& OutHeight) const;
+
+    /** GetSurfaceHeight for many locations across worker threads; failed entries are 0. True when all succeeded */
+    bool GetSurfaceHeights(TArrayView<const FVector> Locations, TArrayView<float> OutHeights) const;
+
+    /** Outward surface normal at a point on or near the surface */
+    FVector CalculateNormal(const FVector& Point) const;
+
+private:
+    /** Density callable for one query; remembers the chunk it last looked up, so the cache is hit once per chunk crossed */
+    struct FDensitySampler
+    {
+        const FPlanetSurfaceQuery& Query;
+        TSharedPtr<const FCachedDensity> Chunk;
+        FBox ChunkBounds = FBox(ForceInit);
+
+        float operator()(const SurfaceNetsCore::FVec3& Position);
+    };
+
+    SurfaceNetsCore::FNoiseSettings NoiseSettings;
+    SurfaceNetsCore::FNoiseSampler Noise;
+    TSharedPtr<FDensityCache> DensityCache;
+    SurfaceNetsCore::FSdfQuerySettings QuerySettings;
+
+    /** Terrain stays within PlanetRadius +- MaxHeight, the shell height queries search */
+    float MaxHeight = 0.0f;
+};
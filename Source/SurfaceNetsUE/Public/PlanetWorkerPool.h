@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "PlanetWorkerPool.generated.h"
+
+class FEvent;
+class FRunnableThread;
+
+/** Generation workers sharing a set of cores, typically one group per socket (NUMA node) */
+USTRUCT(BlueprintType)
+struct SURFACENETSUE_API FPlanetWorkerGroup
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Workers", meta = (ClampMin = "1"))
+    int32 NumWorkers = 1;
+
+    /** Logical cores the workers may run on, one bit per core; 0 leaves them to the scheduler */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Workers")
+    int64 AffinityMask = 0;
+
+    bool operator==(const FPlanetWorkerGroup& Other) const
+    {
+        return NumWorkers == Other.NumWorkers && AffinityMask == Other.AffinityMask;
+    }
+};
+
+/**
+ * Dedicated chunk generation threads. Each group's workers are pinned to its cores and allocate chunk payloads from
+ * slab caches bound to the group's node, so the density, scratch and output of a chunk stay in memory local to the
+ * socket that built it. Without groups generation runs on the engine task graph.
+ */
+USTRUCT(BlueprintType)
+struct SURFACENETSUE_API FPlanetWorkerSettings
+{
+    GENERATED_BODY()
+
+    /** One entry per node; the index is the memory node the group's slab caches belong to */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Workers")
+    TArray<FPlanetWorkerGroup> Groups;
+
+    bool operator==(const FPlanetWorkerSettings& Other) const
+    {
+        return Groups == Other.Groups;
+    }
+
+    /**
+     * Groups from a command line, for bakes: -WorkerGroups=16:0xFFFF,16:0xFFFF0000 gives two pinned groups of 16,
+     * -Workers=N one unpinned group. Neither leaves Groups empty.
+     */
+    static FPlanetWorkerSettings FromCommandLine(const TCHAR* Cmd);
+};
+
+/**
+ * Fixed set of worker threads running queued tasks in order of submission. Thread-safe; destroying the pool
+ * waits for the tasks already running and drops the ones still queued.
+ */
+class SURFACENETSUE_API FPlanetWorkerPool
+{
+public:
+    explicit FPlanetWorkerPool(const FPlanetWorkerSettings& InSettings);
+    ~FPlanetWorkerPool();
+
+    UE_NONCOPYABLE(FPlanetWorkerPool);
+
+    /** Queue a task for the next idle worker */
+    void Launch(TUniqueFunction<void()>&& Task);
+
+    int32 GetNumWorkers() const { return Workers.Num(); }
+
+    const FPlanetWorkerSettings& GetSettings() const { return Settings; }
+
+private:
+    class FWorker;
+
+    /** Next task for a worker, or false once the pool is shutting down; blocks while the queue is empty */
+    bool WaitForTask(FWorker& Worker, TUniqueFunction<void()>& OutTask);
+
+    FPlanetWorkerSettings Settings;
+    TArray<TUniquePtr<FWorker>> Workers;
+
+    FCriticalSection QueueLock;
+    TArray<TUniqueFunction<void()>> Tasks;
+    int32 FirstTask = 0;
+    TArray<FWorker*> IdleWorkers;
+    bool bStopping = false;
+};
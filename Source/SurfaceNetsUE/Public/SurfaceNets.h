@@ -1,104 +1,81 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Mesher.h"
+#include "SurfaceNetsCoreBridge.h"
+#include "SurfaceNetsCore/MeshValidation.h"
+#include "SurfaceNetsCore/SurfaceNetsMesher.h"
 
 /**
  * Surface Nets mesh generation algorithm implementation
- * Based on the Rust fast-surface-nets-rs library with chunk-friendly approach
+ * Based on the Rust fast-surface-nets-rs library with chunk-friendly approach.
+ * Thin Unreal adapter over SurfaceNetsCore::FSurfaceNetsMesher.
  */
-struct SURFACENETSUE_API FSurfaceNets
+class SURFACENETSUE_API FSurfaceNets : public IMesher
 {
 public:
     /** Generate mesh from density field using Surface Nets algorithm with bounds (like Rust version) */
-    void GenerateMesh(
-        const TArray<float>& DensityField,
+    virtual void GenerateMesh(
+        TConstArrayView<float> DensityField,
         int32 GridSize,
         float VoxelSize,
         const FVector& Origin,
-        TArray<FVector>& OutVertices,
-        TArray<int32>& OutTriangles,
-        TArray<FVector>& OutNormals,
+        TChunkArray<FVector>& OutVertices,
+        TChunkArray<int32>& OutTriangles,
+        TChunkArray<FVector>& OutNormals,
         const FIntVector& MinBounds = FIntVector(0, 0, 0),
-        const FIntVector& MaxBounds = FIntVector(0, 0, 0)
-    );
-
-    /** Check if chunk contains surface (optimization like Rust early exit) */
-    static bool HasSurfaceInChunk(const TArray<float>& DensityField);
+        const FIntVector& MaxBounds = FIntVector(0, 0, 0),
+        FPlanetChunkRenderData* OutRenderData = nullptr
+    ) override;
 
-private:
-    /** Phase 1: Estimate surface (equivalent to estimate_surface in Rust) */
-    void EstimateSurface(
-        const TArray<float>& DensityField,
-        int32 GridSize,
-        const FIntVector& MinBounds,
-        const FIntVector& MaxBounds,
-        TArray<int32>& VertexGrid,
-        TArray<FVector>& OutVertices,
-        TArray<FVector>& OutNormals,
-        float VoxelSize,
-        const FVector& Origin
-    );
-    
-    /** Phase 2: Create all quads from surface vertices (equivalent to make_all_quads in Rust) */
-    void MakeAllQuads(
-        const TArray<float>& DensityField,
-        int32 GridSize,
-        const FIntVector& MinBounds,
-        const FIntVector& MaxBounds,
-        const TArray<int32>& VertexGrid,
-        TArray<int32>& OutTriangles
-    );
-    
-    /** Create a quad if there's a surface crossing between two adjacent cubes */
-    void MaybeCreateQuad(
-        const TArray<float>& DensityField,
+    /**
+     * Mesh into any SurfaceNetsCore sink. TMeshBuffers<EMeshLayout::StructOfArrays> gives one array per vertex
+     * component for SIMD post-processing; GenerateMesh is this with the Unreal arrays as the sink.
+     */
+    template <typename SinkType>
+    void GenerateMeshToSink(
+        TConstArrayView<float> DensityField,
         int32 GridSize,
-        const TArray<int32>& VertexGrid,
-        const FIntVector& P1,
-        const FIntVector& P2,
-        const FIntVector& AxisB,
-        const FIntVector& AxisC,
-        TArray<int32>& OutTriangles,
-        const TArray<FVector>& Vertices
-    );
-    
-    /** Calculate vertex position using Surface Nets smoothing (equivalent to estimate_surface in Rust) */
-    FVector CalculateVertexPosition(
-        const TArray<float>& DensityField,
-        int32 GridSize,
-        int32 x, int32 y, int32 z,
         float VoxelSize,
-        const FVector& Origin
-    );
-    
-    /** Calculate centroid of edge intersections for vertex positioning */
-    FVector CalculateCentroidOfEdgeIntersections(const float CornerDists[8]);
-    
-    /** Estimate surface edge intersection point */
-    FVector EstimateSurfaceEdgeIntersection(int32 Corner1, int32 Corner2, float Value1, float Value2);
-    
-    /** Calculate gradient at a point for normal calculation */
-    FVector CalculateGradient(
-        const TArray<float>& DensityField,
-        int32 GridSize,
-        int32 x, int32 y, int32 z
+        const FVector& Origin,
+        SinkType& Sink,
+        const FIntVector& MinBounds = FIntVector(0, 0, 0),
+        const FIntVector& MaxBounds = FIntVector(0, 0, 0))
+    {
+        // Use provided bounds or default to full grid
+        FIntVector ActualMinBounds;
+        FIntVector ActualMaxBounds;
+        ResolveBounds(GridSize, MinBounds, MaxBounds, ActualMinBounds, ActualMaxBounds);
+
+        SurfaceNetsCore::FDensityGridView Grid;
+        Grid.Data = DensityField.GetData();
+        Grid.GridSize = GridSize;
+        Grid.VoxelSize = VoxelSize;
+        Grid.Origin = SurfaceNetsBridge::ToCore(Origin);
+
+        SurfaceNetsCore::FSurfaceNetsMesher::GenerateMesh(
+            Grid,
+            SurfaceNetsBridge::ToCore(ActualMinBounds),
+            SurfaceNetsBridge::ToCore(ActualMaxBounds),
+            Settings,
+            Scratch,
+            Sink);
+    }
+
+    /** Vertex placement and other algorithm options used by GenerateMesh */
+    SurfaceNetsCore::FSurfaceNetsSettings Settings;
+
+    /** Check if chunk contains surface (optimization like Rust early exit) */
+    static bool HasSurfaceInChunk(TConstArrayView<float> DensityField);
+
+    /** Check index range, finite vertex data, degenerate triangles and edge topology, logging what fails */
+    static SurfaceNetsCore::FMeshValidationReport ValidateMesh(
+        TConstArrayView<FVector> Vertices,
+        TConstArrayView<int32> Triangles,
+        TConstArrayView<FVector> Normals
     );
-    
-    /** Get density value at grid coordinates (with bounds checking) */
-    float GetDensity(const TArray<float>& DensityField, int32 GridSize, int32 x, int32 y, int32 z);
-    
-    /** Check if a cube contains the surface (density changes sign) */
-    bool ContainsSurface(const TArray<float>& DensityField, int32 GridSize, int32 x, int32 y, int32 z);
-    
-    /** Get vertex index from vertex grid */
-    int32 GetVertexIndex(const TArray<int32>& VertexGrid, int32 GridSize, int32 x, int32 y, int32 z);
-    
-    /** Cube corner offsets */
-    static const FIntVector CubeCorners[8];
-    
-    /** Cube corner vectors */
-    static const FVector CubeCornerVectors[8];
-    
-    /** Cube edges */
-    static const int32 CubeEdges[12][2];
-};
\ No newline at end of file
+
+private:
+    /** Vertex grid and other working memory, reused while this instance is kept alive */
+    SurfaceNetsCore::FSurfaceNetsScratch Scratch;
+};
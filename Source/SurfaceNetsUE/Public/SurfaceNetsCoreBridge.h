@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChunkAllocator.h"
+#include "SurfaceNetsCore/MathTypes.h"
+
+/**
+ * Conversions between Unreal math types and the engine-independent SurfaceNetsCore types
+ */
+namespace SurfaceNetsBridge
+{
+    FORCEINLINE SurfaceNetsCore::FVec3 ToCore(const FVector& Vector)
+    {
+        return SurfaceNetsCore::FVec3(Vector.X, Vector.Y, Vector.Z);
+    }
+
+    FORCEINLINE SurfaceNetsCore::FIntVec3 ToCore(const FIntVector& Vector)
+    {
+        return SurfaceNetsCore::FIntVec3(Vector.X, Vector.Y, Vector.Z);
+    }
+
+    FORCEINLINE FVector ToUnreal(const SurfaceNetsCore::FVec3& Vector)
+    {
+        return FVector(Vector.X, Vector.Y, Vector.Z);
+    }
+
+    FORCEINLINE FIntVector ToUnreal(const SurfaceNetsCore::FIntVec3& Vector)
+    {
+        return FIntVector(Vector.X, Vector.Y, Vector.Z);
+    }
+
+    /** Core mesher sink writing straight into the Unreal output arrays, sized once by Allocate */
+    struct FTArrayMeshSink
+    {
+        TChunkArray<FVector>& Vertices;
+        TChunkArray<int32>& Triangles;
+        TChunkArray<FVector>& Normals;
+
+        FVector* NextVertex = nullptr;
+        FVector* NextNormal = nullptr;
+        int32* NextIndex = nullptr;
+
+        void Allocate(int32 NumVertices, int32 NumTriangles)
+        {
+            Vertices.Reset(NumVertices);
+            Normals.Reset(NumVertices);
+            Triangles.Reset(NumTriangles * 3);
+            Vertices.SetNumUninitialized(NumVertices);
+            Normals.SetNumUninitialized(NumVertices);
+            Triangles.SetNumUninitialized(NumTriangles * 3);
+
+            NextVertex = Vertices.GetData();
+            NextNormal = Normals.GetData();
+            NextIndex = Triangles.GetData();
+        }
+
+        FORCEINLINE void AddVertex(const SurfaceNetsCore::FVec3& Position, const SurfaceNetsCore::FVec3& Normal)
+        {
+            checkSlow(NextVertex < Vertices.GetData() + Vertices.Num());
+            *NextVertex++ = ToUnreal(Position);
+            *NextNormal++ = ToUnreal(Normal);
+        }
+
+        FORCEINLINE void AddTriangle(int32 A, int32 B, int32 C)
+        {
+            checkSlow(NextIndex + 3 <= Triangles.GetData() + Triangles.Num());
+            NextIndex[0] = A;
+            NextIndex[1] = B;
+            NextIndex[2] = C;
+            NextIndex += 3;
+        }
+
+        /** Whether every slot Allocate sized has been written, as the mesher's exact counts promise */
+        bool IsComplete() const
+        {
+            return NextVertex == Vertices.GetData() + Vertices.Num()
+                && NextNormal == Normals.GetData() + Normals.Num()
+                && NextIndex == Triangles.GetData() + Triangles.Num();
+        }
+    };
+}
@@ -5,6 +5,8 @@
 
 DECLARE_LOG_CATEGORY_EXTERN(LogSurfaceNets, Log, All);
 
+DECLARE_STATS_GROUP(TEXT("SurfaceNets"), STATGROUP_SurfaceNets, STATCAT_Advanced);
+
 class FSurfaceNetsUEModule : public IModuleInterface
 {
 public:
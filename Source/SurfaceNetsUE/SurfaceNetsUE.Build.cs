@@ -10,9 +10,10 @@ public class SurfaceNetsUE : ModuleRules
 			"Core", 
 			"CoreUObject", 
 			"Engine", 
-			"ProceduralMeshComponent",
+			"PhysicsCore",
 			"RenderCore",
-			"RHI"
+			"RHI",
+			"SurfaceNetsCore"
 		});
 
 		PrivateDependencyModuleNames.AddRange(new string[] { 